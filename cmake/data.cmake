@@ -25,4 +25,28 @@ add_custom_target(
         DEPENDS ${DATA_BINARY_FILES} ${DATA_FILES})
 add_dependencies(${binary} ${copy_data_name})
 
-endfunction()
\ No newline at end of file
+endfunction()
+
+# Packs the png of the data/sprites folder in one atlas image and its region table with atlas_packer
+function(add_texture_atlas binary)
+file(GLOB sprite_files "${CMAKE_CURRENT_SOURCE_DIR}/data/sprites/*.png")
+if(NOT sprite_files)
+    return()
+endif()
+file(RELATIVE_PATH SPRITES_PATH "${PROJECT_SOURCE_DIR}" "${CMAKE_CURRENT_SOURCE_DIR}/data/sprites")
+set(ATLAS_IMAGE "${PROJECT_BINARY_DIR}/${SPRITES_PATH}/atlas.png")
+set(ATLAS_TABLE "${PROJECT_BINARY_DIR}/${SPRITES_PATH}/atlas.txt")
+set(pack_atlas_name "${binary}_Pack_Atlas")
+add_custom_command(
+        OUTPUT ${ATLAS_IMAGE} ${ATLAS_TABLE}
+        DEPENDS atlas_packer ${sprite_files}
+        COMMAND ${CMAKE_COMMAND} -E make_directory "${PROJECT_BINARY_DIR}/${SPRITES_PATH}"
+        COMMAND atlas_packer ${ATLAS_IMAGE} ${ATLAS_TABLE} ${sprite_files}
+)
+
+add_custom_target(
+        ${pack_atlas_name}
+        DEPENDS ${ATLAS_IMAGE} ${ATLAS_TABLE})
+add_dependencies(${binary} ${pack_atlas_name})
+
+endfunction()
@@ -71,6 +71,16 @@ public:
      * \param value is the new value that will be set.
      */
     void SetComponent(Entity entity, const T& value);
+    /**
+     * \brief GetComponentUnchecked is a method like GetComponent, checked only with paranoid assertions.
+     * It is used in the system loops that already checked that the Entity has the Component.
+     */
+    [[nodiscard]] const T& GetComponentUnchecked(Entity entity) const;
+    [[nodiscard]] T& GetComponentUnchecked(Entity entity);
+    /**
+     * \brief SetComponentUnchecked is a method like SetComponent, checked only with paranoid assertions.
+     */
+    void SetComponentUnchecked(Entity entity, const T& value);
     /**
      * \brief GetAllComponents is a method that returns the internal array of components
      * \return the internal array of components
@@ -121,7 +131,7 @@ template <typename T, Component C>
 const T& ComponentManager<T, C>::GetComponent(Entity entity) const
 {
     gpr_assert(entity != INVALID_ENTITY, "Invalid Entity");
-    gpr_warn(entityManager_.HasComponent(entity, C), "Entity has not the requested component");
+    gpr_warn_debug(entityManager_.HasComponent(entity, C), "Entity has not the requested component");
     return components_[entity];
 }
 
@@ -129,7 +139,7 @@ template <typename T, Component C>
 T& ComponentManager<T, C>::GetComponent(Entity entity)
 {
     gpr_assert(entity != INVALID_ENTITY, "Invalid Entity");
-    gpr_warn(entityManager_.HasComponent(entity, C), "Entity has not the requested component");
+    gpr_warn_debug(entityManager_.HasComponent(entity, C), "Entity has not the requested component");
     return components_[entity];
 }
 
@@ -137,7 +147,31 @@ template <typename T, Component C>
 void ComponentManager<T, C>::SetComponent(Entity entity, const T& value)
 {
     gpr_assert(entity != INVALID_ENTITY, "Invalid Entity");
-    gpr_warn(entityManager_.HasComponent(entity, C), "Entity has not the requested component");
+    gpr_warn_debug(entityManager_.HasComponent(entity, C), "Entity has not the requested component");
+    components_[entity] = value;
+}
+
+template <typename T, Component C>
+const T& ComponentManager<T, C>::GetComponentUnchecked(Entity entity) const
+{
+    gpr_assert_paranoid(entity < components_.size(), "Entity out of the components");
+    gpr_warn_paranoid(entityManager_.HasComponentUnchecked(entity, C), "Entity has not the requested component");
+    return components_[entity];
+}
+
+template <typename T, Component C>
+T& ComponentManager<T, C>::GetComponentUnchecked(Entity entity)
+{
+    gpr_assert_paranoid(entity < components_.size(), "Entity out of the components");
+    gpr_warn_paranoid(entityManager_.HasComponentUnchecked(entity, C), "Entity has not the requested component");
+    return components_[entity];
+}
+
+template <typename T, Component C>
+void ComponentManager<T, C>::SetComponentUnchecked(Entity entity, const T& value)
+{
+    gpr_assert_paranoid(entity < components_.size(), "Entity out of the components");
+    gpr_warn_paranoid(entityManager_.HasComponentUnchecked(entity, C), "Entity has not the requested component");
     components_[entity] = value;
 }
 
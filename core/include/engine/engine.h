@@ -1,40 +1,140 @@
 #pragma once
 
+#include <atomic>
+#include <cstdint>
 #include <memory>
+#include <mutex>
 
+#include <SFML/Graphics/RenderTexture.hpp>
 #include <SFML/Graphics/RenderWindow.hpp>
 
 #include "engine/app.h"
+#include "graphics/render_snapshot.h"
+#include "utils/mpsc_queue.h"
+#include "utils/triple_buffer.h"
 
 namespace core
 {
+/**
+ * \brief EngineClock is the delta time given to the systems by the headless Engine.
+ */
+enum class EngineClock : std::uint8_t
+{
+    /**
+     * \brief REAL_TIME gives the measured time since the previous update
+     */
+    REAL_TIME = 0u,
+    /**
+     * \brief FIXED gives the fixed delta time and waits to keep the pace of the real time
+     */
+    FIXED,
+    /**
+     * \brief UNTHROTTLED gives the fixed delta time and updates as fast as the CPU allows
+     */
+    UNTHROTTLED
+};
 
 /**
  * \brief Engine is a class that manages the layer between the system and the application and runs the game loop.
+ * By default the events, systems, drawing and display run one after the other on the main thread.
+ * In render thread mode, the events and systems run on a simulation thread that records the RecordDrawInterface in a RenderSnapshot,
+ * and the main thread draws the latest snapshot, so a vsync wait does not delay the inputs and a long update does not drop frames.
+ * The ImGui windows read the game state, the main thread builds them only between two simulation steps and otherwise draws the last ones.
+ * In headless mode, there is no window, graphics or ImGui: the systems begin, update with the EngineClock until Stop and end.
  */
 class Engine
 {
 public:
+    /**
+     * \brief simulationThreadPeriodUs is the minimum period of the simulation thread loop, instead of spinning between two frames
+     */
+    static constexpr std::int32_t simulationThreadPeriodUs = 2'000;
     /**
      * \brief Run is a method that runs the Engine game loop.
      */
     void Run();
+    /**
+     * \brief SetRenderThreadEnabled is a method that selects the render thread mode, it needs to be called before Run.
+     * In this mode the DrawInterface are not called, the DrawImGuiInterface are called by the main thread when the simulation thread is not updating.
+     */
+    void SetRenderThreadEnabled(bool isEnabled) { isRenderThreadEnabled_ = isEnabled; }
+    /**
+     * \brief SetHeadless is a method that selects the headless mode, it needs to be called before Run.
+     * The draw, event and ImGui interfaces are registered but never called.
+     */
+    void SetHeadless(bool isHeadless) { isHeadless_ = isHeadless; }
+    /**
+     * \brief SetClock is a method that sets the delta time of the headless updates.
+     * \param fixedDeltaTime is the delta time of the FIXED and UNTHROTTLED clocks
+     */
+    void SetClock(EngineClock clock, sf::Time fixedDeltaTime = sf::seconds(1.0f / 60.0f));
+    /**
+     * \brief SetMaxUpdateNmb is a method that stops the headless Engine after this number of updates, 0 runs until Stop.
+     */
+    void SetMaxUpdateNmb(std::size_t maxUpdateNmb) { maxUpdateNmb_ = maxUpdateNmb; }
+    /**
+     * \brief Stop is a method that ends the headless game loop after the current update, it can be called from any thread.
+     */
+    void Stop() { isRunning_.store(false, std::memory_order_release); }
+    [[nodiscard]] std::size_t GetUpdateNmb() const { return updateNmb_; }
 
     void RegisterApp(App* app);
     void RegisterSystem(SystemInterface*);
     void RegisterOnEvent(OnEventInterface*);
     void RegisterDraw(DrawInterface*);
     void RegisterDrawImGui(DrawImGuiInterface*);
+    void RegisterRecordDraw(RecordDrawInterface*);
 protected:
     void Init();
-    void Update(sf::Time dt) const;
+    void Update(sf::Time dt);
     void Destroy();
+    /**
+     * \brief PollEvents is a method that handles the window events and forwards them to the OnEventInterface,
+     * through the event queue in render thread mode.
+     */
+    void PollEvents();
+    /**
+     * \brief RunRenderThread is the game loop of the render thread mode, the main thread keeps the window and draws.
+     */
+    void RunRenderThread();
+    void RunSimulationThread();
+    void Render(sf::Time dt);
+    /**
+     * \brief RunHeadless is the game loop of the headless mode, the systems are updated on the calling thread.
+     */
+    void RunHeadless();
 
     std::vector<SystemInterface*> systems_;
     std::vector<OnEventInterface*> eventInterfaces_;
     std::vector<DrawInterface*> drawInterfaces_;
     std::vector<DrawImGuiInterface*> drawImGuiInterfaces_;
+    std::vector<RecordDrawInterface*> recordDrawInterfaces_;
     std::unique_ptr<sf::RenderWindow> window_;
+
+    bool isRenderThreadEnabled_ = false;
+    std::atomic<bool> isSimulationRunning_{ false };
+    /**
+     * \brief simulationMutex_ is held by the simulation thread during each step of an update and by the main thread during the ImGui windows,
+     * as they read and write the game state. The main thread only tries to lock it, it never waits for the simulation.
+     */
+    std::mutex simulationMutex_;
+    /**
+     * \brief imGuiLayer_ holds the last ImGui windows, drawn again over the snapshots while the simulation thread is busy
+     */
+    sf::RenderTexture imGuiLayer_;
+    /**
+     * \brief imGuiDeltaTime_ is the time since the last ImGui update, including the frames that reused imGuiLayer_
+     */
+    sf::Time imGuiDeltaTime_;
+    MpscQueue<sf::Event, 256> events_;
+    TripleBuffer<RenderSnapshot> renderSnapshots_;
+
+    bool isHeadless_ = false;
+    EngineClock clock_ = EngineClock::REAL_TIME;
+    sf::Time fixedDeltaTime_ = sf::seconds(1.0f / 60.0f);
+    std::size_t maxUpdateNmb_ = 0;
+    std::size_t updateNmb_ = 0;
+    std::atomic<bool> isRunning_{ false };
 };
 
 } // namespace core
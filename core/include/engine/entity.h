@@ -7,6 +7,8 @@
 #include <vector>
 #include <limits>
 
+#include "utils/assert.h"
+
 
 namespace core
 {
@@ -70,6 +72,17 @@ public:
      * \return the statement result if an Entity has a certain bitwise mask on.
      */
     [[nodiscard]] bool HasComponent(Entity entity, EntityMask mask) const;
+    /**
+     * \brief HasComponentUnchecked is a method that checks the EntityMask like HasComponent, without the Entity assertion.
+     * It is inlined in the system loops iterating over [0, GetEntitiesSize()), where the Entity is always valid.
+     * \param entity is the Entity that we check, lower than GetEntitiesSize()
+     * \param mask is the Component bitwise mask to check.
+     */
+    [[nodiscard]] bool HasComponentUnchecked(Entity entity, EntityMask mask) const
+    {
+        gpr_assert_paranoid(entity < entityMasks_.size(), "Entity out of the entity masks");
+        return (entityMasks_[entity] & mask) == mask;
+    }
     /**
      * \brief EntityExists is a method that check if a certain Entity has any Component and thus do exist.
      * \param entity is the Entity that we check
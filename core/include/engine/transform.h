@@ -5,6 +5,10 @@
 
 #include <engine/entity.h>
 
+#include <cstdint>
+#include <span>
+#include <vector>
+
 namespace core
 {
 /**
@@ -37,14 +41,41 @@ public:
     using ComponentManager::ComponentManager;
 };
 
+/**
+ * \brief TransformChange is a flag telling which part of a transform changed since TransformManager::ClearChanges.
+ */
+enum class TransformChange : std::uint8_t
+{
+    POSITION = 1u << 0u,
+    SCALE = 1u << 1u,
+    ROTATION = 1u << 2u,
+    /**
+     * \brief ADDED is set when the entity got its transform, its previous values belonged to another entity
+     */
+    ADDED = 1u << 3u
+};
+
 /**
  * \brief TransformManager is a class combining a PositionManager, a ScaleManager and a RotationManager in one.
+ * With change tracking, it records the entities whose transform was added or set to a different value,
+ * so a reader of the arrays only visits those.
  */
 class TransformManager
 {
 public:
     TransformManager(EntityManager& entityManager);
 
+    void SetChangeTracking(bool isTrackingChanges) { isTrackingChanges_ = isTrackingChanges; }
+    /**
+     * \brief GetChangedEntities is a method that returns the entities changed since ClearChanges, each of them once.
+     */
+    [[nodiscard]] std::span<const Entity> GetChangedEntities() const { return changedEntities_; }
+    /**
+     * \brief GetChanges is a method that returns the TransformChange flags of the entity since ClearChanges.
+     */
+    [[nodiscard]] std::uint8_t GetChanges(Entity entity) const { return entity < changes_.size() ? changes_[entity] : 0u; }
+    void ClearChanges();
+
     [[nodiscard]] Vec2f GetPosition(Entity entity) const;
     [[nodiscard]] const std::vector<Vec2f>& GetAllPositions() const;
     void SetPosition(Entity entity, Vec2f position);
@@ -61,9 +92,14 @@ public:
     void RemoveComponent(Entity entity);
     
 private:
+    void MarkChanged(Entity entity, TransformChange change);
+
     PositionManager positionManager_;
     ScaleManager scaleManager_;
     RotationManager rotationManager_;
+    bool isTrackingChanges_ = false;
+    std::vector<std::uint8_t> changes_;
+    std::vector<Entity> changedEntities_;
 };
 
 }
@@ -0,0 +1,80 @@
+/**
+ * \file cached_text.h
+ */
+#pragma once
+
+#include <cstddef>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <SFML/Graphics/Color.hpp>
+#include <SFML/Graphics/Font.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+
+namespace core
+{
+/**
+ * \brief CachedText is a text drawn from a prebuilt array of glyph triangles, like sf::Text.
+ * The glyphs are laid out again only when the string, font or character size change, setting the same string every frame is a comparison.
+ * A color or position change only rewrites the vertices. The characters are the bytes of the string, like a sf::String built from a std::string.
+ */
+class CachedText
+{
+public:
+    void SetFont(const sf::Font& font);
+    /**
+     * \brief SetString is a method that changes the string, the layout is rebuilt at the next draw if it is different.
+     */
+    void SetString(std::string_view string);
+    void SetCharacterSize(unsigned characterSize);
+    void SetColor(sf::Color color);
+    /**
+     * \brief SetPosition is a method that places the top left corner of the text bounds.
+     */
+    void SetPosition(sf::Vector2f position);
+    /**
+     * \brief SetCenter is a method that places the center of the text bounds, the text stays centered when its string changes.
+     */
+    void SetCenter(sf::Vector2f center);
+
+    /**
+     * \brief GetLocalBounds is a method that returns the bounds of the glyphs before positioning, laying them out if needed.
+     */
+    [[nodiscard]] const sf::FloatRect& GetLocalBounds();
+    /**
+     * \brief GetVertices is a method that returns the positioned glyph triangles, drawn with GetTexture.
+     */
+    [[nodiscard]] std::span<const sf::Vertex> GetVertices();
+    [[nodiscard]] const sf::Texture* GetTexture() const;
+    void Draw(sf::RenderTarget& renderTarget);
+    /**
+     * \brief GetLayoutNmb is a method that returns how many times the glyphs were laid out.
+     */
+    [[nodiscard]] std::size_t GetLayoutNmb() const { return layoutNmb_; }
+private:
+    void UpdateLayout();
+    void UpdateVertices();
+
+    const sf::Font* font_ = nullptr;
+    std::string string_;
+    unsigned characterSize_ = 30;
+    sf::Color color_ = sf::Color::White;
+    sf::Vector2f position_{};
+    bool isCentered_ = false;
+
+    /**
+     * \brief localVertices_ are the glyph triangles relative to the origin of the text, vertices_ are positioned and colored
+     */
+    std::vector<sf::Vertex> localVertices_;
+    std::vector<sf::Vertex> vertices_;
+    sf::FloatRect bounds_{};
+    bool isLayoutDirty_ = true;
+    bool areVerticesDirty_ = true;
+    std::size_t layoutNmb_ = 0;
+};
+}
@@ -4,6 +4,8 @@
 
 namespace core
 {
+class RenderSnapshot;
+
 /**
  * \brief DrawInterface is an interface used by the Engine to be called when the game loop is drawing elements on the screen.
  * It needs to be registered by the Engine.
@@ -25,4 +27,21 @@ public:
     virtual ~DrawImGuiInterface() = default;
     virtual void DrawImGui() = 0;
 };
+
+/**
+ * \brief RecordDrawInterface is an interface used by the Engine render thread mode to copy what would be drawn in a RenderSnapshot,
+ * called on the simulation thread instead of DrawInterface::Draw.
+ * It needs to be registered by the Engine.
+ */
+class RecordDrawInterface
+{
+public:
+    virtual ~RecordDrawInterface() = default;
+    virtual void RecordDraw(RenderSnapshot& snapshot) = 0;
+    /**
+     * \brief UploadResources is a method called by the render thread before drawing a snapshot,
+     * for the OpenGL work of the recorded objects like the texture uploads.
+     */
+    virtual void UploadResources() {}
+};
 }
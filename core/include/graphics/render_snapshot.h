@@ -0,0 +1,88 @@
+/**
+ * \file render_snapshot.h
+ */
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <SFML/Graphics/Color.hpp>
+#include <SFML/Graphics/Font.hpp>
+#include <SFML/Graphics/PrimitiveType.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <SFML/Graphics/View.hpp>
+
+#include "graphics/cached_text.h"
+
+namespace core
+{
+/**
+ * \brief RenderText is a text of a RenderSnapshot. Its geometry is computed when drawn, so only the render thread reads the font glyphs.
+ */
+struct RenderText
+{
+    const sf::Font* font = nullptr;
+    std::string string;
+    unsigned characterSize = 30;
+    sf::Color color = sf::Color::White;
+    /**
+     * \brief center is the position of the center of the text bounds in pixels
+     */
+    sf::Vector2f center{};
+};
+
+/**
+ * \brief RenderSnapshot is a copy of everything drawn in a frame, written by the simulation thread and drawn by the render thread.
+ * It only holds vertices, views and texts pointing to textures and fonts that live as long as the game.
+ * The vectors are cleared and keep their capacity, so a snapshot reused from a TripleBuffer only allocates the text strings.
+ */
+class RenderSnapshot
+{
+public:
+    void Clear();
+    void SetView(const sf::View& view);
+    /**
+     * \brief AddVertices is a method that copies vertices drawn with the texture.
+     * They are merged with the previous vertices when they share the texture and a primitive type that can be merged.
+     */
+    void AddVertices(std::span<const sf::Vertex> vertices, sf::PrimitiveType primitiveType, const sf::Texture* texture = nullptr);
+    void AddText(const sf::Font& font, std::string_view string, unsigned characterSize, sf::Color color, sf::Vector2f center);
+    /**
+     * \brief Draw is a method that submits the snapshot in recording order, it needs to be called by the thread owning the render target.
+     */
+    void Draw(sf::RenderTarget& renderTarget) const;
+    [[nodiscard]] std::size_t GetCommandNmb() const { return commands_.size(); }
+private:
+    /**
+     * \brief RenderCommand is one call to the render target, index and count point in the vertices, texts or views of the snapshot.
+     */
+    struct RenderCommand
+    {
+        enum class Type : std::uint8_t
+        {
+            VERTICES,
+            TEXT,
+            VIEW
+        };
+        Type type = Type::VERTICES;
+        sf::PrimitiveType primitiveType = sf::Triangles;
+        const sf::Texture* texture = nullptr;
+        std::size_t index = 0;
+        std::size_t count = 0;
+    };
+    std::vector<RenderCommand> commands_;
+    std::vector<sf::Vertex> vertices_;
+    std::vector<RenderText> texts_;
+    std::vector<sf::View> views_;
+    /**
+     * \brief cachedTexts_ draw the texts and keep their layout while the text at the same index does not change,
+     * mutable as it is a drawing cache and not part of the snapshot
+     */
+    mutable std::vector<CachedText> cachedTexts_;
+};
+}
@@ -1,22 +1,69 @@
 #pragma once
 
 #include "engine/component.h"
-#include <SFML/Graphics/Sprite.hpp>
+#include <SFML/Graphics/Color.hpp>
+#include <SFML/Graphics/Rect.hpp>
 #include <SFML/Graphics/RenderWindow.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <vector>
 
 #include "graphics.h"
+#include "graphics/render_snapshot.h"
 
 namespace core
 {
 class TransformManager;
 
+using TextureId = std::uint16_t;
+constexpr TextureId INVALID_TEXTURE_ID = std::numeric_limits<TextureId>::max();
+
+/**
+ * \brief Sprite is the component drawn by the SpriteManager. The texture is an index in the textures registered by the SpriteManager,
+ * the vertices are generated at draw time from the TransformManager.
+ */
+struct Sprite
+{
+    sf::Vector2f origin{};
+    /**
+     * \brief rectLeft, rectTop, rectWidth and rectHeight are the region of the texture in pixels, a negative size flips the image
+     */
+    std::int16_t rectLeft = 0;
+    std::int16_t rectTop = 0;
+    std::int16_t rectWidth = 0;
+    std::int16_t rectHeight = 0;
+    sf::Color color = sf::Color(255, 255, 255, 255);
+    TextureId textureId = INVALID_TEXTURE_ID;
+    /**
+     * \brief layer orders the sprites, greater layers are drawn over lower ones, the same layer is ordered by entity index
+     */
+    std::uint8_t layer = 0;
+};
+static_assert(std::is_trivially_copyable_v<Sprite>);
+
+/**
+ * \brief SpriteBatch is a range of consecutive sprite vertices sharing the same texture, submitted in one draw call.
+ */
+struct SpriteBatch
+{
+    const sf::Texture* texture = nullptr;
+    std::size_t vertexBegin = 0;
+    std::size_t vertexCount = 0;
+};
+
 /**
  * \brief SpriteManager is a ComponentManager that manages sprites, order by greater entity index, background entity < foreground entity
  * Positions are centered at the center of the render target and use pixelPerMeter from globals.h
+ * The sprites are drawn as triangles in batches of consecutive entities with the same texture, one draw call per batch.
  */
 class SpriteManager :
-    public ComponentManager<sf::Sprite, static_cast<Component>(ComponentType::SPRITE)>,
-    public DrawInterface
+    public ComponentManager<Sprite, static_cast<Component>(ComponentType::SPRITE)>,
+    public DrawInterface,
+    public RecordDrawInterface
 {
 public:
     SpriteManager(EntityManager& entityManager, TransformManager& transformManager) :
@@ -25,17 +72,58 @@ public:
     {
 
     }
+    /**
+     * \brief AddComponent is a method that resets the Sprite of the entity, that can hold the one of a destroyed entity.
+     */
+    void AddComponent(Entity entity) override;
     void SetOrigin(Entity entity, sf::Vector2f origin);
+    /**
+     * \brief SetTexture is a method that sets the whole texture as the image of the sprite.
+     */
     void SetTexture(Entity entity, const sf::Texture& texture);
+    /**
+     * \brief SetTexture is a method that sets a region of a texture atlas as the image of the sprite.
+     */
+    void SetTexture(Entity entity, const sf::Texture& texture, const sf::IntRect& textureRect);
     void SetCenter(sf::Vector2f center) { center_ = center; }
     void SetWindowSize(sf::Vector2f newWindowSize) { windowSize_ = newWindowSize; }
     void Draw(sf::RenderTarget& window) override;
+    /**
+     * \brief RecordDraw is a method that copies the batches of Draw in the snapshot, for the Engine render thread mode.
+     */
+    void RecordDraw(RenderSnapshot& snapshot) override;
     void SetColor(Entity entity, sf::Color color);
+    void SetLayer(Entity entity, std::uint8_t layer);
+    /**
+     * \brief GetBatchNmb is a method that returns the number of draw calls of the last Draw or RecordDraw.
+     */
+    [[nodiscard]] std::size_t GetBatchNmb() const { return batches_.size(); }
 
 protected:
+    /**
+     * \brief BuildBatches is a method that rebuilds the vertices and batches of all the sprites from the TransformManager.
+     */
+    void BuildBatches();
+    /**
+     * \brief RegisterTexture is a method that returns the TextureId of a texture, adding it to the textures on first use.
+     */
+    TextureId RegisterTexture(const sf::Texture& texture);
+    /**
+     * \brief AppendSprite is a method that appends the two triangles of the sprite of entity to the vertices and batches.
+     */
+    void AppendSprite(Entity entity, sf::Vector2f position, sf::Vector2f scale, float rotation);
+
     TransformManager& transformManager_;
     sf::Vector2f center_{};
     sf::Vector2f windowSize_{};
+    std::vector<const sf::Texture*> textures_;
+    /**
+     * \brief drawOrder_, vertices_ and batches_ are rebuilt every Draw and keep their capacity between frames
+     */
+    std::vector<Entity> drawOrder_;
+    std::vector<sf::Vertex> vertices_;
+    std::vector<SpriteBatch> batches_;
+    bool hasLayers_ = false;
 
 };
 
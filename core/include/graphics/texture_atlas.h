@@ -0,0 +1,79 @@
+/**
+ * \file texture_atlas.h
+ */
+#pragma once
+
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/System/Vector2.hpp>
+
+namespace core
+{
+/**
+ * \brief AtlasRegion is a named sub-rectangle of a texture atlas, in pixels. The name is the file name of the packed image without extension.
+ */
+struct AtlasRegion
+{
+    std::string name;
+    sf::IntRect rect;
+};
+
+/**
+ * \brief PackAtlasRects is a function that places rectangles of the given sizes in rows sorted by decreasing height (shelf packing).
+ * The atlas width is the smallest power of two fitting the widest image and the square root of the total area.
+ * \param sizes are the sizes of the images in pixels
+ * \param padding is the empty space between two rectangles, avoiding to sample the neighbour image when filtering
+ * \param atlasSize is set to the size of the atlas
+ * \return the rectangles in the order of sizes
+ */
+[[nodiscard]] std::vector<sf::IntRect> PackAtlasRects(std::span<const sf::Vector2u> sizes, unsigned padding, sf::Vector2u& atlasSize);
+
+/**
+ * \brief TextureAtlas is a class that holds one texture made of several images and the region of each of them,
+ * so that the sprites using it are drawn in one batch.
+ * The atlas of data/sprites is packed at build time by the atlas_packer tool (see add_texture_atlas in cmake/data.cmake).
+ */
+class TextureAtlas
+{
+public:
+    static constexpr unsigned atlasPadding = 2;
+
+    /**
+     * \brief LoadFromFile is a method that loads an atlas image and the region table written by atlas_packer.
+     */
+    bool LoadFromFile(std::string_view imagePath, std::string_view tablePath);
+    /**
+     * \brief PackFromFiles is a method that packs the images at runtime, when the atlas was not built.
+     */
+    bool PackFromFiles(std::span<const std::string> imagePaths);
+    /**
+     * \brief LoadFromImage is a method that uploads an atlas image decoded beforehand, it needs to be called by a thread with an OpenGL context.
+     */
+    bool LoadFromImage(const sf::Image& atlasImage, std::vector<AtlasRegion> regions);
+    [[nodiscard]] const sf::Texture& GetTexture() const { return texture_; }
+    [[nodiscard]] const std::vector<AtlasRegion>& GetRegions() const { return regions_; }
+    /**
+     * \brief GetRect is a method that returns the region of an image in the atlas texture, or an empty rectangle if the image is not packed.
+     */
+    [[nodiscard]] sf::IntRect GetRect(std::string_view name) const;
+
+    /**
+     * \brief PackImages is a function that loads the images and copies them in one atlas image.
+     */
+    static bool PackImages(std::span<const std::string> imagePaths, sf::Image& atlasImage, std::vector<AtlasRegion>& regions);
+    /**
+     * \brief WriteTable is a function that writes the regions as text, one "name left top width height" line per region.
+     */
+    static bool WriteTable(std::string_view path, std::span<const AtlasRegion> regions);
+    static bool ReadTable(std::string_view path, std::vector<AtlasRegion>& regions);
+private:
+    sf::Texture texture_;
+    std::vector<AtlasRegion> regions_;
+};
+}
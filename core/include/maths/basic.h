@@ -54,8 +54,9 @@ constexpr float Clamp(T value, T lower, T upper)
 template<typename T>
 typename std::enable_if<std::is_integral<T>::value, T>::type RandomRange(T start, T end)
 {
-    static std::random_device rd;  //Will be used to obtain a seed for the random number engine
-    static std::mt19937 gen(rd()); //Standard mersenne_twister_engine seeded with rd()
+    //One engine per thread, RandomRange can be called by simulations running in parallel
+    thread_local std::random_device rd;  //Will be used to obtain a seed for the random number engine
+    thread_local std::mt19937 gen(rd()); //Standard mersenne_twister_engine seeded with rd()
     std::uniform_int_distribution<T> dis(start, end);
     return dis(gen);
 }
@@ -63,8 +64,8 @@ typename std::enable_if<std::is_integral<T>::value, T>::type RandomRange(T start
 template<typename T>
 typename std::enable_if<std::is_floating_point<T>::value, T>::type RandomRange(T start, T end)
 {
-    static std::random_device rd;  //Will be used to obtain a seed for the random number engine
-    static std::mt19937 gen(rd()); //Standard mersenne_twister_engine seeded with rd()
+    thread_local std::random_device rd;  //Will be used to obtain a seed for the random number engine
+    thread_local std::mt19937 gen(rd()); //Standard mersenne_twister_engine seeded with rd()
     std::uniform_real_distribution<T> dis(start, end);
     return dis(gen);
 }
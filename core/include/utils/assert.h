@@ -7,6 +7,18 @@
 #include "utils/log.h"
 #include <fmt/format.h>
 
+/**
+ * \brief GPR_ASSERT_LEVEL selects the assertions compiled in when GPR_ASSERT is on, set with the Gpr_Assert_Level CMake option.
+ * gpr_assert and gpr_warn are always checked, gpr_assert_debug and gpr_warn_debug from GPR_ASSERT_LEVEL_DEBUG,
+ * gpr_assert_paranoid and gpr_warn_paranoid from GPR_ASSERT_LEVEL_PARANOID.
+ */
+#define GPR_ASSERT_LEVEL_ALWAYS 1
+#define GPR_ASSERT_LEVEL_DEBUG 2
+#define GPR_ASSERT_LEVEL_PARANOID 3
+#ifndef GPR_ASSERT_LEVEL
+#define GPR_ASSERT_LEVEL GPR_ASSERT_LEVEL_DEBUG
+#endif
+
 namespace core
 {
 
@@ -31,6 +43,7 @@ inline void gpr_assert(bool Expr, std::string_view Msg)
     if (!(Expr))
     {
         core::LogError(fmt::format("Assert failed:\t{}\nSource:\t\t{}, line {}", Msg, __FILE__, __LINE__));
+        core::ShutdownLog();
         std::abort();
     }
 }
@@ -42,6 +55,7 @@ inline void gpr_warn(bool Expr, std::string_view Msg)
     {
         core::LogWarning(fmt::format("Warning Assert failed:\t{}\nSource:\t\t{}, line {}",
             Msg, __FILE__, __LINE__));
+        core::ShutdownLog();
         std::abort();
     }
 }
@@ -101,3 +115,24 @@ inline void gpr_warn(bool Expr, std::string_view Msg)
 }
 #endif
 
+/**
+ * The leveled assertions are macros so that the expression is not evaluated when the level is not compiled in.
+ */
+#ifdef GPR_ASSERT
+#define GPR_ASSERT_ENABLED 1
+#else
+#define GPR_ASSERT_ENABLED 0
+#endif
+#define GPR_ASSERT_AT_LEVEL(Level, Check, Expr, Msg)                        \
+    do                                                                      \
+    {                                                                       \
+        if constexpr (GPR_ASSERT_ENABLED && GPR_ASSERT_LEVEL >= (Level))    \
+        {                                                                   \
+            Check((Expr), (Msg));                                           \
+        }                                                                   \
+    } while (false)
+
+#define gpr_assert_debug(Expr, Msg) GPR_ASSERT_AT_LEVEL(GPR_ASSERT_LEVEL_DEBUG, gpr_assert, Expr, Msg)
+#define gpr_warn_debug(Expr, Msg) GPR_ASSERT_AT_LEVEL(GPR_ASSERT_LEVEL_DEBUG, gpr_warn, Expr, Msg)
+#define gpr_assert_paranoid(Expr, Msg) GPR_ASSERT_AT_LEVEL(GPR_ASSERT_LEVEL_PARANOID, gpr_assert, Expr, Msg)
+#define gpr_warn_paranoid(Expr, Msg) GPR_ASSERT_AT_LEVEL(GPR_ASSERT_LEVEL_PARANOID, gpr_warn, Expr, Msg)
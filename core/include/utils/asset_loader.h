@@ -0,0 +1,92 @@
+/**
+ * \file asset_loader.h
+ */
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace core
+{
+/**
+ * \brief AssetLoader is a class that loads assets in two steps: the decode function runs on a worker thread (file reading, image decoding),
+ * then the upload function runs on the upload thread, the one owning the OpenGL context for the textures.
+ * The upload thread is the thread constructing the loader, the main thread of the Engine in every mode.
+ * IsReady is the gate telling that every submitted asset went through both steps, it can be checked by any thread.
+ */
+class AssetLoader
+{
+public:
+    /**
+     * \brief LoadFunction is a step of an asset loading, returning false if the asset could not be loaded.
+     */
+    using LoadFunction = std::function<bool()>;
+
+    AssetLoader() = default;
+    ~AssetLoader();
+    AssetLoader(const AssetLoader&) = delete;
+    AssetLoader& operator=(const AssetLoader&) = delete;
+
+    /**
+     * \brief Submit is a method that queues an asset for the worker thread, started at the first submit.
+     * \param name is the asset shown in the log if it fails
+     * \param upload is skipped when decode fails
+     */
+    void Submit(std::string name, LoadFunction decode, LoadFunction upload = {});
+    /**
+     * \brief Update is a method that runs the uploads of the decoded assets, without waiting for the others.
+     * It needs to be called by the upload thread.
+     */
+    void Update();
+    /**
+     * \brief Wait is a method that blocks until all the submitted assets are decoded and uploaded.
+     * On the upload thread, it runs the uploads itself. On another thread, it waits for the upload thread to call Update.
+     */
+    void Wait();
+    [[nodiscard]] bool IsReady() const
+    {
+        return loadedNmb_.load(std::memory_order_acquire) == submittedNmb_.load(std::memory_order_acquire);
+    }
+    [[nodiscard]] std::size_t GetFailedNmb() const { return failedNmb_.load(std::memory_order_acquire); }
+    [[nodiscard]] bool IsUploadThread() const { return std::this_thread::get_id() == uploadThreadId_; }
+private:
+    struct AssetJob
+    {
+        std::string name;
+        LoadFunction decode;
+        LoadFunction upload;
+        bool isDecoded = false;
+    };
+    void RunWorker();
+    /**
+     * \brief Upload is a method that runs the upload step of the decoded jobs.
+     */
+    void Upload(std::vector<AssetJob>& decodedJobs);
+
+    std::thread worker_;
+    std::thread::id uploadThreadId_ = std::this_thread::get_id();
+    std::mutex mutex_;
+    std::condition_variable jobCondition_;
+    std::condition_variable decodedCondition_;
+    std::condition_variable loadedCondition_;
+    /**
+     * \brief pendingJobs_ and decodedJobs_ are shared with the worker under mutex_
+     */
+    std::deque<AssetJob> pendingJobs_;
+    std::vector<AssetJob> decodedJobs_;
+    bool isStopping_ = false;
+    /**
+     * \brief loadedNmb_ and failedNmb_ are written by the upload thread, after the upload step of an asset
+     */
+    std::atomic<std::size_t> submittedNmb_{ 0 };
+    std::atomic<std::size_t> loadedNmb_{ 0 };
+    std::atomic<std::size_t> failedNmb_{ 0 };
+};
+}
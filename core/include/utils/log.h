@@ -1,9 +1,87 @@
+/**
+ * \file log.h
+ */
 #pragma once
 
+#include <atomic>
+#include <cstdint>
+#include <iterator>
 #include <string_view>
+#include <utility>
+
+#include <fmt/format.h>
+
+/**
+ * \brief GPR_LOG_LEVEL is the lowest LogLevel compiled in, set with the Gpr_Log_Level CMake option.
+ * The CORE_LOG macros under it are removed at compile time, their arguments are not evaluated.
+ */
+#ifndef GPR_LOG_LEVEL
+#define GPR_LOG_LEVEL 0
+#endif
 
 namespace core
 {
+/**
+ * \brief LogLevel is the severity of a log message. ERR is not named ERROR as windows.h defines it as a macro.
+ */
+enum class LogLevel : std::uint8_t
+{
+    DEBUG = 0u,
+    WARNING = 1u,
+    ERR = 2u,
+    OFF = 3u
+};
+
+/**
+ * \brief IsLogCompiled is a function that checks if a level is compiled in, see GPR_LOG_LEVEL.
+ */
+constexpr bool IsLogCompiled(LogLevel level)
+{
+    const int levelValue = static_cast<int>(level);
+    return levelValue >= GPR_LOG_LEVEL;
+}
+
+inline std::atomic<LogLevel> currentLogLevel{ LogLevel::DEBUG };
+
+/**
+ * \brief SetLogLevel is a function that sets the lowest LogLevel printed at runtime.
+ */
+inline void SetLogLevel(LogLevel level)
+{
+    currentLogLevel.store(level, std::memory_order_relaxed);
+}
+
+/**
+ * \brief IsLogEnabled is a function that checks if a message of this level would be printed, before formatting it.
+ */
+[[nodiscard]] inline bool IsLogEnabled(LogLevel level)
+{
+    return level >= currentLogLevel.load(std::memory_order_relaxed);
+}
+
+/**
+ * \brief Log is a function that queues the msg to the asynchronous console logger, the game thread never waits for the console.
+ * When the queue is full, the oldest messages are dropped.
+ * \param msg is the text to be printed, copied in the queue
+ */
+void Log(LogLevel level, std::string_view msg);
+/**
+ * \brief ShutdownLog is a function that prints all the queued messages and stops the logger thread, before an abort.
+ */
+void ShutdownLog();
+
+/**
+ * \brief LogFormat is a function that formats the message in a stack buffer and queues it to the logger.
+ * It is called by the CORE_LOG macros once the level is known to be enabled.
+ */
+template<typename... Args>
+void LogFormat(LogLevel level, fmt::format_string<Args...> format, Args&&... args)
+{
+    fmt::memory_buffer buffer;
+    fmt::format_to(std::back_inserter(buffer), format, std::forward<Args>(args)...);
+    Log(level, std::string_view(buffer.data(), buffer.size()));
+}
+
 /**
  * \brief LogDebug is a function that prints the msg to the console
  * \param msg is the text to be printed
@@ -19,4 +97,24 @@ void LogWarning(std::string_view msg);
  * \param msg is the text to be printed
  */
 void LogError(std::string_view msg);
-}
\ No newline at end of file
+}
+
+/**
+ * \brief CORE_LOG formats and logs a message only if its level is compiled in and enabled at runtime.
+ * The arguments are forwarded to fmt, the format string is checked at compile time.
+ */
+#define CORE_LOG(level, ...)                                            \
+    do                                                                  \
+    {                                                                   \
+        if constexpr (::core::IsLogCompiled(level))                     \
+        {                                                               \
+            if (::core::IsLogEnabled(level))                            \
+            {                                                           \
+                ::core::LogFormat(level, __VA_ARGS__);                  \
+            }                                                           \
+        }                                                               \
+    } while (false)
+
+#define CORE_LOG_DEBUG(...) CORE_LOG(::core::LogLevel::DEBUG, __VA_ARGS__)
+#define CORE_LOG_WARNING(...) CORE_LOG(::core::LogLevel::WARNING, __VA_ARGS__)
+#define CORE_LOG_ERROR(...) CORE_LOG(::core::LogLevel::ERR, __VA_ARGS__)
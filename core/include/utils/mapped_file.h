@@ -0,0 +1,65 @@
+/**
+ * \file mapped_file.h
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace core
+{
+/**
+ * \brief MappedFile is a class that maps a whole file in memory, with mmap on POSIX and a file mapping on Windows.
+ * In WRITE mode the file can grow with Resize, the mapping is recreated and the data pointer changes.
+ */
+class MappedFile
+{
+public:
+    enum class Mode : std::uint8_t
+    {
+        READ,
+        WRITE
+    };
+    MappedFile() = default;
+    ~MappedFile();
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    /**
+     * \brief Open is a method that maps a file.
+     * \param mode WRITE creates or truncates the file
+     * \param size is the initial size of the file in WRITE mode, ignored in READ mode
+     * \return false if the file could not be opened or mapped
+     */
+    bool Open(std::string_view path, Mode mode, std::size_t size = 0);
+    /**
+     * \brief Resize is a method that changes the size of a file opened in WRITE mode and maps it again.
+     */
+    bool Resize(std::size_t size);
+    /**
+     * \brief Close is a method that unmaps the file. In WRITE mode the file is truncated to finalSize.
+     */
+    void Close(std::size_t finalSize);
+    void Close();
+
+    [[nodiscard]] std::uint8_t* GetData() { return data_; }
+    [[nodiscard]] const std::uint8_t* GetData() const { return data_; }
+    [[nodiscard]] std::size_t GetSize() const { return size_; }
+    [[nodiscard]] bool IsOpen() const { return data_ != nullptr; }
+private:
+    bool Map();
+    void Unmap();
+    bool SetFileSize(std::size_t size);
+
+    std::uint8_t* data_ = nullptr;
+    std::size_t size_ = 0;
+    Mode mode_ = Mode::READ;
+#ifdef _WIN32
+    void* file_ = nullptr;
+    void* mapping_ = nullptr;
+#else
+    int file_ = -1;
+#endif
+};
+}
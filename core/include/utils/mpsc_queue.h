@@ -0,0 +1,136 @@
+/**
+ * \file mpsc_queue.h
+ */
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+
+namespace core
+{
+/**
+ * \brief MpscQueue is a bounded lock-free multi-producer single-consumer ring of POD records.
+ * Each cell has a sequence number telling if it is free for the producers or ready for the consumer,
+ * so a push or a pop is one compare-and-swap on the shared index plus one copy of the record.
+ * When the ring is full, the pushed record is dropped and counted, producers never wait for the consumer.
+ * \tparam T is the record type, it needs to be trivially copyable
+ * \tparam Capacity is the maximum number of records in the ring, it needs to be a power of two
+ */
+template<typename T, std::size_t Capacity>
+class MpscQueue
+{
+    static_assert(std::is_trivially_copyable_v<T>, "MpscQueue records need to be trivially copyable");
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "MpscQueue capacity needs to be a power of two");
+public:
+    MpscQueue() : cells_(std::make_unique<Cell[]>(Capacity))
+    {
+        for (std::size_t i = 0; i < Capacity; i++)
+        {
+            cells_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+    MpscQueue(const MpscQueue&) = delete;
+    MpscQueue& operator=(const MpscQueue&) = delete;
+
+    /**
+     * \brief TryPush is a method that copies a record in the ring, it can be called from any thread.
+     * \return false if the ring was full and the record was dropped
+     */
+    bool TryPush(const T& record)
+    {
+        auto position = pushPosition_.load(std::memory_order_relaxed);
+        while (true)
+        {
+            auto& cell = cells_[position & mask];
+            const auto sequence = cell.sequence.load(std::memory_order_acquire);
+            const auto difference = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position);
+            if (difference == 0)
+            {
+                if (pushPosition_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                {
+                    cell.record = record;
+                    cell.sequence.store(position + 1, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if (difference < 0)
+            {
+                //The consumer did not release this cell yet, the ring is full
+                droppedNmb_.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+            else
+            {
+                position = pushPosition_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /**
+     * \brief TryPop is a method that moves the oldest record out of the ring, it can only be called by the consumer thread.
+     * \return false if no record is ready
+     */
+    bool TryPop(T& record)
+    {
+        const auto position = popPosition_.load(std::memory_order_relaxed);
+        auto& cell = cells_[position & mask];
+        const auto sequence = cell.sequence.load(std::memory_order_acquire);
+        if (sequence != position + 1)
+        {
+            return false;
+        }
+        record = cell.record;
+        cell.sequence.store(position + Capacity, std::memory_order_release);
+        popPosition_.store(position + 1, std::memory_order_relaxed);
+        return true;
+    }
+
+    /**
+     * \brief PopBatch is a method that pops up to maxCount records, it can only be called by the consumer thread.
+     * \param output is an output iterator receiving the records
+     * \return the number of popped records
+     */
+    template<typename OutputIt>
+    std::size_t PopBatch(OutputIt output, std::size_t maxCount = Capacity)
+    {
+        std::size_t count = 0;
+        T record;
+        while (count < maxCount && TryPop(record))
+        {
+            *output++ = record;
+            count++;
+        }
+        return count;
+    }
+
+    /**
+     * \brief GetSizeApprox is a method that returns the number of records in the ring, it is only exact when no thread is using the ring.
+     */
+    [[nodiscard]] std::size_t GetSizeApprox() const
+    {
+        const auto pushPosition = pushPosition_.load(std::memory_order_relaxed);
+        const auto popPosition = popPosition_.load(std::memory_order_relaxed);
+        return pushPosition > popPosition ? pushPosition - popPosition : 0;
+    }
+    [[nodiscard]] std::uint64_t GetDroppedNmb() const { return droppedNmb_.load(std::memory_order_relaxed); }
+    static constexpr std::size_t GetCapacity() { return Capacity; }
+private:
+    static constexpr std::size_t mask = Capacity - 1;
+    static constexpr std::size_t cacheLineSize = 64;
+
+    struct Cell
+    {
+        std::atomic<std::size_t> sequence{ 0 };
+        T record{};
+    };
+
+    std::unique_ptr<Cell[]> cells_;
+    //The producers and the consumer indices are on different cache lines to avoid false sharing
+    alignas(cacheLineSize) std::atomic<std::size_t> pushPosition_{ 0 };
+    alignas(cacheLineSize) std::atomic<std::size_t> popPosition_{ 0 };
+    alignas(cacheLineSize) std::atomic<std::uint64_t> droppedNmb_{ 0 };
+};
+}
@@ -0,0 +1,70 @@
+/**
+ * \file triple_buffer.h
+ */
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace core
+{
+/**
+ * \brief TripleBuffer is a lock-free single-producer single-consumer exchange of the latest value.
+ * The producer writes in its own buffer and publishes it by swapping it with the middle one, the consumer takes the middle one
+ * when it is newer than its own. Neither side ever waits: a slow consumer skips the values published in between,
+ * a slow producer lets the consumer read the last value again.
+ * \tparam T is the value type, the buffers are reused and keep their capacity
+ */
+template<typename T>
+class TripleBuffer
+{
+public:
+    TripleBuffer() = default;
+    TripleBuffer(const TripleBuffer&) = delete;
+    TripleBuffer& operator=(const TripleBuffer&) = delete;
+
+    /**
+     * \brief GetWriteBuffer is a method that returns the buffer owned by the producer, holding an old value to be overwritten.
+     */
+    [[nodiscard]] T& GetWriteBuffer() { return buffers_[writeIndex_]; }
+    /**
+     * \brief Publish is a method that makes the write buffer the latest value, the producer gets another buffer to write.
+     */
+    void Publish()
+    {
+        const auto previousMiddle = middle_.exchange(static_cast<std::uint8_t>(writeIndex_ | freshFlag), std::memory_order_acq_rel);
+        writeIndex_ = previousMiddle & indexMask;
+    }
+
+    /**
+     * \brief Consume is a method that takes the latest published value as the read buffer.
+     * \return false if nothing was published since the last call, the read buffer is unchanged
+     */
+    bool Consume()
+    {
+        if ((middle_.load(std::memory_order_relaxed) & freshFlag) == 0)
+        {
+            return false;
+        }
+        const auto previousMiddle = middle_.exchange(readIndex_, std::memory_order_acq_rel);
+        readIndex_ = previousMiddle & indexMask;
+        return true;
+    }
+    /**
+     * \brief GetReadBuffer is a method that returns the buffer owned by the consumer, the last value taken by Consume.
+     */
+    [[nodiscard]] const T& GetReadBuffer() const { return buffers_[readIndex_]; }
+private:
+    static constexpr std::uint8_t indexMask = 0b11u;
+    static constexpr std::uint8_t freshFlag = 0b100u;
+
+    std::array<T, 3> buffers_{};
+    std::uint8_t writeIndex_ = 0;
+    /**
+     * \brief middle_ is the index of the buffer exchanged between the two threads, with freshFlag set when it was published and not consumed yet
+     */
+    std::atomic<std::uint8_t> middle_{ 1 };
+    std::uint8_t readIndex_ = 2;
+};
+}
@@ -6,6 +6,10 @@
 
 #include "engine/globals.h"
 
+#include <thread>
+
+#include <SFML/Graphics/Sprite.hpp>
+#include <SFML/System/Sleep.hpp>
 #include <SFML/Window/Event.hpp>
 #include <imgui.h>
 #include <imgui-SFML.h>
@@ -20,6 +24,16 @@ namespace core
 {
 void Engine::Run()
 {
+    if (isHeadless_)
+    {
+        RunHeadless();
+        return;
+    }
+    if (isRenderThreadEnabled_)
+    {
+        RunRenderThread();
+        return;
+    }
     Init();
     sf::Clock clock;
     while (window_->isOpen())
@@ -34,13 +48,19 @@ void Engine::Run()
         }
         catch ([[maybe_unused]] const AssertException& e)
         {
-            LogError("Exit with exception");
+            CORE_LOG_ERROR("Exit with exception");
             window_->close();
         }
     }
     Destroy();
 }
 
+void Engine::SetClock(EngineClock clock, sf::Time fixedDeltaTime)
+{
+    clock_ = clock;
+    fixedDeltaTime_ = fixedDeltaTime;
+}
+
 void Engine::RegisterApp(App* app)
 {
     RegisterSystem(app);
@@ -69,6 +89,11 @@ void Engine::RegisterDrawImGui(DrawImGuiInterface* drawImGuiInterface)
     drawImGuiInterfaces_.push_back(drawImGuiInterface);
 }
 
+void Engine::RegisterRecordDraw(RecordDrawInterface* recordDrawInterface)
+{
+    recordDrawInterfaces_.push_back(recordDrawInterface);
+}
+
 void Engine::Init()
 {
 
@@ -79,7 +104,7 @@ void Engine::Init()
     const bool status = ImGui::SFML::Init(*window_);
     if(!status)
     {
-        LogError("Could not init ImGui-SFML");
+        CORE_LOG_ERROR("Could not init ImGui-SFML");
     }
     for(auto* system : systems_)
     {
@@ -87,7 +112,35 @@ void Engine::Init()
     }
 }
 
-void Engine::Update(sf::Time dt) const
+void Engine::Update(sf::Time dt)
+{
+
+#ifdef TRACY_ENABLE
+    ZoneScoped;
+#endif
+    PollEvents();
+    for(auto* system : systems_)
+    {
+        system->Update(dt);
+    }
+    ImGui::SFML::Update(*window_, dt);
+    const sf::Color windowColor(192, 192, 192, 255);
+    window_->clear(windowColor);
+
+    for(auto* drawInterface : drawInterfaces_)
+    {
+        drawInterface->Draw(*window_);
+    }
+    for(auto* drawImGuiInterface : drawImGuiInterfaces_)
+    {
+        drawImGuiInterface->DrawImGui();
+    }
+    ImGui::SFML::Render(*window_);
+
+    window_->display();
+}
+
+void Engine::PollEvents()
 {
 
 #ifdef TRACY_ENABLE
@@ -106,37 +159,197 @@ void Engine::Update(sf::Time dt) const
         {
             sf::FloatRect visibleArea(0, 0, static_cast<float>(e.size.width), static_cast<float>(e.size.height));
             window_->setView(sf::View(visibleArea));
+            if (isRenderThreadEnabled_ && !imGuiLayer_.create(e.size.width, e.size.height))
+            {
+                CORE_LOG_ERROR("Could not resize the ImGui layer");
+            }
             break;
         }
         default:
             break;
         }
+        if (isRenderThreadEnabled_)
+        {
+            if (!events_.TryPush(e))
+            {
+                CORE_LOG_WARNING("Event queue is full, the simulation thread dropped an event");
+            }
+            continue;
+        }
         for(auto* eventInterface : eventInterfaces_)
         {
             eventInterface->OnEvent(e);
         }
     }
-    for(auto* system : systems_)
+}
+
+void Engine::RunRenderThread()
+{
+    Init();
+    if (recordDrawInterfaces_.empty())
     {
-        system->Update(dt);
+        CORE_LOG_WARNING("Render thread mode without RecordDrawInterface, only ImGui is drawn");
     }
-    ImGui::SFML::Update(*window_, dt);
+    if (!imGuiLayer_.create(window_->getSize().x, window_->getSize().y))
+    {
+        CORE_LOG_ERROR("Could not create the ImGui layer");
+    }
+    isSimulationRunning_.store(true, std::memory_order_release);
+    std::thread simulationThread(&Engine::RunSimulationThread, this);
+    sf::Clock clock;
+    while (window_->isOpen())
+    {
+        const auto dt = clock.restart();
+        Render(dt);
+#ifdef TRACY_ENABLE
+        FrameMark;
+#endif
+        if (!isSimulationRunning_.load(std::memory_order_acquire))
+        {
+            window_->close();
+        }
+    }
+    isSimulationRunning_.store(false, std::memory_order_release);
+    simulationThread.join();
+    Destroy();
+}
+
+void Engine::RunSimulationThread()
+{
+    const auto simulationThreadPeriod = sf::microseconds(simulationThreadPeriodUs);
+    sf::Clock clock;
+    while (isSimulationRunning_.load(std::memory_order_acquire))
+    {
+        const auto dt = clock.restart();
+        //The lock is taken for each step, so the main thread can build the ImGui windows between them
+        try
+        {
+            {
+                std::scoped_lock lock(simulationMutex_);
+                sf::Event e{};
+                while (events_.TryPop(e))
+                {
+                    for (auto* eventInterface : eventInterfaces_)
+                    {
+                        eventInterface->OnEvent(e);
+                    }
+                }
+            }
+            for (auto* system : systems_)
+            {
+                std::scoped_lock lock(simulationMutex_);
+                system->Update(dt);
+            }
+            auto& snapshot = renderSnapshots_.GetWriteBuffer();
+            snapshot.Clear();
+            std::scoped_lock lock(simulationMutex_);
+            for (auto* recordDrawInterface : recordDrawInterfaces_)
+            {
+                recordDrawInterface->RecordDraw(snapshot);
+            }
+        }
+        catch ([[maybe_unused]] const AssertException& e)
+        {
+            CORE_LOG_ERROR("Exit with exception");
+            isSimulationRunning_.store(false, std::memory_order_release);
+            break;
+        }
+        renderSnapshots_.Publish();
+        const auto updateTime = clock.getElapsedTime();
+        if (updateTime < simulationThreadPeriod)
+        {
+            sf::sleep(simulationThreadPeriod - updateTime);
+        }
+    }
+}
+
+void Engine::Render(sf::Time dt)
+{
+
+#ifdef TRACY_ENABLE
+    ZoneScoped;
+#endif
+    PollEvents();
     const sf::Color windowColor(192, 192, 192, 255);
     window_->clear(windowColor);
-
-    for(auto* drawInterface : drawInterfaces_)
+    for (auto* recordDrawInterface : recordDrawInterfaces_)
     {
-        drawInterface->Draw(*window_);
+        recordDrawInterface->UploadResources();
     }
-    for(auto* drawImGuiInterface : drawImGuiInterfaces_)
+    //Without a new snapshot, the last one is drawn again
+    renderSnapshots_.Consume();
+    renderSnapshots_.GetReadBuffer().Draw(*window_);
+    //While the simulation thread is updating, the last ImGui windows are drawn again instead of waiting for it
+    imGuiDeltaTime_ += dt;
+    std::unique_lock lock(simulationMutex_, std::try_to_lock);
+    if (lock.owns_lock())
     {
-        drawImGuiInterface->DrawImGui();
+        ImGui::SFML::Update(*window_, imGuiDeltaTime_);
+        imGuiDeltaTime_ = sf::Time::Zero;
+        for (auto* drawImGuiInterface : drawImGuiInterfaces_)
+        {
+            drawImGuiInterface->DrawImGui();
+        }
+        //The draw lists are built, rendering them does not read the game state
+        lock.unlock();
+        imGuiLayer_.clear(sf::Color::Transparent);
+        ImGui::SFML::Render(imGuiLayer_);
+        imGuiLayer_.display();
     }
-    ImGui::SFML::Render(*window_);
+    //The snapshot views are replaced by the pixel view the ImGui layer was rendered with
+    const auto layerSize = sf::Vector2f(imGuiLayer_.getSize());
+    window_->setView(sf::View(sf::FloatRect(0.0f, 0.0f, layerSize.x, layerSize.y)));
+    window_->draw(sf::Sprite(imGuiLayer_.getTexture()));
 
     window_->display();
 }
 
+void Engine::RunHeadless()
+{
+
+#ifdef TRACY_ENABLE
+    ZoneScoped;
+#endif
+    for (auto* system : systems_)
+    {
+        system->Begin();
+    }
+    isRunning_.store(true, std::memory_order_release);
+    sf::Clock clock;
+    sf::Time nextUpdateTime;
+    for (updateNmb_ = 0; isRunning_.load(std::memory_order_acquire) && (maxUpdateNmb_ == 0 || updateNmb_ < maxUpdateNmb_); updateNmb_++)
+    {
+        const auto dt = clock_ == EngineClock::REAL_TIME ? clock.restart() : fixedDeltaTime_;
+        try
+        {
+            for (auto* system : systems_)
+            {
+                system->Update(dt);
+            }
+        }
+        catch ([[maybe_unused]] const AssertException& e)
+        {
+            CORE_LOG_ERROR("Exit with exception");
+            break;
+        }
+#ifdef TRACY_ENABLE
+        FrameMark;
+#endif
+        if (clock_ == EngineClock::FIXED)
+        {
+            //The next update is scheduled from the previous one, so the sleep overshoots do not add up
+            nextUpdateTime += fixedDeltaTime_;
+            const auto currentTime = clock.getElapsedTime();
+            if (currentTime < nextUpdateTime)
+            {
+                sf::sleep(nextUpdateTime - currentTime);
+            }
+        }
+    }
+    isRunning_.store(false, std::memory_order_release);
+    Destroy();
+}
+
 void Engine::Destroy()
 {
 
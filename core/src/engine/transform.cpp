@@ -38,6 +38,14 @@ const std::vector<Degree>& TransformManager::GetAllRotations() const
 
 void TransformManager::SetPosition(Entity entity, Vec2f position)
 {
+    if (isTrackingChanges_)
+    {
+        const auto previousPosition = positionManager_.GetComponent(entity);
+        if (previousPosition.x != position.x || previousPosition.y != position.y)
+        {
+            MarkChanged(entity, TransformChange::POSITION);
+        }
+    }
     positionManager_.SetComponent(entity, position);
 }
 
@@ -48,6 +56,14 @@ Vec2f TransformManager::GetScale(Entity entity) const
 
 void TransformManager::SetScale(Entity entity, Vec2f scale)
 {
+    if (isTrackingChanges_)
+    {
+        const auto previousScale = scaleManager_.GetComponent(entity);
+        if (previousScale.x != scale.x || previousScale.y != scale.y)
+        {
+            MarkChanged(entity, TransformChange::SCALE);
+        }
+    }
     scaleManager_.SetComponent(entity, scale);
 }
 
@@ -58,6 +74,10 @@ Degree TransformManager::GetRotation(Entity entity) const
 
 void TransformManager::SetRotation(Entity entity, Degree rotation)
 {
+    if (isTrackingChanges_ && rotationManager_.GetComponent(entity).value() != rotation.value())
+    {
+        MarkChanged(entity, TransformChange::ROTATION);
+    }
     rotationManager_.SetComponent(entity, rotation);
 }
 
@@ -66,6 +86,32 @@ void TransformManager::AddComponent(Entity entity)
     positionManager_.AddComponent(entity);
     scaleManager_.AddComponent(entity);
     rotationManager_.AddComponent(entity);
+    if (isTrackingChanges_)
+    {
+        MarkChanged(entity, TransformChange::ADDED);
+    }
+}
+
+void TransformManager::ClearChanges()
+{
+    for (const auto entity : changedEntities_)
+    {
+        changes_[entity] = 0u;
+    }
+    changedEntities_.clear();
+}
+
+void TransformManager::MarkChanged(Entity entity, TransformChange change)
+{
+    if (entity >= changes_.size())
+    {
+        changes_.resize(entity + 1, 0u);
+    }
+    if (changes_[entity] == 0u)
+    {
+        changedEntities_.push_back(entity);
+    }
+    changes_[entity] |= static_cast<std::uint8_t>(change);
 }
 
 void TransformManager::RemoveComponent(Entity entity)
@@ -0,0 +1,202 @@
+#include "graphics/cached_text.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+
+#ifdef TRACY_ENABLE
+#include <Tracy.hpp>
+#endif
+
+namespace core
+{
+void CachedText::SetFont(const sf::Font& font)
+{
+    if (font_ == &font)
+    {
+        return;
+    }
+    font_ = &font;
+    isLayoutDirty_ = true;
+}
+
+void CachedText::SetString(std::string_view string)
+{
+    if (string_ == string)
+    {
+        return;
+    }
+    string_.assign(string);
+    isLayoutDirty_ = true;
+}
+
+void CachedText::SetCharacterSize(unsigned characterSize)
+{
+    if (characterSize_ == characterSize)
+    {
+        return;
+    }
+    characterSize_ = characterSize;
+    isLayoutDirty_ = true;
+}
+
+void CachedText::SetColor(sf::Color color)
+{
+    if (color_ == color)
+    {
+        return;
+    }
+    color_ = color;
+    areVerticesDirty_ = true;
+}
+
+void CachedText::SetPosition(sf::Vector2f position)
+{
+    if (!isCentered_ && position_ == position)
+    {
+        return;
+    }
+    position_ = position;
+    isCentered_ = false;
+    areVerticesDirty_ = true;
+}
+
+void CachedText::SetCenter(sf::Vector2f center)
+{
+    if (isCentered_ && position_ == center)
+    {
+        return;
+    }
+    position_ = center;
+    isCentered_ = true;
+    areVerticesDirty_ = true;
+}
+
+const sf::FloatRect& CachedText::GetLocalBounds()
+{
+    UpdateLayout();
+    return bounds_;
+}
+
+std::span<const sf::Vertex> CachedText::GetVertices()
+{
+    UpdateVertices();
+    return vertices_;
+}
+
+const sf::Texture* CachedText::GetTexture() const
+{
+    return font_ == nullptr ? nullptr : &font_->getTexture(characterSize_);
+}
+
+void CachedText::Draw(sf::RenderTarget& renderTarget)
+{
+    UpdateVertices();
+    if (vertices_.empty())
+    {
+        return;
+    }
+    renderTarget.draw(vertices_.data(), vertices_.size(), sf::Triangles, sf::RenderStates(GetTexture()));
+}
+
+void CachedText::UpdateLayout()
+{
+    if (!isLayoutDirty_)
+    {
+        return;
+    }
+
+#ifdef TRACY_ENABLE
+    ZoneScoped;
+#endif
+    isLayoutDirty_ = false;
+    areVerticesDirty_ = true;
+    localVertices_.clear();
+    bounds_ = {};
+    if (font_ == nullptr || string_.empty())
+    {
+        return;
+    }
+    layoutNmb_++;
+    //Same layout as sf::Text, the glyphs are padded by one pixel in the font texture
+    constexpr float padding = 1.0f;
+    const float lineSpacing = font_->getLineSpacing(characterSize_);
+    const float whitespaceAdvance = font_->getGlyph(U' ', characterSize_, false).advance;
+    float x = 0.0f;
+    auto y = static_cast<float>(characterSize_);
+    float minX = std::numeric_limits<float>::max();
+    float minY = std::numeric_limits<float>::max();
+    float maxX = std::numeric_limits<float>::lowest();
+    float maxY = std::numeric_limits<float>::lowest();
+    std::uint32_t previousChar = 0;
+    for (const auto character : string_)
+    {
+        const auto currentChar = static_cast<std::uint32_t>(static_cast<unsigned char>(character));
+        x += font_->getKerning(previousChar, currentChar, characterSize_);
+        previousChar = currentChar;
+        switch (currentChar)
+        {
+        case U'\n':
+            y += lineSpacing;
+            x = 0.0f;
+            continue;
+        case U' ':
+            x += whitespaceAdvance;
+            continue;
+        case U'\t':
+            x += whitespaceAdvance * 4.0f;
+            continue;
+        default:
+            break;
+        }
+        const auto& glyph = font_->getGlyph(currentChar, characterSize_, false);
+        const float left = x + glyph.bounds.left - padding;
+        const float top = y + glyph.bounds.top - padding;
+        const float right = x + glyph.bounds.left + glyph.bounds.width + padding;
+        const float bottom = y + glyph.bounds.top + glyph.bounds.height + padding;
+        const float u1 = static_cast<float>(glyph.textureRect.left) - padding;
+        const float v1 = static_cast<float>(glyph.textureRect.top) - padding;
+        const float u2 = static_cast<float>(glyph.textureRect.left + glyph.textureRect.width) + padding;
+        const float v2 = static_cast<float>(glyph.textureRect.top + glyph.textureRect.height) + padding;
+        localVertices_.emplace_back(sf::Vector2f(left, top), color_, sf::Vector2f(u1, v1));
+        localVertices_.emplace_back(sf::Vector2f(right, top), color_, sf::Vector2f(u2, v1));
+        localVertices_.emplace_back(sf::Vector2f(left, bottom), color_, sf::Vector2f(u1, v2));
+        localVertices_.emplace_back(sf::Vector2f(left, bottom), color_, sf::Vector2f(u1, v2));
+        localVertices_.emplace_back(sf::Vector2f(right, top), color_, sf::Vector2f(u2, v1));
+        localVertices_.emplace_back(sf::Vector2f(right, bottom), color_, sf::Vector2f(u2, v2));
+
+        minX = std::min(minX, x + glyph.bounds.left);
+        maxX = std::max(maxX, x + glyph.bounds.left + glyph.bounds.width);
+        minY = std::min(minY, y + glyph.bounds.top);
+        maxY = std::max(maxY, y + glyph.bounds.top + glyph.bounds.height);
+        x += glyph.advance;
+    }
+    if (!localVertices_.empty())
+    {
+        bounds_ = sf::FloatRect(minX, minY, maxX - minX, maxY - minY);
+    }
+}
+
+void CachedText::UpdateVertices()
+{
+    UpdateLayout();
+    if (!areVerticesDirty_)
+    {
+        return;
+    }
+    areVerticesDirty_ = false;
+    //The position places the bounds, not the origin of the first line
+    auto offset = sf::Vector2f(position_.x - bounds_.left, position_.y - bounds_.top);
+    if (isCentered_)
+    {
+        offset -= sf::Vector2f(bounds_.width / 2.0f, bounds_.height / 2.0f);
+    }
+    vertices_.resize(localVertices_.size());
+    for (std::size_t i = 0; i < localVertices_.size(); i++)
+    {
+        vertices_[i] = localVertices_[i];
+        vertices_[i].position += offset;
+        vertices_[i].color = color_;
+    }
+}
+}
@@ -0,0 +1,100 @@
+#include "graphics/render_snapshot.h"
+
+#ifdef TRACY_ENABLE
+#include <Tracy.hpp>
+#endif
+
+namespace core
+{
+void RenderSnapshot::Clear()
+{
+    commands_.clear();
+    vertices_.clear();
+    views_.clear();
+    texts_.clear();
+}
+
+void RenderSnapshot::SetView(const sf::View& view)
+{
+    RenderCommand command;
+    command.type = RenderCommand::Type::VIEW;
+    command.index = views_.size();
+    commands_.push_back(command);
+    views_.push_back(view);
+}
+
+void RenderSnapshot::AddVertices(std::span<const sf::Vertex> vertices, sf::PrimitiveType primitiveType, const sf::Texture* texture)
+{
+    if (vertices.empty())
+    {
+        return;
+    }
+    //Strips and fans would be joined to the previous shape
+    const bool canMerge = primitiveType == sf::Triangles || primitiveType == sf::Lines || primitiveType == sf::Points;
+    if (canMerge && !commands_.empty())
+    {
+        auto& lastCommand = commands_.back();
+        if (lastCommand.type == RenderCommand::Type::VERTICES &&
+            lastCommand.primitiveType == primitiveType &&
+            lastCommand.texture == texture)
+        {
+            vertices_.insert(vertices_.end(), vertices.begin(), vertices.end());
+            lastCommand.count += vertices.size();
+            return;
+        }
+    }
+    RenderCommand command;
+    command.type = RenderCommand::Type::VERTICES;
+    command.primitiveType = primitiveType;
+    command.texture = texture;
+    command.index = vertices_.size();
+    command.count = vertices.size();
+    commands_.push_back(command);
+    vertices_.insert(vertices_.end(), vertices.begin(), vertices.end());
+}
+
+void RenderSnapshot::AddText(const sf::Font& font, std::string_view string, unsigned characterSize, sf::Color color, sf::Vector2f center)
+{
+    RenderCommand command;
+    command.type = RenderCommand::Type::TEXT;
+    command.index = texts_.size();
+    commands_.push_back(command);
+    texts_.push_back({ &font, std::string(string), characterSize, color, center });
+}
+
+void RenderSnapshot::Draw(sf::RenderTarget& renderTarget) const
+{
+
+#ifdef TRACY_ENABLE
+    ZoneScoped;
+#endif
+    if (cachedTexts_.size() < texts_.size())
+    {
+        cachedTexts_.resize(texts_.size());
+    }
+    for (const auto& command : commands_)
+    {
+        switch (command.type)
+        {
+        case RenderCommand::Type::VERTICES:
+            renderTarget.draw(&vertices_[command.index], command.count, command.primitiveType, sf::RenderStates(command.texture));
+            break;
+        case RenderCommand::Type::TEXT:
+        {
+            const auto& text = texts_[command.index];
+            auto& cachedText = cachedTexts_[command.index];
+            cachedText.SetFont(*text.font);
+            cachedText.SetString(text.string);
+            cachedText.SetCharacterSize(text.characterSize);
+            cachedText.SetColor(text.color);
+            cachedText.SetCenter(text.center);
+            cachedText.Draw(renderTarget);
+            break;
+        }
+        case RenderCommand::Type::VIEW:
+            renderTarget.setView(views_[command.index]);
+            break;
+        }
+    }
+}
+}
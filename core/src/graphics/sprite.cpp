@@ -1,48 +1,177 @@
 #include <graphics/sprite.h>
 #include <engine/transform.h>
 
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <span>
+
+#include <SFML/Graphics/Transform.hpp>
+
+#ifdef TRACY_ENABLE
+#include <Tracy.hpp>
+#endif
+
 namespace core
 {
+void SpriteManager::AddComponent(Entity entity)
+{
+    ComponentManager::AddComponent(entity);
+    components_[entity] = Sprite();
+}
+
 void SpriteManager::SetOrigin(Entity entity, sf::Vector2f origin)
 {
-    components_[entity].setOrigin(origin);
+    components_[entity].origin = origin;
 }
 
 void SpriteManager::SetTexture(Entity entity, const sf::Texture& texture)
 {
-    components_[entity].setTexture(texture);
+    const auto textureSize = texture.getSize();
+    SetTexture(entity, texture, sf::IntRect(0, 0, static_cast<int>(textureSize.x), static_cast<int>(textureSize.y)));
+}
+
+void SpriteManager::SetTexture(Entity entity, const sf::Texture& texture, const sf::IntRect& textureRect)
+{
+    auto& sprite = components_[entity];
+    sprite.textureId = RegisterTexture(texture);
+    sprite.rectLeft = static_cast<std::int16_t>(textureRect.left);
+    sprite.rectTop = static_cast<std::int16_t>(textureRect.top);
+    sprite.rectWidth = static_cast<std::int16_t>(textureRect.width);
+    sprite.rectHeight = static_cast<std::int16_t>(textureRect.height);
+}
+
+TextureId SpriteManager::RegisterTexture(const sf::Texture& texture)
+{
+    const auto it = std::find(textures_.begin(), textures_.end(), &texture);
+    if (it != textures_.end())
+    {
+        return static_cast<TextureId>(std::distance(textures_.begin(), it));
+    }
+    gpr_assert(textures_.size() < INVALID_TEXTURE_ID, "Too many sprite textures");
+    textures_.push_back(&texture);
+    return static_cast<TextureId>(textures_.size() - 1);
 }
 
 void SpriteManager::Draw(sf::RenderTarget& window)
 {
-    for (Entity entity = 0; entity < components_.size(); entity++)
+
+#ifdef TRACY_ENABLE
+    ZoneScoped;
+#endif
+    BuildBatches();
+    for (const auto& batch : batches_)
+    {
+        window.draw(&vertices_[batch.vertexBegin], batch.vertexCount, sf::Triangles, sf::RenderStates(batch.texture));
+    }
+}
+
+void SpriteManager::RecordDraw(RenderSnapshot& snapshot)
+{
+
+#ifdef TRACY_ENABLE
+    ZoneScoped;
+#endif
+    BuildBatches();
+    for (const auto& batch : batches_)
+    {
+        snapshot.AddVertices(std::span(vertices_).subspan(batch.vertexBegin, batch.vertexCount), sf::Triangles, batch.texture);
+    }
+}
+
+void SpriteManager::BuildBatches()
+{
+    drawOrder_.clear();
+    vertices_.clear();
+    batches_.clear();
+    //The components can be allocated past the last entity
+    const auto entityNmb = std::min(components_.size(), entityManager_.GetEntitiesSize());
+    for (Entity entity = 0; entity < entityNmb; entity++)
     {
-        if (entityManager_.HasComponent(entity, static_cast<Component>(ComponentType::SPRITE)))
+        if (entityManager_.HasComponentUnchecked(entity, static_cast<Component>(ComponentType::SPRITE)) &&
+            components_[entity].textureId != INVALID_TEXTURE_ID)
+        {
+            drawOrder_.push_back(entity);
+        }
+    }
+    if (hasLayers_)
+    {
+        std::stable_sort(drawOrder_.begin(), drawOrder_.end(), [this](Entity entity1, Entity entity2)
+        {
+            return components_[entity1].layer < components_[entity2].layer;
+        });
+    }
+
+    const auto& positions = transformManager_.GetAllPositions();
+    const auto& scales = transformManager_.GetAllScales();
+    const auto& rotations = transformManager_.GetAllRotations();
+    for (const auto entity : drawOrder_)
+    {
+        //Without transform, the sprite is drawn at the world origin
+        sf::Vector2f position(center_.x, windowSize_.y - center_.y);
+        sf::Vector2f scale(1.0f, 1.0f);
+        float rotation = 0.0f;
+        if (entityManager_.HasComponentUnchecked(entity, static_cast<Component>(ComponentType::POSITION)))
+        {
+            const auto& transformPosition = positions[entity];
+            position = sf::Vector2f(
+                transformPosition.x * pixelPerMeter + center_.x,
+                windowSize_.y - (transformPosition.y * pixelPerMeter + center_.y));
+        }
+        if (entityManager_.HasComponentUnchecked(entity, static_cast<Component>(ComponentType::SCALE)))
+        {
+            scale = scales[entity];
+        }
+        if (entityManager_.HasComponentUnchecked(entity, static_cast<Component>(ComponentType::ROTATION)))
         {
-            if (entityManager_.HasComponent(entity, static_cast<Component>(ComponentType::POSITION)))
-            {
-                const auto position = transformManager_.GetPosition(entity);
-                components_[entity].setPosition(
-                    position.x * pixelPerMeter + center_.x,
-                    windowSize_.y - (position.y * pixelPerMeter + center_.y));
-            }
-            if (entityManager_.HasComponent(entity, static_cast<Component>(ComponentType::SCALE)))
-            {
-                const auto scale = transformManager_.GetScale(entity);
-                components_[entity].setScale(scale);
-            }
-            if (entityManager_.HasComponent(entity, static_cast<Component>(ComponentType::ROTATION)))
-            {
-                const auto rotation = transformManager_.GetRotation(entity);
-                components_[entity].setRotation(rotation.value());
-            }
-            window.draw(components_[entity]);
+            rotation = rotations[entity].value();
         }
+        AppendSprite(entity, position, scale, rotation);
     }
 }
 
+void SpriteManager::AppendSprite(Entity entity, sf::Vector2f position, sf::Vector2f scale, float rotation)
+{
+    const auto& sprite = components_[entity];
+    const auto* texture = textures_[sprite.textureId];
+    //Same transform as sf::Transformable::getTransform
+    sf::Transform transform;
+    transform.translate(position).rotate(rotation).scale(scale).translate(-sprite.origin);
+
+    const float width = std::abs(static_cast<float>(sprite.rectWidth));
+    const float height = std::abs(static_cast<float>(sprite.rectHeight));
+    const float left = sprite.rectLeft;
+    const float right = left + sprite.rectWidth;
+    const float top = sprite.rectTop;
+    const float bottom = top + sprite.rectHeight;
+    const std::array<sf::Vertex, 4> corners
+    { {
+        sf::Vertex(transform.transformPoint(0.0f, 0.0f), sprite.color, sf::Vector2f(left, top)),
+        sf::Vertex(transform.transformPoint(0.0f, height), sprite.color, sf::Vector2f(left, bottom)),
+        sf::Vertex(transform.transformPoint(width, 0.0f), sprite.color, sf::Vector2f(right, top)),
+        sf::Vertex(transform.transformPoint(width, height), sprite.color, sf::Vector2f(right, bottom)),
+    } };
+
+    if (batches_.empty() || batches_.back().texture != texture)
+    {
+        batches_.push_back({ texture, vertices_.size(), 0 });
+    }
+    //Two triangles per quad, sf::Quads is deprecated and not available on OpenGL ES
+    for (const auto cornerIndex : { 0, 1, 2, 2, 1, 3 })
+    {
+        vertices_.push_back(corners[cornerIndex]);
+    }
+    batches_.back().vertexCount += 6;
+}
+
 void SpriteManager::SetColor(Entity entity, sf::Color color)
 {
-    components_[entity].setColor(color);
+    components_[entity].color = color;
+}
+
+void SpriteManager::SetLayer(Entity entity, std::uint8_t layer)
+{
+    components_[entity].layer = layer;
+    hasLayers_ = hasLayers_ || layer != 0;
 }
 } // namespace core
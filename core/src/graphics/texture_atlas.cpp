@@ -0,0 +1,187 @@
+#include "graphics/texture_atlas.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <numeric>
+
+#include "utils/log.h"
+
+#ifdef TRACY_ENABLE
+#include <Tracy.hpp>
+#endif
+
+namespace core
+{
+std::vector<sf::IntRect> PackAtlasRects(std::span<const sf::Vector2u> sizes, unsigned padding, sf::Vector2u& atlasSize)
+{
+    std::vector<sf::IntRect> rects(sizes.size());
+    atlasSize = {};
+    if (sizes.empty())
+    {
+        return rects;
+    }
+    std::size_t totalArea = 0;
+    unsigned maxWidth = 0;
+    for (const auto& size : sizes)
+    {
+        totalArea += static_cast<std::size_t>(size.x + padding) * (size.y + padding);
+        maxWidth = std::max(maxWidth, size.x);
+    }
+    const auto squareWidth = static_cast<unsigned>(std::ceil(std::sqrt(static_cast<double>(totalArea))));
+    const unsigned atlasWidth = std::bit_ceil(std::max(maxWidth, squareWidth));
+
+    std::vector<std::size_t> order(sizes.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&sizes](std::size_t a, std::size_t b)
+    {
+        return sizes[a].y > sizes[b].y;
+    });
+    unsigned x = 0;
+    unsigned y = 0;
+    unsigned shelfHeight = 0;
+    for (const auto index : order)
+    {
+        const auto& size = sizes[index];
+        if (x > 0 && x + size.x > atlasWidth)
+        {
+            y += shelfHeight + padding;
+            x = 0;
+            shelfHeight = 0;
+        }
+        rects[index] = sf::IntRect(static_cast<int>(x), static_cast<int>(y), static_cast<int>(size.x), static_cast<int>(size.y));
+        x += size.x + padding;
+        shelfHeight = std::max(shelfHeight, size.y);
+    }
+    atlasSize = sf::Vector2u(atlasWidth, y + shelfHeight);
+    return rects;
+}
+
+bool TextureAtlas::LoadFromFile(std::string_view imagePath, std::string_view tablePath)
+{
+
+#ifdef TRACY_ENABLE
+    ZoneScoped;
+#endif
+    std::vector<AtlasRegion> regions;
+    if (!ReadTable(tablePath, regions) || !texture_.loadFromFile(std::string(imagePath)))
+    {
+        return false;
+    }
+    regions_ = std::move(regions);
+    return true;
+}
+
+bool TextureAtlas::PackFromFiles(std::span<const std::string> imagePaths)
+{
+
+#ifdef TRACY_ENABLE
+    ZoneScoped;
+#endif
+    sf::Image atlasImage;
+    std::vector<AtlasRegion> regions;
+    if (!PackImages(imagePaths, atlasImage, regions))
+    {
+        return false;
+    }
+    return LoadFromImage(atlasImage, std::move(regions));
+}
+
+bool TextureAtlas::LoadFromImage(const sf::Image& atlasImage, std::vector<AtlasRegion> regions)
+{
+
+#ifdef TRACY_ENABLE
+    ZoneScoped;
+#endif
+    if (!texture_.loadFromImage(atlasImage))
+    {
+        return false;
+    }
+    regions_ = std::move(regions);
+    return true;
+}
+
+sf::IntRect TextureAtlas::GetRect(std::string_view name) const
+{
+    const auto it = std::find_if(regions_.begin(), regions_.end(), [name](const AtlasRegion& region)
+    {
+        return region.name == name;
+    });
+    if (it == regions_.end())
+    {
+        CORE_LOG_ERROR("Texture atlas has no image named {}", name);
+        return {};
+    }
+    return it->rect;
+}
+
+bool TextureAtlas::PackImages(std::span<const std::string> imagePaths, sf::Image& atlasImage, std::vector<AtlasRegion>& regions)
+{
+    std::vector<sf::Image> images(imagePaths.size());
+    std::vector<sf::Vector2u> sizes(imagePaths.size());
+    bool isLoaded = true;
+    for (std::size_t i = 0; i < imagePaths.size(); i++)
+    {
+        if (!images[i].loadFromFile(imagePaths[i]))
+        {
+            CORE_LOG_ERROR("Could not load atlas image {}", imagePaths[i]);
+            isLoaded = false;
+            continue;
+        }
+        sizes[i] = images[i].getSize();
+    }
+    if (!isLoaded)
+    {
+        return false;
+    }
+    sf::Vector2u atlasSize;
+    const auto rects = PackAtlasRects(sizes, atlasPadding, atlasSize);
+    atlasImage.create(atlasSize.x, atlasSize.y, sf::Color(0, 0, 0, 0));
+    regions.clear();
+    regions.reserve(rects.size());
+    for (std::size_t i = 0; i < rects.size(); i++)
+    {
+        atlasImage.copy(images[i], static_cast<unsigned>(rects[i].left), static_cast<unsigned>(rects[i].top));
+        regions.push_back({ std::filesystem::path(imagePaths[i]).stem().string(), rects[i] });
+    }
+    return true;
+}
+
+bool TextureAtlas::WriteTable(std::string_view path, std::span<const AtlasRegion> regions)
+{
+    std::ofstream table{ std::string(path) };
+    if (!table.is_open())
+    {
+        CORE_LOG_ERROR("Could not write atlas table {}", path);
+        return false;
+    }
+    for (const auto& [name, rect] : regions)
+    {
+        table << name << ' ' << rect.left << ' ' << rect.top << ' ' << rect.width << ' ' << rect.height << '\n';
+    }
+    return static_cast<bool>(table);
+}
+
+bool TextureAtlas::ReadTable(std::string_view path, std::vector<AtlasRegion>& regions)
+{
+    std::ifstream table{ std::string(path) };
+    if (!table.is_open())
+    {
+        return false;
+    }
+    regions.clear();
+    AtlasRegion region;
+    while (table >> region.name >> region.rect.left >> region.rect.top >> region.rect.width >> region.rect.height)
+    {
+        regions.push_back(region);
+    }
+    if (!table.eof())
+    {
+        CORE_LOG_ERROR("Atlas table {} is malformed", path);
+        return false;
+    }
+    return true;
+}
+}
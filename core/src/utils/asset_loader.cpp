@@ -0,0 +1,133 @@
+#include "utils/asset_loader.h"
+
+#include "utils/assert.h"
+#include "utils/log.h"
+
+#ifdef TRACY_ENABLE
+#include <Tracy.hpp>
+#endif
+
+namespace core
+{
+AssetLoader::~AssetLoader()
+{
+    {
+        std::scoped_lock lock(mutex_);
+        isStopping_ = true;
+    }
+    jobCondition_.notify_all();
+    //The assets not decoded yet are dropped, the worker only finishes the current one
+    if (worker_.joinable())
+    {
+        worker_.join();
+    }
+}
+
+void AssetLoader::Submit(std::string name, LoadFunction decode, LoadFunction upload)
+{
+    {
+        std::scoped_lock lock(mutex_);
+        pendingJobs_.push_back({ std::move(name), std::move(decode), std::move(upload) });
+        submittedNmb_.fetch_add(1, std::memory_order_release);
+    }
+    if (!worker_.joinable())
+    {
+        worker_ = std::thread(&AssetLoader::RunWorker, this);
+    }
+    jobCondition_.notify_one();
+}
+
+void AssetLoader::Update()
+{
+    gpr_assert(IsUploadThread(), "Asset uploads need to run on the thread owning the OpenGL context");
+    if (IsReady())
+    {
+        return;
+    }
+    std::vector<AssetJob> decodedJobs;
+    {
+        std::scoped_lock lock(mutex_);
+        decodedJobs.swap(decodedJobs_);
+    }
+    Upload(decodedJobs);
+}
+
+void AssetLoader::Wait()
+{
+
+#ifdef TRACY_ENABLE
+    ZoneScoped;
+#endif
+    if (!IsUploadThread())
+    {
+        std::unique_lock lock(mutex_);
+        loadedCondition_.wait(lock, [this] { return IsReady(); });
+        return;
+    }
+    while (!IsReady())
+    {
+        std::vector<AssetJob> decodedJobs;
+        {
+            std::unique_lock lock(mutex_);
+            decodedCondition_.wait(lock, [this] { return !decodedJobs_.empty(); });
+            decodedJobs.swap(decodedJobs_);
+        }
+        Upload(decodedJobs);
+    }
+}
+
+void AssetLoader::Upload(std::vector<AssetJob>& decodedJobs)
+{
+    for (auto& job : decodedJobs)
+    {
+        bool isLoaded = job.isDecoded;
+        if (isLoaded && job.upload)
+        {
+#ifdef TRACY_ENABLE
+            ZoneScopedN("Upload Asset");
+#endif
+            isLoaded = job.upload();
+        }
+        if (!isLoaded)
+        {
+            CORE_LOG_ERROR("Could not load asset {}", job.name);
+            failedNmb_.fetch_add(1, std::memory_order_release);
+        }
+        {
+            //Counted under the lock so that a thread in Wait does not miss the notification
+            std::scoped_lock lock(mutex_);
+            loadedNmb_.fetch_add(1, std::memory_order_release);
+        }
+        loadedCondition_.notify_all();
+    }
+}
+
+void AssetLoader::RunWorker()
+{
+    while (true)
+    {
+        AssetJob job;
+        {
+            std::unique_lock lock(mutex_);
+            jobCondition_.wait(lock, [this] { return isStopping_ || !pendingJobs_.empty(); });
+            if (isStopping_)
+            {
+                return;
+            }
+            job = std::move(pendingJobs_.front());
+            pendingJobs_.pop_front();
+        }
+        {
+#ifdef TRACY_ENABLE
+            ZoneScopedN("Decode Asset");
+#endif
+            job.isDecoded = job.decode();
+        }
+        {
+            std::scoped_lock lock(mutex_);
+            decodedJobs_.push_back(std::move(job));
+        }
+        decodedCondition_.notify_all();
+    }
+}
+}
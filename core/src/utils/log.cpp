@@ -1,22 +1,91 @@
 #include <utils/log.h>
+
+#include <memory>
+#include <mutex>
+
 #include "spdlog/spdlog.h"
+#include "spdlog/async.h"
+#include "spdlog/sinks/stdout_color_sinks.h"
 
 namespace core
 {
+namespace
+{
+constexpr std::size_t logQueueSize = 8192;
+
+spdlog::level::level_enum ToSpdlogLevel(LogLevel level)
+{
+    switch (level)
+    {
+    case LogLevel::DEBUG:
+        return spdlog::level::info;
+    case LogLevel::WARNING:
+        return spdlog::level::warn;
+    case LogLevel::ERR:
+        return spdlog::level::err;
+    default:
+        return spdlog::level::off;
+    }
+}
 
+/**
+ * \brief GetLogger is a function that creates the asynchronous console logger on first use and sets it as the spdlog default logger.
+ * The console I/O is done on the spdlog thread pool.
+ */
+spdlog::logger* GetLogger()
+{
+    static std::once_flag initFlag;
+    std::call_once(initFlag, []
+    {
+        spdlog::init_thread_pool(logQueueSize, 1);
+        auto logger = std::make_shared<spdlog::async_logger>("core",
+            std::make_shared<spdlog::sinks::stdout_color_sink_mt>(),
+            spdlog::thread_pool(),
+            spdlog::async_overflow_policy::overrun_oldest);
+        //The level is filtered by core::IsLogEnabled before formatting
+        logger->set_level(spdlog::level::trace);
+        spdlog::set_default_logger(std::move(logger));
+    });
+    //The default logger is null after ShutdownLog
+    return spdlog::default_logger_raw();
+}
+}
+
+void Log(LogLevel level, std::string_view msg)
+{
+    auto* logger = GetLogger();
+    if (logger != nullptr)
+    {
+        logger->log(ToSpdlogLevel(level), msg);
+    }
+}
+
+void ShutdownLog()
+{
+    spdlog::shutdown();
+}
 
 void LogDebug(const std::string_view msg)
 {
-    spdlog::info(msg);
+    if (IsLogEnabled(LogLevel::DEBUG))
+    {
+        Log(LogLevel::DEBUG, msg);
+    }
 }
 
 void LogWarning(const std::string_view msg)
 {
-    spdlog::warn(msg);
+    if (IsLogEnabled(LogLevel::WARNING))
+    {
+        Log(LogLevel::WARNING, msg);
+    }
 }
 
 void LogError(const std::string_view msg)
 {
-    spdlog::error(msg);
+    if (IsLogEnabled(LogLevel::ERR))
+    {
+        Log(LogLevel::ERR, msg);
+    }
 }
 }
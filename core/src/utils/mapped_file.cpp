@@ -0,0 +1,243 @@
+#include "utils/mapped_file.h"
+
+#include <string>
+
+#include <fmt/format.h>
+
+#include "utils/log.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace core
+{
+MappedFile::~MappedFile()
+{
+    Close();
+}
+
+#ifdef _WIN32
+bool MappedFile::Open(std::string_view path, Mode mode, std::size_t size)
+{
+    Close();
+    mode_ = mode;
+    const std::string pathStr(path);
+    file_ = CreateFileA(pathStr.c_str(),
+        mode == Mode::WRITE ? GENERIC_READ | GENERIC_WRITE : GENERIC_READ,
+        FILE_SHARE_READ,
+        nullptr,
+        mode == Mode::WRITE ? CREATE_ALWAYS : OPEN_EXISTING,
+        FILE_ATTRIBUTE_NORMAL,
+        nullptr);
+    if (file_ == INVALID_HANDLE_VALUE)
+    {
+        file_ = nullptr;
+        CORE_LOG_ERROR("Could not open mapped file: {}", path);
+        return false;
+    }
+    if (mode == Mode::WRITE)
+    {
+        if (!SetFileSize(size))
+        {
+            Close();
+            return false;
+        }
+        size_ = size;
+    }
+    else
+    {
+        LARGE_INTEGER fileSize{};
+        GetFileSizeEx(file_, &fileSize);
+        size_ = static_cast<std::size_t>(fileSize.QuadPart);
+    }
+    if (!Map())
+    {
+        Close();
+        return false;
+    }
+    return true;
+}
+
+bool MappedFile::Map()
+{
+    if (size_ == 0)
+    {
+        return false;
+    }
+    const auto size = static_cast<std::uint64_t>(size_);
+    mapping_ = CreateFileMappingA(file_, nullptr,
+        mode_ == Mode::WRITE ? PAGE_READWRITE : PAGE_READONLY,
+        static_cast<DWORD>(size >> 32u), static_cast<DWORD>(size & 0xFFFFFFFFu), nullptr);
+    if (mapping_ == nullptr)
+    {
+        CORE_LOG_ERROR("Could not create file mapping");
+        return false;
+    }
+    data_ = static_cast<std::uint8_t*>(MapViewOfFile(mapping_,
+        mode_ == Mode::WRITE ? FILE_MAP_WRITE : FILE_MAP_READ, 0, 0, size_));
+    if (data_ == nullptr)
+    {
+        CORE_LOG_ERROR("Could not map view of file");
+        return false;
+    }
+    return true;
+}
+
+void MappedFile::Unmap()
+{
+    if (data_ != nullptr)
+    {
+        UnmapViewOfFile(data_);
+        data_ = nullptr;
+    }
+    if (mapping_ != nullptr)
+    {
+        CloseHandle(mapping_);
+        mapping_ = nullptr;
+    }
+}
+
+bool MappedFile::SetFileSize(std::size_t size)
+{
+    LARGE_INTEGER fileSize{};
+    fileSize.QuadPart = static_cast<LONGLONG>(size);
+    if (!SetFilePointerEx(file_, fileSize, nullptr, FILE_BEGIN) || !SetEndOfFile(file_))
+    {
+        CORE_LOG_ERROR("Could not resize mapped file to {} bytes", size);
+        return false;
+    }
+    return true;
+}
+
+void MappedFile::Close(std::size_t finalSize)
+{
+    Unmap();
+    if (file_ != nullptr)
+    {
+        if (mode_ == Mode::WRITE)
+        {
+            SetFileSize(finalSize);
+        }
+        CloseHandle(file_);
+        file_ = nullptr;
+    }
+    size_ = 0;
+}
+#else
+bool MappedFile::Open(std::string_view path, Mode mode, std::size_t size)
+{
+    Close();
+    mode_ = mode;
+    const std::string pathStr(path);
+    file_ = mode == Mode::WRITE ?
+        open(pathStr.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644) :
+        open(pathStr.c_str(), O_RDONLY);
+    if (file_ < 0)
+    {
+        CORE_LOG_ERROR("Could not open mapped file: {}", path);
+        return false;
+    }
+    if (mode == Mode::WRITE)
+    {
+        if (!SetFileSize(size))
+        {
+            Close();
+            return false;
+        }
+        size_ = size;
+    }
+    else
+    {
+        struct stat fileStat{};
+        fstat(file_, &fileStat);
+        size_ = static_cast<std::size_t>(fileStat.st_size);
+    }
+    if (!Map())
+    {
+        Close();
+        return false;
+    }
+    return true;
+}
+
+bool MappedFile::Map()
+{
+    if (size_ == 0)
+    {
+        return false;
+    }
+    auto* data = mmap(nullptr, size_,
+        mode_ == Mode::WRITE ? PROT_READ | PROT_WRITE : PROT_READ,
+        MAP_SHARED, file_, 0);
+    if (data == MAP_FAILED)
+    {
+        CORE_LOG_ERROR("Could not map file");
+        return false;
+    }
+    data_ = static_cast<std::uint8_t*>(data);
+    return true;
+}
+
+void MappedFile::Unmap()
+{
+    if (data_ != nullptr)
+    {
+        munmap(data_, size_);
+        data_ = nullptr;
+    }
+}
+
+bool MappedFile::SetFileSize(std::size_t size)
+{
+    if (ftruncate(file_, static_cast<off_t>(size)) != 0)
+    {
+        CORE_LOG_ERROR("Could not resize mapped file to {} bytes", size);
+        return false;
+    }
+    return true;
+}
+
+void MappedFile::Close(std::size_t finalSize)
+{
+    Unmap();
+    if (file_ >= 0)
+    {
+        if (mode_ == Mode::WRITE)
+        {
+            SetFileSize(finalSize);
+        }
+        close(file_);
+        file_ = -1;
+    }
+    size_ = 0;
+}
+#endif
+
+bool MappedFile::Resize(std::size_t size)
+{
+    if (mode_ != Mode::WRITE || !IsOpen())
+    {
+        return false;
+    }
+    Unmap();
+    if (!SetFileSize(size))
+    {
+        return false;
+    }
+    size_ = size;
+    return Map();
+}
+
+void MappedFile::Close()
+{
+    Close(size_);
+}
+}
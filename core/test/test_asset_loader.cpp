@@ -0,0 +1,102 @@
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include "utils/asset_loader.h"
+
+TEST(AssetLoader, EmptyIsReady)
+{
+    core::AssetLoader assetLoader;
+    EXPECT_TRUE(assetLoader.IsReady());
+    assetLoader.Update();
+    assetLoader.Wait();
+    EXPECT_TRUE(assetLoader.IsReady());
+}
+
+TEST(AssetLoader, DecodeOnWorkerUploadOnCaller)
+{
+    const auto callerId = std::this_thread::get_id();
+    std::thread::id decodeId;
+    std::thread::id uploadId;
+    std::atomic<bool> canDecode{ false };
+    core::AssetLoader assetLoader;
+    assetLoader.Submit("asset", [&]
+    {
+        while (!canDecode)
+        {
+            std::this_thread::yield();
+        }
+        decodeId = std::this_thread::get_id();
+        return true;
+    },
+    [&]
+    {
+        uploadId = std::this_thread::get_id();
+        return true;
+    });
+    //The decoding is blocked, the gate stays closed
+    assetLoader.Update();
+    EXPECT_FALSE(assetLoader.IsReady());
+
+    canDecode = true;
+    assetLoader.Wait();
+    EXPECT_TRUE(assetLoader.IsReady());
+    EXPECT_NE(callerId, decodeId);
+    EXPECT_EQ(callerId, uploadId);
+    EXPECT_EQ(0u, assetLoader.GetFailedNmb());
+}
+
+TEST(AssetLoader, UpdateUploadsWithoutWaiting)
+{
+    int uploadNmb = 0;
+    core::AssetLoader assetLoader;
+    for (int i = 0; i < 4; i++)
+    {
+        assetLoader.Submit("asset", [] { return true; }, [&uploadNmb] { uploadNmb++; return true; });
+    }
+    while (!assetLoader.IsReady())
+    {
+        assetLoader.Update();
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    EXPECT_EQ(4, uploadNmb);
+}
+
+TEST(AssetLoader, FailedAssets)
+{
+    bool isUploaded = false;
+    core::AssetLoader assetLoader;
+    assetLoader.Submit("decode failure", [] { return false; }, [&isUploaded] { isUploaded = true; return true; });
+    assetLoader.Submit("upload failure", [] { return true; }, [] { return false; });
+    assetLoader.Submit("no upload", [] { return true; });
+    assetLoader.Wait();
+    EXPECT_TRUE(assetLoader.IsReady());
+    EXPECT_FALSE(isUploaded);
+    EXPECT_EQ(2u, assetLoader.GetFailedNmb());
+}
+
+TEST(AssetLoader, WaitForTheUploadThread)
+{
+    const auto uploadThreadId = std::this_thread::get_id();
+    std::thread::id uploadId;
+    core::AssetLoader assetLoader;
+    assetLoader.Submit("asset", [] { return true; }, [&uploadId] { uploadId = std::this_thread::get_id(); return true; });
+    std::atomic<bool> isWaiting{ true };
+    //Like the simulation thread of the render thread mode, waiting for the render thread uploads
+    std::thread simulationThread([&assetLoader, &isWaiting]
+    {
+        EXPECT_FALSE(assetLoader.IsUploadThread());
+        assetLoader.Wait();
+        isWaiting = false;
+    });
+    while (isWaiting)
+    {
+        assetLoader.Update();
+        std::this_thread::yield();
+    }
+    simulationThread.join();
+    EXPECT_TRUE(assetLoader.IsReady());
+    EXPECT_EQ(uploadThreadId, uploadId);
+}
@@ -77,4 +77,20 @@ TEST(Component, InternalArrayOverflow)
     const auto entity = entityManager.CreateEntity();
     componentManager.AddComponent(entity);
     EXPECT_LT(core::entityInitNmb, componentManager.GetAllComponents().size());
-}
\ No newline at end of file
+}
+TEST(Component, UncheckedAccessors)
+{
+    constexpr int newValue = 45;
+    core::EntityManager entityManager;
+    SimpleComponentManager componentManager(entityManager);
+
+    const auto entity = entityManager.CreateEntity();
+    componentManager.AddComponent(entity);
+    EXPECT_TRUE(entityManager.HasComponentUnchecked(entity, componentType));
+    componentManager.SetComponentUnchecked(entity, newValue);
+    EXPECT_EQ(newValue, componentManager.GetComponent(entity));
+    const auto& immutableComponentManager = componentManager;
+    EXPECT_EQ(newValue, immutableComponentManager.GetComponentUnchecked(entity));
+    componentManager.RemoveComponent(entity);
+    EXPECT_FALSE(entityManager.HasComponentUnchecked(entity, componentType));
+}
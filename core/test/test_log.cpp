@@ -0,0 +1,36 @@
+#include <gtest/gtest.h>
+
+#include "utils/log.h"
+
+namespace
+{
+int CountFormat(int& formatNmb)
+{
+    formatNmb++;
+    return formatNmb;
+}
+}
+
+TEST(Log, RuntimeLevel)
+{
+    core::SetLogLevel(core::LogLevel::WARNING);
+    EXPECT_FALSE(core::IsLogEnabled(core::LogLevel::DEBUG));
+    EXPECT_TRUE(core::IsLogEnabled(core::LogLevel::WARNING));
+    EXPECT_TRUE(core::IsLogEnabled(core::LogLevel::ERR));
+    core::SetLogLevel(core::LogLevel::OFF);
+    EXPECT_FALSE(core::IsLogEnabled(core::LogLevel::ERR));
+    core::SetLogLevel(core::LogLevel::DEBUG);
+    EXPECT_TRUE(core::IsLogEnabled(core::LogLevel::DEBUG));
+}
+
+TEST(Log, DisabledLevelSkipsArguments)
+{
+    int formatNmb = 0;
+    core::SetLogLevel(core::LogLevel::ERR);
+    CORE_LOG_DEBUG("Debug {}", CountFormat(formatNmb));
+    CORE_LOG_WARNING("Warning {}", CountFormat(formatNmb));
+    EXPECT_EQ(0, formatNmb);
+    CORE_LOG_ERROR("Error {}", CountFormat(formatNmb));
+    EXPECT_EQ(1, formatNmb);
+    core::SetLogLevel(core::LogLevel::DEBUG);
+}
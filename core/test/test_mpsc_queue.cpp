@@ -0,0 +1,91 @@
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "utils/mpsc_queue.h"
+
+struct TestRecord
+{
+    std::uint32_t producer = 0;
+    std::uint32_t index = 0;
+};
+
+TEST(MpscQueue, PushPopOrder)
+{
+    core::MpscQueue<int, 8> queue;
+    for (int i = 0; i < 5; i++)
+    {
+        EXPECT_TRUE(queue.TryPush(i));
+    }
+    EXPECT_EQ(5u, queue.GetSizeApprox());
+    for (int i = 0; i < 5; i++)
+    {
+        int value = -1;
+        EXPECT_TRUE(queue.TryPop(value));
+        EXPECT_EQ(i, value);
+    }
+    int value = -1;
+    EXPECT_FALSE(queue.TryPop(value));
+    EXPECT_EQ(0u, queue.GetSizeApprox());
+}
+
+TEST(MpscQueue, OverflowDropsAndCounts)
+{
+    core::MpscQueue<int, 4> queue;
+    for (int i = 0; i < 6; i++)
+    {
+        queue.TryPush(i);
+    }
+    EXPECT_EQ(2u, queue.GetDroppedNmb());
+    std::vector<int> values;
+    EXPECT_EQ(4u, queue.PopBatch(std::back_inserter(values)));
+    EXPECT_EQ((std::vector<int>{ 0, 1, 2, 3 }), values);
+    //The ring is usable again once the consumer released the cells
+    EXPECT_TRUE(queue.TryPush(6));
+    int value = -1;
+    EXPECT_TRUE(queue.TryPop(value));
+    EXPECT_EQ(6, value);
+}
+
+TEST(MpscQueue, MultipleProducers)
+{
+    constexpr std::uint32_t producerNmb = 4;
+    constexpr std::uint32_t recordNmb = 20'000;
+    core::MpscQueue<TestRecord, 1024> queue;
+    std::vector<std::thread> producers;
+    for (std::uint32_t producer = 0; producer < producerNmb; producer++)
+    {
+        producers.emplace_back([&queue, producer]()
+            {
+                for (std::uint32_t i = 0; i < recordNmb; i++)
+                {
+                    while (!queue.TryPush({ producer, i }))
+                    {
+                        std::this_thread::yield();
+                    }
+                }
+            });
+    }
+    std::vector<std::uint32_t> nextIndices(producerNmb, 0);
+    std::uint32_t poppedNmb = 0;
+    while (poppedNmb < producerNmb * recordNmb)
+    {
+        TestRecord record;
+        if (!queue.TryPop(record))
+        {
+            std::this_thread::yield();
+            continue;
+        }
+        //Records of one producer keep their order
+        EXPECT_EQ(nextIndices[record.producer], record.index);
+        nextIndices[record.producer] = record.index + 1;
+        poppedNmb++;
+    }
+    for (auto& producer : producers)
+    {
+        producer.join();
+    }
+    EXPECT_TRUE(std::all_of(nextIndices.begin(), nextIndices.end(), [](std::uint32_t index) { return index == recordNmb; }));
+}
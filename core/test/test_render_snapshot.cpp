@@ -0,0 +1,28 @@
+#include <array>
+
+#include <gtest/gtest.h>
+
+#include "graphics/render_snapshot.h"
+
+TEST(RenderSnapshot, MergeSameTexture)
+{
+    core::RenderSnapshot snapshot;
+    const sf::Texture texture1;
+    const sf::Texture texture2;
+    const std::array<sf::Vertex, 6> quad{};
+    snapshot.AddVertices(quad, sf::Triangles, &texture1);
+    snapshot.AddVertices(quad, sf::Triangles, &texture1);
+    EXPECT_EQ(1u, snapshot.GetCommandNmb());
+    snapshot.AddVertices(quad, sf::Triangles, &texture2);
+    snapshot.AddVertices(quad, sf::TriangleStrip, &texture2);
+    snapshot.AddVertices(quad, sf::TriangleStrip, &texture2);
+    EXPECT_EQ(4u, snapshot.GetCommandNmb());
+    snapshot.SetView(sf::View());
+    snapshot.AddVertices(quad, sf::Triangles, &texture2);
+    EXPECT_EQ(6u, snapshot.GetCommandNmb());
+
+    snapshot.Clear();
+    EXPECT_EQ(0u, snapshot.GetCommandNmb());
+    snapshot.AddVertices({}, sf::Triangles, &texture1);
+    EXPECT_EQ(0u, snapshot.GetCommandNmb());
+}
@@ -0,0 +1,111 @@
+#include <array>
+#include <span>
+
+#include <gtest/gtest.h>
+
+#include "engine/transform.h"
+#include "graphics/render_snapshot.h"
+#include "graphics/sprite.h"
+
+class BatchedSpriteManager : public core::SpriteManager
+{
+public:
+    using SpriteManager::SpriteManager;
+    [[nodiscard]] std::span<const sf::Vertex> GetVertices() const { return vertices_; }
+};
+
+namespace
+{
+constexpr std::size_t spriteVertexNmb = 6;
+//The sprites are told apart by their red channel
+constexpr std::array<std::uint8_t, 4> spriteIds{ 10, 20, 30, 40 };
+
+std::vector<std::uint8_t> GetDrawnIds(const BatchedSpriteManager& spriteManager)
+{
+    std::vector<std::uint8_t> drawnIds;
+    const auto vertices = spriteManager.GetVertices();
+    for (std::size_t i = 0; i < vertices.size(); i += spriteVertexNmb)
+    {
+        drawnIds.push_back(vertices[i].color.r);
+    }
+    return drawnIds;
+}
+}
+
+TEST(Sprite, BatchByTexture)
+{
+    core::EntityManager entityManager;
+    core::TransformManager transformManager(entityManager);
+    BatchedSpriteManager spriteManager(entityManager, transformManager);
+    const sf::Texture texture1;
+    const sf::Texture texture2;
+    const std::array<const sf::Texture*, 4> textures{ &texture1, &texture1, &texture2, &texture1 };
+    std::array<core::Entity, 4> entities{};
+    for (std::size_t i = 0; i < entities.size(); i++)
+    {
+        entities[i] = entityManager.CreateEntity();
+        spriteManager.AddComponent(entities[i]);
+        spriteManager.SetTexture(entities[i], *textures[i], sf::IntRect(0, 0, 8, 8));
+        spriteManager.SetColor(entities[i], sf::Color(spriteIds[i], 0, 0));
+    }
+    //A sprite without texture is not drawn
+    spriteManager.AddComponent(entityManager.CreateEntity());
+
+    core::RenderSnapshot snapshot;
+    spriteManager.RecordDraw(snapshot);
+    //The consecutive sprites with the first texture share a batch, the last one is split by the second texture
+    EXPECT_EQ(3u, spriteManager.GetBatchNmb());
+    EXPECT_EQ(3u, snapshot.GetCommandNmb());
+    EXPECT_EQ(std::vector<std::uint8_t>(spriteIds.begin(), spriteIds.end()), GetDrawnIds(spriteManager));
+}
+
+TEST(Sprite, LayerOrder)
+{
+    core::EntityManager entityManager;
+    core::TransformManager transformManager(entityManager);
+    BatchedSpriteManager spriteManager(entityManager, transformManager);
+    const sf::Texture texture1;
+    const sf::Texture texture2;
+    const std::array<const sf::Texture*, 4> textures{ &texture1, &texture1, &texture2, &texture1 };
+    std::array<core::Entity, 4> entities{};
+    for (std::size_t i = 0; i < entities.size(); i++)
+    {
+        entities[i] = entityManager.CreateEntity();
+        spriteManager.AddComponent(entities[i]);
+        spriteManager.SetTexture(entities[i], *textures[i], sf::IntRect(0, 0, 8, 8));
+        spriteManager.SetColor(entities[i], sf::Color(spriteIds[i], 0, 0));
+    }
+    spriteManager.SetLayer(entities[0], 2);
+    spriteManager.SetLayer(entities[2], 1);
+
+    core::RenderSnapshot snapshot;
+    spriteManager.RecordDraw(snapshot);
+    //The greater layers are drawn last, the same layer keeps the entity order
+    const std::vector<std::uint8_t> expectedIds{ spriteIds[1], spriteIds[3], spriteIds[2], spriteIds[0] };
+    EXPECT_EQ(expectedIds, GetDrawnIds(spriteManager));
+    EXPECT_EQ(3u, spriteManager.GetBatchNmb());
+    EXPECT_EQ(3u, snapshot.GetCommandNmb());
+}
+
+TEST(Sprite, FlippedTextureRect)
+{
+    core::EntityManager entityManager;
+    core::TransformManager transformManager(entityManager);
+    BatchedSpriteManager spriteManager(entityManager, transformManager);
+    const sf::Texture texture;
+    const auto entity = entityManager.CreateEntity();
+    spriteManager.AddComponent(entity);
+    //A negative width mirrors the image horizontally, the quad keeps a positive size
+    spriteManager.SetTexture(entity, texture, sf::IntRect(10, 20, -8, 4));
+
+    core::RenderSnapshot snapshot;
+    spriteManager.RecordDraw(snapshot);
+    const auto vertices = spriteManager.GetVertices();
+    ASSERT_EQ(spriteVertexNmb, vertices.size());
+    //The first triangle is the top left, bottom left and top right corners
+    EXPECT_EQ(sf::Vector2f(10.0f, 20.0f), vertices[0].texCoords);
+    EXPECT_EQ(sf::Vector2f(10.0f, 24.0f), vertices[1].texCoords);
+    EXPECT_EQ(sf::Vector2f(2.0f, 20.0f), vertices[2].texCoords);
+    EXPECT_FLOAT_EQ(8.0f, vertices[2].position.x - vertices[0].position.x);
+    EXPECT_FLOAT_EQ(4.0f, vertices[1].position.y - vertices[0].position.y);
+}
@@ -0,0 +1,65 @@
+#include <array>
+#include <cstdio>
+
+#include <gtest/gtest.h>
+
+#include "graphics/texture_atlas.h"
+
+TEST(TextureAtlas, PackAtlasRects)
+{
+    constexpr unsigned padding = 2;
+    const std::array<sf::Vector2u, 5> sizes
+    { {
+        { 64, 64 },
+        { 128, 16 },
+        { 16, 128 },
+        { 32, 32 },
+        { 256, 8 },
+    } };
+    sf::Vector2u atlasSize;
+    const auto rects = core::PackAtlasRects(sizes, padding, atlasSize);
+    ASSERT_EQ(sizes.size(), rects.size());
+    EXPECT_EQ(0u, atlasSize.x & (atlasSize.x - 1u));
+    for (std::size_t i = 0; i < rects.size(); i++)
+    {
+        EXPECT_EQ(static_cast<int>(sizes[i].x), rects[i].width);
+        EXPECT_EQ(static_cast<int>(sizes[i].y), rects[i].height);
+        EXPECT_LE(0, rects[i].left);
+        EXPECT_LE(0, rects[i].top);
+        EXPECT_LE(rects[i].left + rects[i].width, static_cast<int>(atlasSize.x));
+        EXPECT_LE(rects[i].top + rects[i].height, static_cast<int>(atlasSize.y));
+        for (std::size_t j = i + 1; j < rects.size(); j++)
+        {
+            //Padded rectangles do not overlap
+            const bool isSeparated =
+                rects[i].left + rects[i].width + static_cast<int>(padding) <= rects[j].left ||
+                rects[j].left + rects[j].width + static_cast<int>(padding) <= rects[i].left ||
+                rects[i].top + rects[i].height + static_cast<int>(padding) <= rects[j].top ||
+                rects[j].top + rects[j].height + static_cast<int>(padding) <= rects[i].top;
+            EXPECT_TRUE(isSeparated);
+        }
+    }
+}
+
+TEST(TextureAtlas, TableRoundTrip)
+{
+    const std::array<core::AtlasRegion, 2> regions
+    { {
+        { "ball", sf::IntRect(0, 0, 32, 32) },
+        { "healthbarBackground", sf::IntRect(34, 0, 200, 20) },
+    } };
+    const std::string path = "test_atlas_table.txt";
+    ASSERT_TRUE(core::TextureAtlas::WriteTable(path, regions));
+    std::vector<core::AtlasRegion> readRegions;
+    ASSERT_TRUE(core::TextureAtlas::ReadTable(path, readRegions));
+    ASSERT_EQ(regions.size(), readRegions.size());
+    for (std::size_t i = 0; i < regions.size(); i++)
+    {
+        EXPECT_EQ(regions[i].name, readRegions[i].name);
+        EXPECT_EQ(regions[i].rect.left, readRegions[i].rect.left);
+        EXPECT_EQ(regions[i].rect.top, readRegions[i].rect.top);
+        EXPECT_EQ(regions[i].rect.width, readRegions[i].rect.width);
+        EXPECT_EQ(regions[i].rect.height, readRegions[i].rect.height);
+    }
+    std::remove(path.c_str());
+}
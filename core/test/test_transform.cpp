@@ -0,0 +1,31 @@
+#include <gtest/gtest.h>
+
+#include "engine/transform.h"
+
+TEST(Transform, ChangeTracking)
+{
+    core::EntityManager entityManager;
+    core::TransformManager transformManager(entityManager);
+    transformManager.SetChangeTracking(true);
+    const auto entity1 = entityManager.CreateEntity();
+    const auto entity2 = entityManager.CreateEntity();
+    transformManager.AddComponent(entity1);
+    transformManager.AddComponent(entity2);
+    EXPECT_EQ(2u, transformManager.GetChangedEntities().size());
+    EXPECT_TRUE(transformManager.GetChanges(entity1) & static_cast<std::uint8_t>(core::TransformChange::ADDED));
+    transformManager.ClearChanges();
+    EXPECT_TRUE(transformManager.GetChangedEntities().empty());
+    EXPECT_EQ(0u, transformManager.GetChanges(entity1));
+
+    //Setting the same value is not a change
+    transformManager.SetPosition(entity1, transformManager.GetPosition(entity1));
+    transformManager.SetScale(entity2, transformManager.GetScale(entity2));
+    EXPECT_TRUE(transformManager.GetChangedEntities().empty());
+
+    transformManager.SetPosition(entity2, core::Vec2f(1.0f, 2.0f));
+    transformManager.SetRotation(entity2, core::Degree(45.0f));
+    ASSERT_EQ(1u, transformManager.GetChangedEntities().size());
+    EXPECT_EQ(entity2, transformManager.GetChangedEntities()[0]);
+    EXPECT_EQ(static_cast<std::uint8_t>(core::TransformChange::POSITION) | static_cast<std::uint8_t>(core::TransformChange::ROTATION),
+        transformManager.GetChanges(entity2));
+}
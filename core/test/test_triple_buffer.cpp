@@ -0,0 +1,68 @@
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "utils/triple_buffer.h"
+
+TEST(TripleBuffer, ConsumeLatest)
+{
+    core::TripleBuffer<int> buffer;
+    EXPECT_FALSE(buffer.Consume());
+    for (int i = 1; i <= 3; i++)
+    {
+        buffer.GetWriteBuffer() = i;
+        buffer.Publish();
+    }
+    EXPECT_TRUE(buffer.Consume());
+    EXPECT_EQ(3, buffer.GetReadBuffer());
+    EXPECT_FALSE(buffer.Consume());
+    EXPECT_EQ(3, buffer.GetReadBuffer());
+
+    buffer.GetWriteBuffer() = 4;
+    buffer.Publish();
+    EXPECT_TRUE(buffer.Consume());
+    EXPECT_EQ(4, buffer.GetReadBuffer());
+}
+
+TEST(TripleBuffer, ConcurrentSnapshotsAreWhole)
+{
+    constexpr int snapshotNmb = 20000;
+    constexpr std::size_t snapshotSize = 64;
+    core::TripleBuffer<std::vector<int>> buffer;
+    std::atomic<bool> isDone{ false };
+    std::thread producer([&buffer, &isDone]
+    {
+        for (int i = 1; i <= snapshotNmb; i++)
+        {
+            auto& snapshot = buffer.GetWriteBuffer();
+            snapshot.assign(snapshotSize, i);
+            buffer.Publish();
+        }
+        isDone.store(true, std::memory_order_release);
+    });
+    int lastValue = 0;
+    bool isTorn = false;
+    bool isOlder = false;
+    while (lastValue != snapshotNmb)
+    {
+        const bool wasDone = isDone.load(std::memory_order_acquire);
+        if (!buffer.Consume())
+        {
+            if (wasDone)
+                break;
+            continue;
+        }
+        const auto& snapshot = buffer.GetReadBuffer();
+        ASSERT_EQ(snapshotSize, snapshot.size());
+        isTorn = isTorn || std::any_of(snapshot.begin(), snapshot.end(), [&snapshot](int value) { return value != snapshot.front(); });
+        isOlder = isOlder || snapshot.front() <= lastValue;
+        lastValue = snapshot.front();
+    }
+    producer.join();
+    EXPECT_FALSE(isTorn);
+    EXPECT_FALSE(isOlder);
+    EXPECT_EQ(snapshotNmb, lastValue);
+}
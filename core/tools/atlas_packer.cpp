@@ -0,0 +1,37 @@
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "graphics/texture_atlas.h"
+
+/**
+ * AtlasPacker packs images into one atlas image and writes the region table read by core::TextureAtlas.
+ * It is run at build time by add_texture_atlas in cmake/data.cmake.
+ * Usage: atlas_packer <atlas image> <atlas table> <images...>
+ */
+int main(int argc, char** argv)
+{
+    if (argc < 4)
+    {
+        std::cerr << "Usage: atlas_packer <atlas image> <atlas table> <images...>\n";
+        return EXIT_FAILURE;
+    }
+    const std::vector<std::string> imagePaths(argv + 3, argv + argc);
+    sf::Image atlasImage;
+    std::vector<core::AtlasRegion> regions;
+    if (!core::TextureAtlas::PackImages(imagePaths, atlasImage, regions))
+    {
+        return EXIT_FAILURE;
+    }
+    if (!atlasImage.saveToFile(argv[1]))
+    {
+        std::cerr << "Could not write atlas image " << argv[1] << '\n';
+        return EXIT_FAILURE;
+    }
+    if (!core::TextureAtlas::WriteTable(argv[2], regions))
+    {
+        return EXIT_FAILURE;
+    }
+    std::cout << "Packed " << regions.size() << " images in " << atlasImage.getSize().x << 'x' << atlasImage.getSize().y << '\n';
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,144 @@
+/**
+ * \file desync_check.h
+ */
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <fstream>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "game/ball_manager.h"
+#include "game/game_globals.h"
+#include "game/physics_manager.h"
+#include "game/player_character.h"
+#include "game/replay.h"
+
+namespace game
+{
+/**
+ * \brief DesyncBlock is a component of a rollback relevant entity whose fields are hashed every validated frame.
+ */
+enum class DesyncBlock : std::uint8_t
+{
+    PLAYER_BODY,
+    PLAYER_CHARACTER,
+    BALL_BODY,
+    BALL,
+};
+
+/**
+ * \brief DesyncField describes one field of a DesyncBlock.
+ */
+struct DesyncField
+{
+    std::string_view name;
+    bool isFloat = true;
+};
+
+constexpr std::size_t maxDesyncFieldNmb = 6;
+
+/**
+ * \brief DesyncBlockState is the bit exact value of the fields of one component and their hash.
+ * Floats are kept as their bit pattern, integers are zero-extended.
+ */
+struct DesyncBlockState
+{
+    std::uint64_t hash = 0;
+    std::array<std::uint32_t, maxDesyncFieldNmb> fields{};
+    DesyncBlock block = DesyncBlock::PLAYER_BODY;
+    /**
+     * \brief key is the player number for the players and the index in entity order for the balls, as entities differ between the server and the clients
+     */
+    std::uint8_t key = 0;
+};
+
+/**
+ * \brief DesyncFrameState is the state of the rollback relevant components after a validated frame was simulated.
+ */
+struct DesyncFrameState
+{
+    Frame frame = 0;
+    ReplayFrameInputs inputs{};
+    std::vector<DesyncBlockState> blocks;
+
+    [[nodiscard]] std::uint64_t GetHash() const;
+};
+
+[[nodiscard]] std::span<const DesyncField> GetDesyncFields(DesyncBlock block);
+/**
+ * \brief GetDesyncBlockName is a function that returns a readable name of the component, like "P1 Body" or "Ball 0 Ball".
+ */
+[[nodiscard]] std::string GetDesyncBlockName(const DesyncBlockState& blockState);
+[[nodiscard]] std::string FormatDesyncField(const DesyncField& field, std::uint32_t value);
+[[nodiscard]] DesyncBlockState HashBody(DesyncBlock block, std::uint8_t key, const Body& body);
+[[nodiscard]] DesyncBlockState HashPlayerCharacter(std::uint8_t key, const PlayerCharacter& playerCharacter);
+[[nodiscard]] DesyncBlockState HashBall(std::uint8_t key, const Ball& ball);
+
+/**
+ * \brief DesyncLogHeader is the fixed header at the start of a desync log file.
+ */
+struct DesyncLogHeader
+{
+    static constexpr std::array<char, 8> desyncLogMagic{ 'G', 'P', 'R', 'D', 'S', 'Y', 'N', 'C' };
+    static constexpr std::uint32_t desyncLogVersion = 1;
+
+    std::array<char, 8> magic = desyncLogMagic;
+    std::uint32_t version = desyncLogVersion;
+    std::uint32_t playerNmb = maxPlayerNmb;
+};
+
+/**
+ * \brief DesyncFrameHeader is written in front of the DesyncBlockState of each frame of a desync log.
+ */
+struct DesyncFrameHeader
+{
+    Frame frame = 0;
+    std::uint32_t blockNmb = 0;
+    ReplayFrameInputs inputs{};
+};
+
+/**
+ * \brief DesyncChecker is a class that keeps the DesyncFrameState of the validated frames over the rollback window
+ * and appends them to a desync log compared offline by the desync_bisect tool.
+ */
+class DesyncChecker
+{
+public:
+    bool OpenLog(std::string_view path);
+    void CloseLog();
+    void RecordFrame(DesyncFrameState frameState);
+    /**
+     * \brief GetFrameState is a method that returns the state of a validated frame still in the rollback window, or nullptr.
+     */
+    [[nodiscard]] const DesyncFrameState* GetFrameState(Frame frame) const;
+    /**
+     * \brief DumpMismatch is a method that logs the inputs and hashes of the frames validated since the last confirmed one,
+     * with the fields of the first component that did not match the server.
+     * \param mismatchPlayer is the first player whose physics state did not match the server
+     */
+    void DumpMismatch(Frame lastConfirmedFrame, Frame validateFrame, PlayerNumber mismatchPlayer);
+private:
+    std::array<DesyncFrameState, windowBufferSize> window_{};
+    std::ofstream log_;
+};
+
+/**
+ * \brief DesyncLogReader is a class that reads the frames of a desync log in the order they were written.
+ */
+class DesyncLogReader
+{
+public:
+    bool Open(std::string_view path);
+    /**
+     * \brief ReadNext is a method that returns the next frame, or nothing at the end of the file or at a truncated frame.
+     */
+    std::optional<DesyncFrameState> ReadNext();
+private:
+    std::ifstream file_;
+};
+}
@@ -86,11 +86,40 @@ constexpr float ballRightRespawnX = 8.5f;
  * \brief windowBufferSize is the size of input stored by a client. 5 seconds of frame at 50 fps
  */
 constexpr std::size_t windowBufferSize = 5u * 50u;
+/**
+ * \brief replayKeyframePeriod is the minimum number of validated frames between two world snapshots of a replay.
+ * Seeking in a replay simulates about this number of frames from the closest snapshot.
+ */
+constexpr Frame replayKeyframePeriod = 2u * 50u;
 
 /**
  * \brief startDelay is the delay to wait before starting a game in milliseconds
  */
 constexpr long long startDelay = 3000;
+/**
+ * \brief clockSyncSampleNmb is the number of ping samples kept by the clients to estimate the server clock offset
+ */
+constexpr std::size_t clockSyncSampleNmb = 8;
+/**
+ * \brief clockSyncBestSampleNmb is the number of samples with the smallest RTT averaged to estimate the server clock offset
+ */
+constexpr std::size_t clockSyncBestSampleNmb = 3;
+/**
+ * \brief clockSyncMinSampleNmb is the number of samples needed before the server clock offset is trusted
+ */
+constexpr std::size_t clockSyncMinSampleNmb = 4;
+/**
+ * \brief clockSyncPingPeriod is the period in seconds used to send ping packets while the clock is not synchronized
+ */
+constexpr float clockSyncPingPeriod = 0.05f;
+/**
+ * \brief packetStatsRatePeriod is the window in seconds used to compute the packet and byte rates
+ */
+constexpr float packetStatsRatePeriod = 1.0f;
+/**
+ * \brief packetStatsDumpPeriod is the period in seconds used to append the packet stats to their dump file
+ */
+constexpr float packetStatsDumpPeriod = 5.0f;
 /**
  * \brief maxInputNmb is the number of inputs stored into an PlayerInputPacket
  */
@@ -99,6 +128,22 @@ constexpr std::size_t maxInputNmb = 50;
  * \brief fixedPeriod is the period used in seconds to start a new FixedUpdate method in the game::GameManager
  */
 constexpr float fixedPeriod = 0.02f; //50fps
+/**
+ * \brief frameAdvantageTolerance is the number of frames a client can be ahead of the other players before it slows down its fixed update
+ */
+constexpr float frameAdvantageTolerance = 1.0f;
+/**
+ * \brief frameAdvantageSmoothing is the ratio used by the exponential moving average of the frame advantage
+ */
+constexpr float frameAdvantageSmoothing = 0.1f;
+/**
+ * \brief fixedPeriodStretchPerFrame is the ratio added to the fixedPeriod for each frame of advantage above the tolerance
+ */
+constexpr float fixedPeriodStretchPerFrame = 0.02f;
+/**
+ * \brief maxFixedPeriodStretch is the maximum ratio added to the fixedPeriod when a client is ahead of the other players
+ */
+constexpr float maxFixedPeriodStretch = 0.1f;
 
 
 constexpr std::array<core::Color, std::max(4u, maxPlayerNmb)> playerColors
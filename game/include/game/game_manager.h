@@ -4,13 +4,21 @@
 #include <SFML/Graphics/View.hpp>
 #include <SFML/System/Time.hpp>
 #include <SFML/System/Vector2.hpp>
-#include <SFML/Graphics/Text.hpp>
+
+#include <atomic>
+#include <span>
+#include <string>
+#include <string_view>
 
 #include "game_globals.h"
+#include "replay.h"
 #include "rollback_manager.h"
 #include "engine/entity.h"
 #include "graphics/graphics.h"
+#include "graphics/cached_text.h"
 #include "graphics/sprite.h"
+#include "graphics/texture_atlas.h"
+#include "utils/asset_loader.h"
 #include "engine/system.h"
 #include "engine/transform.h"
 #include "network/packet_type.h"
@@ -26,7 +34,11 @@ class PacketSenderInterface;
 class GameManager
 {
 public:
-    GameManager();
+    /**
+     * \brief GameManager constructor
+     * \param rollbackMode is RollbackMode::AUTHORITATIVE on the server, which only simulates validated frames
+     */
+    explicit GameManager(RollbackMode rollbackMode = RollbackMode::ROLLBACK);
     virtual ~GameManager() = default;
     virtual void SpawnPlayer(PlayerNumber playerNumber, core::Vec2f position);
     virtual core::Entity SpawnBall(core::Vec2f position, core::Vec2f velocity);
@@ -40,10 +52,10 @@ public:
      * \brief SpawnVisualizer is a method that spawns entity whose goal is to act as a visualizer for another entity
      * It needs to be used when the other entity transform mismatches with its box collider
      * \param position is where the visualizer will be spawned
-     * \param texture is the texture of the entity
+     * \param textureRect is the region of the texture atlas of the entity
      * \param color is color of the entity
      */
-    core::Entity SpawnVisualizer(core::Vec2f position, [[maybe_unused]] sf::Texture& texture, [[maybe_unused]] sf::Color color);
+    core::Entity SpawnVisualizer(core::Vec2f position, [[maybe_unused]] const sf::IntRect& textureRect, [[maybe_unused]] sf::Color color);
 
     [[nodiscard]] core::Entity GetEntityFromPlayerNumber(PlayerNumber playerNumber) const;
     [[nodiscard]] Frame GetCurrentFrame() const { return currentFrame_; }
@@ -57,6 +69,12 @@ public:
     void Validate(Frame newValidateFrame);
     [[nodiscard]] PlayerNumber CheckWinner() const;
     virtual void WinGame(PlayerNumber winner);
+#ifdef ENABLE_DESYNC_CHECK
+    /**
+     * \brief StartDesyncLog is a method that writes the hashed components of every validated frame, compared offline by desync_bisect.
+     */
+    void StartDesyncLog(std::string_view path) { rollbackManager_.GetDesyncChecker().OpenLog(path); }
+#endif
 
 
 protected:
@@ -74,7 +92,8 @@ private:
  * \brief ClientGameManager is a class that inherits from GameManager by adding the visual part and specific implementations needed by the clients.
  */
 class ClientGameManager final : public GameManager,
-                                public core::DrawInterface, public core::DrawImGuiInterface, public core::SystemInterface
+                                public core::DrawInterface, public core::DrawImGuiInterface, public core::SystemInterface,
+                                public core::RecordDrawInterface
 
 {
 public:
@@ -84,13 +103,34 @@ public:
         FINISHED = 1u << 1u,
     };
     explicit ClientGameManager(PacketSenderInterface& packetSenderInterface);
-    void StartGame(unsigned long long int startingTime);
+    /**
+     * \brief StartGame is a method that sets the time when the game will start.
+     * It can be called several times before the start, when the clock offset estimation is refined.
+     * \param startingTime is the starting time in the local clock (see GetNetworkTime)
+     */
+    void StartGame(NetworkTime startingTime);
     void Begin() override;
     void Update(sf::Time dt) override;
+    /**
+     * \brief UpdateWorldVisuals is a method that simulates the current world from the validated one and copies it to the sprites.
+     * It is called by Update once the game started.
+     * \param interpolation is the fraction of the fixed period elapsed since the current frame,
+     * the sprites are drawn between the previous and the current simulated frames (1 draws the current frame)
+     */
+    void UpdateWorldVisuals(float interpolation = 1.0f);
     void End() override;
     void SetWindowSize(sf::Vector2u windowsSize);
     [[nodiscard]] sf::Vector2u GetWindowSize() const { return windowSize_; }
     void Draw(sf::RenderTarget& target) override;
+    /**
+     * \brief RecordDraw is a method that copies what Draw would draw in the snapshot, for the Engine render thread mode.
+     */
+    void RecordDraw(core::RenderSnapshot& snapshot) override;
+    /**
+     * \brief UploadResources is a method that uploads the assets loaded since the last call, it needs to be called by the thread owning the OpenGL context.
+     * Draw calls it, in the Engine render thread mode it is called by the render thread.
+     */
+    void UploadResources() override;
     void SetClientPlayer(PlayerNumber clientPlayer);
 
     /**
@@ -138,18 +178,98 @@ public:
     * \brief VisualizeEntity is a method that give visuals to an entity.
     * It's used for entities having a mismatch between their transform and their box collider 
     * \param entity is the entity to visualize
-    * \param texture is the texture of the entity
+    * \param textureRect is the region of the texture atlas of the entity
     * \param color is the color of the entity
     */
-    void VisualizeEntity(const core::Entity& entity, const sf::Texture& texture, sf::Color color);
+    void VisualizeEntity(const core::Entity& entity, const sf::IntRect& textureRect, sf::Color color);
     void FixedUpdate();
     void SetPlayerInput(PlayerNumber playerNumber, PlayerInput playerInput, std::uint32_t inputFrame) override;
     void DrawImGui() override;
+    /**
+     * \brief ConfirmValidateFrame is a method called when receiving a ValidateFramePacket.
+     * When the validated world does not match the server checksums, a ResyncRequestPacket is sent to the server.
+     */
     void ConfirmValidateFrame(Frame newValidateFrame, const std::array<PhysicsState, maxPlayerNmb>& physicsStates);
+    /**
+     * \brief ApplyWorldSnapshot is a method called when receiving a WorldSnapshotPacket after a resync request.
+     * If the snapshot cannot be applied, the desynchronization is fatal and no other snapshot is requested.
+     * \param validateFrame is the server validated frame of the snapshot
+     * \param snapshot is the serialized validated world of the server
+     */
+    void ApplyWorldSnapshot(Frame validateFrame, const std::vector<std::uint8_t>& snapshot);
+    [[nodiscard]] bool IsResyncPending() const { return resyncPending_; }
+    [[nodiscard]] bool IsDesyncFatal() const { return isDesyncFatal_; }
+    /**
+     * \brief GetDesyncCount is a method that returns the number of validated frames whose checksums did not match the server ones.
+     */
+    [[nodiscard]] std::uint32_t GetDesyncCount() const { return desyncCount_; }
+    [[nodiscard]] std::uint32_t GetResyncCount() const { return resyncCount_; }
+    /**
+     * \brief SetHeadless is a method that skips the loading of the textures and fonts, used when the game is simulated without window.
+     * It needs to be called before Begin.
+     */
+    void SetHeadless(bool isHeadless) { isHeadless_ = isHeadless; }
     [[nodiscard]] PlayerNumber GetPlayerNumber() const { return clientPlayer_; }
     void WinGame(PlayerNumber winner) override;
     [[nodiscard]] std::uint32_t GetState() const { return state_; }
+    /**
+     * \brief SetCurrentPing is a method called by the client when it has a new estimation of the RTT.
+     * It is used to estimate the current frame of the other players.
+     * \param currentPing is the smoothed RTT in milliseconds
+     */
+    void SetCurrentPing(float currentPing) { currentPing_ = currentPing; }
+    [[nodiscard]] float GetFrameAdvantage() const { return frameAdvantage_; }
+    /**
+     * \brief StartReplayRecording is a method that records the validated inputs of the match, with a world snapshot every replayKeyframePeriod frames.
+     */
+    bool StartReplayRecording(std::string_view path);
+    void StopReplayRecording() { replayRecorder_.Close(); }
+    /**
+     * \brief LoadReplayKeyframe is a method that replaces the world with a replay keyframe and starts the game to show it.
+     * The spawned world needs to have the same layout as the recorded one.
+     */
+    bool LoadReplayKeyframe(Frame keyframe, const std::vector<std::uint8_t>& snapshot);
+    /**
+     * \brief ReplayInputs is a method that validates the recorded inputs of the frames following the current frame.
+     * \param firstFrame needs to be the current frame + 1
+     */
+    void ReplayInputs(Frame firstFrame, std::span<const ReplayFrameInputs> inputs);
 protected:
+    /**
+     * \brief UpdateFrameAdvantage is a method that estimates how many frames this client is ahead of the slowest other player
+     * using the last received input frames and the current ping. When the client is ahead, it stretches its fixed period
+     * until the advantage evens out, keeping the rollback window bounded.
+     */
+    void UpdateFrameAdvantage();
+    /**
+     * \brief ShowBalls is a method that gives the balls their in-game color when the start counter ends.
+     */
+    void ShowBalls();
+    /**
+     * \brief RecordReplayFrames is a method that records the inputs of the newly validated frames and a keyframe when it is due.
+     * \param isConfirmed is false when the validated world does not match the server and cannot be a keyframe
+     */
+    void RecordReplayFrames(Frame previousValidateFrame, Frame newValidateFrame, bool isConfirmed);
+    /**
+     * \brief RequestResync is a method that sends a ResyncRequestPacket, the server answers with a WorldSnapshotPacket.
+     */
+    void RequestResync(Frame desyncFrame);
+    /**
+     * \brief GetStatusText is a method that returns the text shown at the center of the screen, the countdown or the end of the game.
+     * \return false if no text is shown
+     */
+    bool GetStatusText(std::string& text, sf::Color& color) const;
+    static constexpr unsigned statusCharacterSize = 32;
+    /**
+     * \brief GetAtlasRect is a method that returns the region of a sprite in the atlas, waiting for the assets to be loaded
+     * as the sprites can be spawned before the match start gate. It returns an empty region when headless.
+     */
+    sf::IntRect GetAtlasRect(std::string_view name);
+    /**
+     * \brief WaitForAssets is a method that blocks until the assets submitted in Begin are decoded and uploaded.
+     * In the Engine render thread mode, the simulation thread waits for the render thread to upload them.
+     */
+    void WaitForAssets();
 
     //void UpdateCameraView();
     //sf::View cameraView_;
@@ -161,21 +281,76 @@ protected:
     PlayerNumber clientPlayer_ = INVALID_PLAYER;
     core::SpriteManager spriteManager_;
     float fixedTimer_ = 0.0f;
-    unsigned long long startingTime_ = 0;
+    float currentPing_ = 0.0f;
+    /**
+     * \brief frameAdvantage_ is the smoothed number of frames this client is ahead of the slowest other player
+     */
+    float frameAdvantage_ = 0.0f;
+    /**
+     * \brief fixedPeriodStretch_ is the ratio added to the fixedPeriod to let the other players catch up
+     */
+    float fixedPeriodStretch_ = 0.0f;
+    NetworkTime startingTime_ = 0;
     std::uint32_t state_ = 0;
+    /**
+     * \brief resyncPending_ is true when a ResyncRequestPacket was sent and the world snapshot is not received yet
+     */
+    bool resyncPending_ = false;
+    /**
+     * \brief isDesyncFatal_ is true when a world snapshot could not be applied, the client stops requesting resyncs
+     */
+    bool isDesyncFatal_ = false;
+    std::uint32_t resyncCount_ = 0;
+    std::uint32_t desyncCount_ = 0;
+    bool isHeadless_ = false;
+    ReplayRecorder replayRecorder_;
 
 
-    sf::Texture playerLeftTexture_;
-    sf::Texture playerRightTexture_;
-    sf::Texture ballTexture_;
-    sf::Texture boundaryTexture_;
-    sf::Texture homeTexture_;
-    sf::Texture healthbarTexture_;
-    sf::Texture healthbarBackgroundTexture_;
+    /**
+     * \brief textureAtlas_ holds all the sprites of data/sprites in one texture, packed at build time
+     */
+    core::TextureAtlas textureAtlas_;
     sf::Font font_;
+    /**
+     * \brief atlasImage_ and atlasRegions_ are written by the asset loader worker and read by the upload
+     */
+    sf::Image atlasImage_;
+    std::vector<core::AtlasRegion> atlasRegions_;
+    /**
+     * \brief isFontLoaded_ is set by the upload thread and read by the thread drawing or recording the status text
+     */
+    std::atomic<bool> isFontLoaded_{ false };
+    /**
+     * \brief assetLoader_ is declared after the assets it loads, so that its worker is stopped before they are destroyed
+     */
+    core::AssetLoader assetLoader_;
 
-    sf::Text textRenderer_;
+    /**
+     * \brief statusText_ is the countdown or end of game text, laid out again only when statusString_ changes
+     */
+    core::CachedText statusText_;
+    std::string statusString_;
     bool drawPhysics_ = false;
+    /**
+     * \brief interpolateVisuals_ draws the sprites between the last two simulated frames,
+     * so that the 50 Hz simulation is smooth on displays with a higher refresh rate, one fixed period behind
+     */
+    bool interpolateVisuals_ = true;
+    /**
+     * \brief visualFrame_ is the last simulated frame drawn, previousPositions_ and previousRotations_ hold the frame before it.
+     * They are only written for the changed entities, the other ones keep the same transform in both frames.
+     */
+    Frame visualFrame_ = 0;
+    std::vector<core::Vec2f> previousPositions_;
+    std::vector<core::Degree> previousRotations_;
+    /**
+     * \brief interpolatedEntities_ are the entities whose transform changed since the previous frame, the only ones written at each update
+     */
+    std::vector<core::Entity> interpolatedEntities_;
+    /**
+     * \brief isInterpolated_ is 1 for the entities in interpolatedEntities_, indexed by entity
+     */
+    std::vector<std::uint8_t> isInterpolated_;
 
     /**
      * \brief this is an indicator number used to set the ball visible when the start counter ends
@@ -5,8 +5,12 @@
 #include "maths/angle.h"
 #include "maths/vec2.h"
 
+#include <SFML/Graphics/VertexArray.hpp>
 #include <SFML/System/Time.hpp>
 
+#include <cstdint>
+#include <vector>
+
 #include "graphics/graphics.h"
 #include "utils/action_utility.h"
 
@@ -73,11 +77,30 @@ public:
     using ComponentManager::ComponentManager;
 };
 
+/**
+ * \brief PhysicsDebugLayer is a flag of a layer of the physics debug draw.
+ */
+enum class PhysicsDebugLayer : std::uint8_t
+{
+    /**
+     * \brief BOXES outlines the box colliders
+     */
+    BOXES = 1u,
+    /**
+     * \brief VELOCITIES draws the distance the bodies move in velocityDrawPeriod
+     */
+    VELOCITIES = 1u << 1u,
+    /**
+     * \brief CONTACTS marks the center of the overlaps found by the last FixedUpdate
+     */
+    CONTACTS = 1u << 2u,
+};
+
 /**
  * \brief PhysicsManager is a class that holds both BodyManager and BoxManager and manages the physics fixed update.
  * It allows to register OnTriggerInterface to be called when a trigger occcurs.
  */
-class PhysicsManager : public core::DrawInterface
+class PhysicsManager : public core::DrawInterface, public core::RecordDrawInterface
 {
 public:
     explicit PhysicsManager(core::EntityManager& entityManager);
@@ -96,9 +119,26 @@ public:
     void RegisterTriggerListener(OnTriggerInterface& onTriggerInterface);
     void CopyAllComponents(const PhysicsManager& physicsManager);
     void Draw(sf::RenderTarget& renderTarget) override;
+    void RecordDraw(core::RenderSnapshot& snapshot) override;
     void SetCenter(sf::Vector2f center) { center_ = center; }
     void SetWindowSize(sf::Vector2f newWindowSize) { windowSize_ = newWindowSize; }
+    /**
+     * \brief SetDebugLayers is a method that sets the PhysicsDebugLayer flags drawn by Draw. The contacts are only recorded with the CONTACTS layer.
+     */
+    void SetDebugLayers(std::uint8_t debugLayers) { debugLayers_ = debugLayers; }
+    [[nodiscard]] std::uint8_t GetDebugLayers() const { return debugLayers_; }
 private:
+    [[nodiscard]] bool HasDebugLayer(PhysicsDebugLayer layer) const { return (debugLayers_ & static_cast<std::uint8_t>(layer)) != 0u; }
+    [[nodiscard]] sf::Vector2f ToScreenPosition(core::Vec2f position) const;
+    /**
+     * \brief BuildDebugVertices is a method that rebuilds the debug vertices of the enabled PhysicsDebugLayer.
+     */
+    void BuildDebugVertices();
+    /**
+     * \brief AppendDebugLine is a method that appends a line as a quad of two triangles to the debug vertices.
+     */
+    void AppendDebugLine(sf::Vector2f start, sf::Vector2f end, float thickness, sf::Color color);
+
     core::EntityManager& entityManager_;
     BodyManager bodyManager_;
     BoxManager boxManager_;
@@ -106,6 +146,12 @@ private:
     //Used for debug
     sf::Vector2f center_{};
     sf::Vector2f windowSize_{};
+    std::uint8_t debugLayers_ = static_cast<std::uint8_t>(PhysicsDebugLayer::BOXES);
+    std::vector<core::Vec2f> contactPoints_;
+    /**
+     * \brief debugVertices_ is rebuilt every Draw and keeps its capacity between frames
+     */
+    sf::VertexArray debugVertices_{ sf::Triangles };
 };
 
 }
@@ -0,0 +1,179 @@
+/**
+ * \file replay.h
+ */
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <fstream>
+#include <string_view>
+#include <vector>
+
+#include "game/game_globals.h"
+#include "utils/mapped_file.h"
+
+namespace game
+{
+/**
+ * \brief ReplayFrameInputs is the inputs of all the players on one frame.
+ */
+using ReplayFrameInputs = std::array<PlayerInput, maxPlayerNmb>;
+
+/**
+ * \brief ReplayChunkType is the type written in front of each chunk of a replay file, a reader skips the chunks whose type it does not know.
+ */
+enum class ReplayChunkType : std::uint32_t
+{
+    /**
+     * \brief KEYFRAME is a Frame followed by a world snapshot created by RollbackManager::SerializeValidateState.
+     */
+    KEYFRAME = 1u,
+    /**
+     * \brief INPUTS is the first Frame followed by the ReplayFrameInputs of the consecutive frames after the previous keyframe.
+     */
+    INPUTS,
+    /**
+     * \brief INDEX is the array of ReplayIndexEntry of the keyframes, written once when closing the replay.
+     */
+    INDEX,
+};
+
+/**
+ * \brief ReplayHeader is the fixed header at the start of a replay file.
+ */
+struct ReplayHeader
+{
+    static constexpr std::array<char, 8> replayMagic{ 'G', 'P', 'R', 'R', 'P', 'L', 'Y', '\0' };
+    static constexpr std::uint32_t replayVersion = 1;
+
+    std::array<char, 8> magic = replayMagic;
+    std::uint32_t version = replayVersion;
+    std::uint32_t headerSize = sizeof(ReplayHeader);
+    std::uint32_t playerNmb = maxPlayerNmb;
+    Frame keyframePeriod = replayKeyframePeriod;
+};
+
+/**
+ * \brief ReplayChunkHeader is the framing of each chunk, size is the size of the payload after it.
+ */
+struct ReplayChunkHeader
+{
+    ReplayChunkType type = ReplayChunkType::KEYFRAME;
+    std::uint32_t size = 0;
+};
+
+/**
+ * \brief ReplayIndexEntry is the position of a keyframe chunk in the file.
+ */
+struct ReplayIndexEntry
+{
+    Frame frame = 0;
+    std::uint32_t snapshotSize = 0;
+    std::uint64_t offset = 0;
+};
+
+/**
+ * \brief ReplayFooter is the fixed footer at the end of a closed replay file, a replay without footer was not closed and is indexed by scanning its chunks.
+ */
+struct ReplayFooter
+{
+    std::uint64_t indexOffset = 0;
+    Frame lastFrame = 0;
+    std::uint32_t keyframeNmb = 0;
+    std::array<char, 8> magic = ReplayHeader::replayMagic;
+};
+
+/**
+ * \brief ReplaySegment is a keyframe with the inputs of the frames until the next keyframe.
+ */
+struct ReplaySegment
+{
+    Frame keyframe = 0;
+    std::vector<std::uint8_t> snapshot;
+    /**
+     * \brief inputs[i] are the inputs of frame keyframe + 1 + i
+     */
+    std::vector<ReplayFrameInputs> inputs;
+
+    [[nodiscard]] Frame GetLastFrame() const { return keyframe + static_cast<Frame>(inputs.size()); }
+};
+
+/**
+ * \brief ReplayRecorder is a class that writes the validated inputs of a match and a world snapshot every keyframe period.
+ * The inputs of a segment are kept in memory and written when the next keyframe is recorded.
+ */
+class ReplayRecorder
+{
+public:
+    ~ReplayRecorder();
+    bool Open(std::string_view path, Frame keyframePeriod = replayKeyframePeriod);
+    /**
+     * \brief Close is a method that writes the pending inputs, the keyframe index and the footer.
+     */
+    void Close();
+    /**
+     * \brief RecordInputs is a method that appends the inputs of the frame following the last recorded one.
+     * Inputs given before the first keyframe are ignored.
+     */
+    void RecordInputs(Frame frame, const ReplayFrameInputs& inputs);
+    /**
+     * \brief RecordKeyframe is a method that writes the pending inputs and a new keyframe.
+     * \param snapshot is the validated world at frame, created by RollbackManager::SerializeValidateState
+     */
+    void RecordKeyframe(Frame frame, const std::vector<std::uint8_t>& snapshot);
+    [[nodiscard]] bool IsKeyframeDue(Frame frame) const;
+    [[nodiscard]] bool IsOpen() const { return file_.is_open(); }
+    [[nodiscard]] bool HasKeyframe() const { return !index_.empty(); }
+    [[nodiscard]] Frame GetLastFrame() const { return lastFrame_; }
+private:
+    void WritePendingInputs();
+    void WriteChunkHeader(ReplayChunkType type, std::size_t size);
+    template<typename T>
+    void Write(const T& value);
+
+    std::ofstream file_;
+    std::vector<ReplayIndexEntry> index_;
+    std::vector<ReplayFrameInputs> pendingInputs_;
+    Frame keyframePeriod_ = replayKeyframePeriod;
+    Frame lastFrame_ = 0;
+};
+
+/**
+ * \brief ReplayReader is a class that maps a replay file and reads its segments by keyframe index.
+ */
+class ReplayReader
+{
+public:
+    /**
+     * \brief Open is a method that maps the file, checks its header and reads the keyframe index.
+     * \return false if the file could not be opened, is not a replay of this version or has no keyframe
+     */
+    bool Open(std::string_view path);
+    /**
+     * \brief FindSegment is a method that returns the index of the last keyframe at or before frame.
+     */
+    [[nodiscard]] std::size_t FindSegment(Frame frame) const;
+    /**
+     * \brief ReadSegment is a method that reads a keyframe and the inputs until the next one.
+     * \return false if the segment is malformed
+     */
+    bool ReadSegment(std::size_t segmentIndex, ReplaySegment& segment) const;
+
+    [[nodiscard]] std::size_t GetSegmentNmb() const { return index_.size(); }
+    [[nodiscard]] Frame GetKeyframe(std::size_t segmentIndex) const { return index_[segmentIndex].frame; }
+    [[nodiscard]] Frame GetFirstFrame() const { return index_.empty() ? 0 : index_.front().frame; }
+    [[nodiscard]] Frame GetLastFrame() const { return lastFrame_; }
+    [[nodiscard]] const ReplayHeader& GetHeader() const { return header_; }
+private:
+    bool ReadIndex();
+    /**
+     * \brief ScanChunks is a method that rebuilds the index of a replay which was not closed, stopping at the first truncated chunk.
+     */
+    void ScanChunks();
+
+    core::MappedFile file_;
+    ReplayHeader header_;
+    std::vector<ReplayIndexEntry> index_;
+    Frame lastFrame_ = 0;
+};
+}
@@ -1,4 +1,6 @@
 #pragma once
+#include <memory>
+
 #include "ball_manager.h"
 #include "game_globals.h"
 #include "physics_manager.h"
@@ -10,6 +12,10 @@
 #include "home_manager.h"
 #include "healthbar_manager.h"
 
+#ifdef ENABLE_DESYNC_CHECK
+#include "desync_check.h"
+#endif
+
 
 namespace game
 {
@@ -26,15 +32,64 @@ struct CreatedEntity
     Frame createdFrame = 0;
 };
 
+/**
+ * \brief RollbackStats is a struct that contains the cost of the rollbacks done by a client.
+ */
+struct RollbackStats
+{
+    /**
+     * \brief rollbackNmb is the number of times the current world was reverted to the last validated one
+     */
+    std::uint64_t rollbackNmb = 0;
+    std::uint64_t resimulatedFrameNmb = 0;
+    /**
+     * \brief maxRollbackFrameNmb is the highest number of frames resimulated in one rollback
+     */
+    Frame maxRollbackFrameNmb = 0;
+};
+
+/**
+ * \brief RollbackMode defines how the RollbackManager simulates the game world.
+ */
+enum class RollbackMode
+{
+    /**
+     * \brief ROLLBACK is used by the clients. A last validated copy of the world is kept to resimulate from it when receiving new inputs.
+     */
+    ROLLBACK,
+    /**
+     * \brief AUTHORITATIVE is used by the server. It only simulates confirmed frames, so a single world is stepped forward incrementally.
+     */
+    AUTHORITATIVE
+};
+
+/**
+ * \brief LastValidateWorld is a struct that holds the last validated (confirm frame) copy of the component managers used for rollback.
+ * It is only allocated in RollbackMode::ROLLBACK.
+ */
+struct LastValidateWorld
+{
+    LastValidateWorld(core::EntityManager& entityManager, GameManager& gameManager);
+
+    PhysicsManager physicsManager;
+    PlayerCharacterManager playerManager;
+    BallManager ballManager;
+    BoundaryManager boundaryManager;
+    HomeManager homeManager;
+    HealthBarManager healthBarManager;
+};
+
 /**
  * \brief RollbackManager is a class that manages all the rollback mechanisms of the game.
- * It contains two copies of the world (PhysicsManager, TransformManager, etc...), the current one and the validated one.
+ * In RollbackMode::ROLLBACK, it contains two copies of the world (PhysicsManager, TransformManager, etc...), the current one and the validated one.
  * When receiving new information, it can reupdate the current copy of the world.
+ * In RollbackMode::AUTHORITATIVE, the current copy of the world is the validated one and there is no rollback.
  */
 class RollbackManager final : public OnTriggerInterface
 {
 public:
-    explicit RollbackManager(GameManager& gameManager, core::EntityManager& entityManager);
+    explicit RollbackManager(GameManager& gameManager, core::EntityManager& entityManager,
+        RollbackMode rollbackMode = RollbackMode::ROLLBACK);
     /**
      * \brief SimulateToCurrentFrame is a method that simulates all players with new inputs, method call only by the clients to update the current state of the visuals
      */
@@ -60,13 +115,42 @@ public:
      * It is called by the clients when receiving Confirm Frame packet
      * \param newValidatedFrame is the new frame that is validated
      * \param serverPhysicsState is the physics state given by the server through a packet
+     * \return false if the validated world does not match the server checksums, a resync is then needed
+     */
+    bool ConfirmFrame(Frame newValidatedFrame, const std::array<PhysicsState, maxPlayerNmb>& serverPhysicsState);
+    /**
+     * \brief SerializeValidateState is a method that serializes the rollback relevant components of the validated world.
+     * Entities are not sent by index as they differ between the server and the clients:
+     * players are written by player number and balls in entity order.
+     * \return the snapshot sent with a WorldSnapshotPacket
+     */
+    [[nodiscard]] std::vector<std::uint8_t> SerializeValidateState() const;
+    /**
+     * \brief ApplyValidateState is a method called by the clients to replace their last validated world with a server snapshot.
+     * If the client already validated further than the snapshot, the validated frames are resimulated from it.
+     * \param validateFrame is the frame of the snapshot
+     * \param snapshot is the data created by SerializeValidateState
+     * \return false if the snapshot cannot be applied (malformed, too old or with other balls than the client)
+     */
+    bool ApplyValidateState(Frame validateFrame, const std::vector<std::uint8_t>& snapshot);
+    /**
+     * \brief LoadValidateState is a method that makes a snapshot the validated world and the current frame, forgetting every input.
+     * It is used to seek in a replay, the frames after the snapshot are then given again with SetPlayerInput.
+     * \param validateFrame is the frame of the snapshot
+     * \param snapshot is the data created by SerializeValidateState
+     * \return false if the snapshot is malformed or does not have the same balls as the world
      */
-    void ConfirmFrame(Frame newValidatedFrame, const std::array<PhysicsState, maxPlayerNmb>& serverPhysicsState);
+    bool LoadValidateState(Frame validateFrame, const std::vector<std::uint8_t>& snapshot);
     [[nodiscard]] PhysicsState GetValidatePhysicsState(PlayerNumber playerNumber) const;
     [[nodiscard]] Frame GetLastValidateFrame() const { return lastValidateFrame_; }
     [[nodiscard]] Frame GetLastReceivedFrame(PlayerNumber playerNumber) const { return lastReceivedFrame_[playerNumber]; }
     [[nodiscard]] Frame GetCurrentFrame() const { return currentFrame_; }
+    /**
+     * \brief GetTransformManager is a method that returns the transforms of the current frame.
+     * On clients, it tracks the changed entities until ClearTransformChanges, so the visuals only update those.
+     */
     [[nodiscard]] const core::TransformManager& GetTransformManager() const { return currentTransformManager_; }
+    void ClearTransformChanges() { currentTransformManager_.ClearChanges(); }
     [[nodiscard]] const PlayerCharacterManager& GetPlayerCharacterManager() const { return currentPlayerManager_; }
     void SpawnPlayer(PlayerNumber playerNumber, core::Entity entity, core::Vec2f position);
     void SpawnBall(core::Entity entity, core::Vec2f position, core::Vec2f velocity);
@@ -90,9 +174,51 @@ public:
     }
 
     PhysicsManager& GetCurrentPhysicsManager() { return currentPhysicsManager_; }
-private:
-
+    [[nodiscard]] RollbackMode GetRollbackMode() const { return rollbackMode_; }
+    [[nodiscard]] const RollbackStats& GetRollbackStats() const { return rollbackStats_; }
     [[nodiscard]] PlayerInput GetInputAtFrame(PlayerNumber playerNumber, Frame frame) const;
+#ifdef ENABLE_DESYNC_CHECK
+    DesyncChecker& GetDesyncChecker() { return desyncChecker_; }
+#endif
+private:
+    /**
+     * \brief SnapshotState is the content of a snapshot created by SerializeValidateState.
+     */
+    struct SnapshotState
+    {
+        std::array<Body, maxPlayerNmb> playerBodies{};
+        std::array<PlayerCharacter, maxPlayerNmb> playerCharacters{};
+        std::vector<std::pair<Body, Ball>> balls;
+    };
+    static bool ReadSnapshotState(const std::vector<std::uint8_t>& snapshot, SnapshotState& snapshotState);
+    /**
+     * \brief WriteSnapshotState is a method that copies a snapshot in the given world.
+     * \return false without writing anything if the snapshot balls do not match the world ones
+     */
+    bool WriteSnapshotState(const SnapshotState& snapshotState,
+        PhysicsManager& physicsManager, PlayerCharacterManager& playerManager, BallManager& ballManager) const;
+    /**
+     * \brief SimulateFrame is a method that copies the inputs of the given frame into the current player manager and simulates one frame of the current world.
+     */
+    void SimulateFrame(Frame frame);
+    /**
+     * \brief GetValidatePhysicsManager is a method that returns the physics manager holding the last validated state.
+     * It is the current one in RollbackMode::AUTHORITATIVE.
+     */
+    [[nodiscard]] const PhysicsManager& GetValidatePhysicsManager() const;
+    [[nodiscard]] const PlayerCharacterManager& GetValidatePlayerManager() const;
+    [[nodiscard]] const BallManager& GetValidateBallManager() const;
+    /**
+     * \brief GetBallEntities is a method that returns the alive balls in entity order, which is the same on the server and the clients.
+     */
+    [[nodiscard]] std::vector<core::Entity> GetBallEntities() const;
+#ifdef ENABLE_DESYNC_CHECK
+    /**
+     * \brief RecordDesyncState is a method that hashes the components of the current world after a validated frame was simulated.
+     */
+    void RecordDesyncState(Frame frame);
+    DesyncChecker desyncChecker_;
+#endif
     GameManager& gameManager_;
     core::EntityManager& entityManager_;
     /**
@@ -106,15 +232,11 @@ private:
     HomeManager currentHomeManager_;
     HealthBarManager currentHealthBarManager;
 
+    RollbackMode rollbackMode_;
     /**
-     * Last Validate (confirm frame) Component Managers used for rollback
+     * Last Validate (confirm frame) Component Managers used for rollback, nullptr in RollbackMode::AUTHORITATIVE
      */
-    PhysicsManager lastValidatePhysicsManager_;
-    PlayerCharacterManager lastValidatePlayerManager_;
-    BallManager lastValidateBallManager_;
-    BoundaryManager lastValidateBoundaryManager_;
-    HomeManager lastValidateHomeManager_;
-    HealthBarManager lastValidateHealthBarManager_;
+    std::unique_ptr<LastValidateWorld> lastValidate_;
     /**
      * \brief lastValidateFrame_ is the last validated frame from the server side.
      */
@@ -135,5 +257,6 @@ private:
      * to destroy them when rollbacking.
      */
     std::vector<CreatedEntity> createdEntities_;
+    RollbackStats rollbackStats_;
 };
 }
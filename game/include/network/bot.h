@@ -0,0 +1,57 @@
+/**
+ * \file bot.h
+ */
+#pragma once
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "game/game_globals.h"
+
+namespace game
+{
+/**
+ * \brief BotType is the way the bots of the test tools choose their inputs.
+ */
+enum class BotType : std::uint8_t
+{
+    /**
+     * \brief RANDOM bots hold a random direction for a random number of ticks
+     */
+    RANDOM = 0u,
+    /**
+     * \brief SCRIPTED bots go up and down with a fixed period, each player is out of phase
+     */
+    SCRIPTED
+};
+
+/**
+ * \brief Bot is a class that plays instead of a human player in the soak, load test and headless tools.
+ */
+class Bot
+{
+public:
+    /**
+     * \param seed is the seed of the random inputs, to reproduce a match
+     */
+    Bot(BotType botType, PlayerNumber playerNumber, std::uint32_t seed);
+    /**
+     * \brief GetInput is a method that returns the input of the bot, it needs to be called at every tick.
+     * \param tick is the number of ticks since the start, used by the scripted bots
+     */
+    PlayerInput GetInput(std::size_t tick);
+private:
+    BotType botType_;
+    PlayerNumber playerNumber_;
+    std::mt19937 generator_;
+    PlayerInput currentInput_ = PlayerInputEnum::NONE;
+    std::size_t holdTickNmb_ = 0;
+};
+
+/**
+ * \brief GetPercentile is a function that returns the given percentile of the values, reordering them.
+ * \param percentile is in [0, 1]
+ */
+float GetPercentile(std::vector<float>& values, float percentile);
+}
@@ -1,5 +1,7 @@
 #pragma once
 #include "packet_type.h"
+#include "packet_stats.h"
+#include "match_log.h"
 #include "game/game_manager.h"
 #include "graphics/graphics.h"
 
@@ -9,8 +11,8 @@ namespace game
  * \brief Client is an interface of a player game manager and the net client interface (receive and send packets).
  * A client needs an ID which is receive by the server through a packet.
  */
-class Client : public core::DrawInterface, public core::DrawImGuiInterface, public PacketSenderInterface, public core::SystemInterface
-              
+class Client : public core::DrawInterface, public core::DrawImGuiInterface, public PacketSenderInterface, public core::SystemInterface,
+               public core::RecordDrawInterface
 {
 public:
     Client() : gameManager_(*this)
@@ -31,14 +33,54 @@ public:
     virtual void ReceivePacket(const Packet* packet);
 
     void Update(sf::Time dt) override;
+    void RecordDraw(core::RenderSnapshot& snapshot) override
+    {
+        gameManager_.RecordDraw(snapshot);
+    }
+
+    void UploadResources() override
+    {
+        gameManager_.UploadResources();
+    }
+    /**
+     * \brief SetHeadless is a method that runs the client without loading its graphical assets, it needs to be called before Begin.
+     */
+    void SetHeadless(bool isHeadless) { gameManager_.SetHeadless(isHeadless); }
+    [[nodiscard]] const ClientGameManager& GetGameManager() const { return gameManager_; }
+    [[nodiscard]] const PacketStats& GetPacketStats() const { return packetStats_; }
+    [[nodiscard]] float GetSrtt() const { return srtt_; }
+    /**
+     * \brief GetLastPing is a method that returns the last measured round trip time in milliseconds, before smoothing.
+     */
+    [[nodiscard]] float GetLastPing() const { return lastPing_; }
+    [[nodiscard]] std::uint64_t GetPingSampleNmb() const { return pingSampleNmb_; }
+    void SetPacketStatsDumpEnabled(bool isDumpEnabled) { packetStats_.SetDumpEnabled(isDumpEnabled); }
 protected:
 
     ClientGameManager gameManager_;
     ClientId clientId_ = INVALID_CLIENT_ID;
     float pingTimer_ = -1.0f;
     float currentPing_ = 0.0f;
+    float lastPing_ = 0.0f;
+    std::uint64_t pingSampleNmb_ = 0;
     static constexpr float pingPeriod_ = 0.3f;
 
+    /**
+     * \brief clockSync_ estimates the offset between the server clock and the local clock using the PING packets
+     */
+    ClockSync clockSync_;
+    /**
+     * \brief serverStartingTime_ is the starting time of the game in the server clock, 0 if not received
+     */
+    NetworkTime serverStartingTime_ = 0;
+    PacketStats packetStats_;
+#ifdef ENABLE_MATCH_LOG
+    /**
+     * \brief matchLog_ records the received inputs and validated frames, it is opened by the concrete clients
+     */
+    MatchLogWriter matchLog_;
+#endif
+
     float srtt_ = -1.0f;
     float rttvar_ = 0.0f;
     float rto_ = 1.0f;
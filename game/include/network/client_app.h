@@ -6,8 +6,9 @@ namespace game
 {
 /**
  * \brief ClientApp is a App that owns a NetworkClient and shows it on the screen directly.
+ * It can also be recorded in a RenderSnapshot by the Engine render thread mode.
  */
-class ClientApp final : public core::App
+class ClientApp final : public core::App, public core::RecordDrawInterface
 {
 public:
     void Begin() override;
@@ -25,6 +26,18 @@ public:
         client_.Draw(window);
     }
 
+    void RecordDraw(core::RenderSnapshot& snapshot) override
+    {
+        client_.RecordDraw(snapshot);
+    }
+
+    void UploadResources() override
+    {
+        client_.UploadResources();
+    }
+
+    void SetPacketStatsDumpEnabled(bool isDumpEnabled) { client_.SetPacketStatsDumpEnabled(isDumpEnabled); }
+
 private:
     sf::Vector2u windowSize_;
     NetworkClient client_;
@@ -0,0 +1,78 @@
+/**
+ * \file clock_sync.h
+ */
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+#include "game/game_globals.h"
+
+namespace game
+{
+/**
+ * \brief NetworkTime is the type of the timestamps exchanged between the clients and the server.
+ * It is expressed in microseconds on a monotonic clock, its epoch is local to each process.
+ */
+using NetworkTime = std::int64_t;
+
+/**
+ * \brief GetNetworkTime is a function that returns the current time of the local monotonic clock (std::chrono::steady_clock).
+ * \return the current local time in microseconds
+ */
+NetworkTime GetNetworkTime();
+/**
+ * \brief SetSimulatedNetworkTime is a function that replaces the local clock of the calling thread by a simulated time.
+ * It is used by the headless simulations running faster than real time.
+ * \param simulatedTime is the time returned by GetNetworkTime on this thread until ResetSimulatedNetworkTime is called
+ */
+void SetSimulatedNetworkTime(NetworkTime simulatedTime);
+/**
+ * \brief ResetSimulatedNetworkTime is a function that restores the local clock for the calling thread.
+ */
+void ResetSimulatedNetworkTime();
+
+/**
+ * \brief ClockSyncSample is a struct that contains one measurement of an NTP-style exchange.
+ */
+struct ClockSyncSample
+{
+    NetworkTime rtt = 0;
+    NetworkTime offset = 0;
+};
+
+/**
+ * \brief ClockSync is a class that estimates the offset between the server clock and the local clock with an NTP-style exchange over the PING packets.
+ * It keeps the last clockSyncSampleNmb samples and estimates the offset from the ones with the smallest RTT,
+ * as they are the least affected by queuing delays and asymmetric routes.
+ */
+class ClockSync
+{
+public:
+    /**
+     * \brief AddSample is a method that adds a new measurement and updates the estimated offset.
+     * \param clientSendTime is the local time when the PING packet was sent
+     * \param serverTime is the server time when the PING packet was answered
+     * \param clientReceiveTime is the local time when the answer was received
+     */
+    void AddSample(NetworkTime clientSendTime, NetworkTime serverTime, NetworkTime clientReceiveTime);
+    /**
+     * \brief IsSynchronized is a method that checks if enough samples were received to trust the estimated offset.
+     */
+    [[nodiscard]] bool IsSynchronized() const { return sampleCount_ >= clockSyncMinSampleNmb; }
+    /**
+     * \brief GetOffset is a method that returns the estimated offset, server time minus local time.
+     */
+    [[nodiscard]] NetworkTime GetOffset() const { return offset_; }
+    /**
+     * \brief ToLocalTime is a method that converts a server timestamp to the local clock.
+     */
+    [[nodiscard]] NetworkTime ToLocalTime(NetworkTime serverTime) const { return serverTime - offset_; }
+    [[nodiscard]] std::size_t GetSampleCount() const { return sampleCount_; }
+private:
+    std::array<ClockSyncSample, clockSyncSampleNmb> samples_{};
+    std::size_t sampleCount_ = 0;
+    std::size_t nextSample_ = 0;
+    NetworkTime offset_ = 0;
+};
+}
@@ -3,13 +3,18 @@
 #ifdef ENABLE_SQLITE
 #include "network/packet_type.h"
 #include "game/physics_manager.h"
+#include "utils/mpsc_queue.h"
 
+#include <atomic>
+#include <chrono>
 #include <string_view>
 #include <condition_variable>
+#include <mutex>
 #include <thread>
 #include <vector>
 
 struct sqlite3;
+struct sqlite3_stmt;
 
 namespace game
 {
@@ -22,23 +27,65 @@ struct DbPhysicsState
     Frame validateFrame{};
 };
 
+/**
+ * \brief DbInput is a struct that contains the last input of a received PlayerInputPacket.
+ */
+struct DbInput
+{
+    Frame frame{};
+    PlayerNumber playerNumber{};
+    PlayerInput input{};
+};
+
+/**
+ * \brief DebugDatabase is a class that records the inputs and the physics states in a sqlite database.
+ * The game thread pushes typed records in lock-free rings, a writer thread inserts them with prepared statements,
+ * one transaction per batch of records. The writer is woken up when a batch is full or after a flush period,
+ * records pushed while the rings are full are dropped and counted.
+ */
 class DebugDatabase
 {
 public:
+    ~DebugDatabase();
     void Open(std::string_view path);
     void StorePacket(const PlayerInputPacket* inputPacket);
     void StorePhysicsState(const DbPhysicsState& physicsState);
+    /**
+     * \brief Close is a method that waits for the writer thread to commit the queued records and closes the database.
+     */
     void Close();
+    /**
+     * \brief Flush is a method that wakes up the writer thread and waits until the queued records are committed.
+     * It is used by the tools storing more records than the rings can hold.
+     */
+    void Flush();
+    [[nodiscard]] std::uint64_t GetDroppedRecordNmb() const;
 private:
+    static constexpr std::size_t inputCapacity = 4096;
+    static constexpr std::size_t physicsStateCapacity = 1024;
+    /**
+     * \brief recordBatchSize is the number of queued records that wakes up the writer thread before the flush period
+     */
+    static constexpr std::size_t recordBatchSize = 256;
+    static constexpr std::chrono::milliseconds flushPeriod{ 100 };
+
     void Loop();
     void CreateTables() const;
+    void PrepareStatements();
+    void WriteBatch(const std::vector<DbInput>& inputs, const std::vector<DbPhysicsState>& physicsStates);
+    void Execute(const char* command) const;
+
     sqlite3* db = nullptr;
+    sqlite3_stmt* insertInputStatement_ = nullptr;
+    sqlite3_stmt* insertPhysicsStateStatement_ = nullptr;
     std::atomic<bool> isOver_ = false;
+    std::atomic<bool> isFlushRequested_ = false;
     std::thread t_;
     mutable std::mutex m_;
     std::condition_variable cv_;
-    std::vector<std::string> commands_;
+    core::MpscQueue<DbInput, inputCapacity> inputs_;
+    core::MpscQueue<DbPhysicsState, physicsStateCapacity> physicsStates_;
 };
 
 }
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,124 @@
+/**
+ * \file match_log.h
+ */
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+#include <variant>
+
+#include "network/packet_type.h"
+#include "utils/mapped_file.h"
+
+namespace game
+{
+/**
+ * \brief MatchLogRecordType is the type written in front of each record of a match log, 0 marks the end of the records.
+ */
+enum class MatchLogRecordType : std::uint16_t
+{
+    END = 0u,
+    INPUT,
+    PHYSICS_STATE,
+};
+
+/**
+ * \brief MatchLogHeader is the fixed header at the start of a match log file.
+ */
+struct MatchLogHeader
+{
+    static constexpr std::array<char, 8> matchLogMagic{ 'G', 'P', 'R', 'M', 'L', 'O', 'G', '\0' };
+    static constexpr std::uint32_t matchLogVersion = 1;
+
+    std::array<char, 8> magic = matchLogMagic;
+    std::uint32_t version = matchLogVersion;
+    std::uint32_t headerSize = sizeof(MatchLogHeader);
+    std::uint32_t playerNmb = maxPlayerNmb;
+    std::uint32_t inputNmb = maxInputNmb;
+    std::uint64_t reserved = 0;
+};
+
+/**
+ * \brief MatchLogRecordHeader is the framing of each record, a reader skips the records whose type it does not know.
+ */
+struct MatchLogRecordHeader
+{
+    MatchLogRecordType type = MatchLogRecordType::END;
+    std::uint16_t size = 0;
+};
+
+/**
+ * \brief MatchLogInput is the content of a received PlayerInputPacket.
+ */
+struct MatchLogInput
+{
+    Frame frame = 0;
+    PlayerNumber playerNumber = INVALID_PLAYER;
+    std::array<PlayerInput, maxInputNmb> inputs{};
+};
+
+/**
+ * \brief MatchLogPhysicsState is a validated frame with the server checksums and the local ones at the time it was received.
+ */
+struct MatchLogPhysicsState
+{
+    Frame validateFrame = 0;
+    Frame lastLocalValidateFrame = 0;
+    std::array<PhysicsState, maxPlayerNmb> serverStates{};
+    std::array<PhysicsState, maxPlayerNmb> localStates{};
+};
+
+using MatchLogRecord = std::variant<MatchLogInput, MatchLogPhysicsState>;
+
+/**
+ * \brief MatchLogWriter is a class that appends records to a memory-mapped file, writing a record is a copy in the mapping.
+ * The file grows by doubling its size and is truncated to the written records on Close.
+ */
+class MatchLogWriter
+{
+public:
+    ~MatchLogWriter();
+    bool Open(std::string_view path);
+    void Close();
+    void WriteInput(const PlayerInputPacket& inputPacket);
+    void WritePhysicsState(const MatchLogPhysicsState& physicsState);
+
+    [[nodiscard]] bool IsOpen() const { return file_.IsOpen(); }
+    [[nodiscard]] std::size_t GetWrittenSize() const { return writePosition_; }
+private:
+    static constexpr std::size_t initialFileSize = 1u << 20u;
+
+    template<typename T>
+    void Append(MatchLogRecordType type, const T& record);
+
+    core::MappedFile file_;
+    std::size_t writePosition_ = 0;
+};
+
+/**
+ * \brief MatchLogReader is a class that reads the records of a match log in the order they were written.
+ */
+class MatchLogReader
+{
+public:
+    /**
+     * \brief Open is a method that maps the file and checks its header.
+     * \return false if the file could not be opened or is not a match log of this version
+     */
+    bool Open(std::string_view path);
+    /**
+     * \brief ReadNext is a method that returns the next record, or nothing at the end of the file.
+     */
+    std::optional<MatchLogRecord> ReadNext();
+
+    [[nodiscard]] const MatchLogHeader& GetHeader() const { return header_; }
+    [[nodiscard]] std::size_t GetSkippedRecordNmb() const { return skippedRecordNmb_; }
+private:
+    core::MappedFile file_;
+    MatchLogHeader header_;
+    std::size_t readPosition_ = 0;
+    std::size_t skippedRecordNmb_ = 0;
+};
+}
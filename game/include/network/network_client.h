@@ -2,6 +2,7 @@
 #include "client.h"
 #include <SFML/Network/TcpSocket.hpp>
 #include <SFML/Network/UdpSocket.hpp>
+#include <string_view>
 
 #ifdef ENABLE_SQLITE
 #include "network/debug_db.h"
@@ -44,6 +45,12 @@ public:
 	void SendUnreliablePacket(std::unique_ptr<Packet> packet) override;
 
 	void SetPlayerInput(PlayerInput playerInput);
+	/**
+	 * \brief Join is a method that connects the TCP socket to the server and sends the JOIN packet.
+	 * \return true if the connection succeeded
+	 */
+	bool Join(std::string_view address, unsigned short tcpPort);
+	[[nodiscard]] State GetState() const { return currentState_; }
 
 	void ReceivePacket(const Packet* packet) override;
 
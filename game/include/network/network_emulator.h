@@ -0,0 +1,140 @@
+/**
+ * \file network_emulator.h
+ */
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "network/packet_type.h"
+
+namespace game
+{
+/**
+ * \brief LatencyDistribution is the distribution used by a NetworkLink to sample the one-way latency of each packet.
+ */
+enum class LatencyDistribution : std::uint8_t
+{
+    /**
+     * \brief UNIFORM samples in [latency - jitter, latency + jitter]
+     */
+    UNIFORM = 0u,
+    /**
+     * \brief NORMAL samples a normal distribution of mean latency and standard deviation jitter, clamped at zero
+     */
+    NORMAL,
+    /**
+     * \brief EXPONENTIAL adds an exponential tail of mean jitter to the latency, for occasional spikes
+     */
+    EXPONENTIAL,
+    LENGTH
+};
+
+/**
+ * \brief LinkConditions is a struct that contains the impairments applied to one direction of a simulated link.
+ * All durations are in seconds. Reliable packets are never lost, duplicated or reordered.
+ */
+struct LinkConditions
+{
+    LatencyDistribution latencyDistribution = LatencyDistribution::UNIFORM;
+    float latency = 0.25f;
+    float jitter = 0.1f;
+    /**
+     * \brief goodToBadProbability is the probability per packet to switch from the good to the bad state of the Gilbert-Elliott loss model
+     */
+    float goodToBadProbability = 0.0f;
+    /**
+     * \brief badToGoodProbability is the probability per packet to switch from the bad to the good state of the Gilbert-Elliott loss model
+     */
+    float badToGoodProbability = 1.0f;
+    float goodLossProbability = 0.0f;
+    float badLossProbability = 1.0f;
+    float reorderProbability = 0.0f;
+    /**
+     * \brief reorderDelay is the extra latency added to a reordered packet
+     */
+    float reorderDelay = 0.05f;
+    float duplicateProbability = 0.0f;
+    /**
+     * \brief bandwidth is the capacity of the link in bytes per second, 0 for an unlimited link
+     */
+    float bandwidth = 0.0f;
+    /**
+     * \brief maxQueueDelay is the maximum time an unreliable packet waits for the bandwidth before being dropped
+     */
+    float maxQueueDelay = 0.5f;
+};
+
+/**
+ * \brief NetworkLink is a class that emulates one direction of a network link for the SimulationServer.
+ * Packets are scheduled in a binary heap ordered by release time, so sending and releasing a packet is O(log n).
+ */
+class NetworkLink
+{
+public:
+    /**
+     * \param conditions are the impairments of the link, they can be modified while the link is running
+     * \param seed is the seed of the random engine, to reproduce the same network conditions
+     */
+    explicit NetworkLink(const LinkConditions& conditions, std::uint32_t seed = std::random_device{}());
+    /**
+     * \brief Send is a method that schedules a packet on the link.
+     * \param packet is the sent packet
+     * \param isReliable is true for packets sent on the reliable channel, they are released in order and never lost
+     * \param currentTime is the current simulated time
+     * \return the number of scheduled copies of the packet, 0 if it was lost
+     */
+    std::size_t Send(std::unique_ptr<Packet> packet, bool isReliable, double currentTime);
+    /**
+     * \brief PopReadyPacket is a method that returns the next packet whose release time has passed.
+     * \return the released packet, nullptr if no packet is ready
+     */
+    std::unique_ptr<Packet> PopReadyPacket(double currentTime);
+    /**
+     * \brief GetNextReleaseTime is a method that returns the release time of the next packet, infinity if no packet is scheduled.
+     */
+    [[nodiscard]] double GetNextReleaseTime() const;
+    /**
+     * \brief SetSeed is a method that reseeds the random engine of the link, to replay the same network conditions.
+     */
+    void SetSeed(std::uint32_t seed) { generator_.seed(seed); }
+
+    [[nodiscard]] std::size_t GetScheduledPacketNmb() const { return scheduledPackets_.size(); }
+    [[nodiscard]] std::uint64_t GetLostPacketNmb() const { return lostPacketNmb_; }
+    [[nodiscard]] std::uint64_t GetDuplicatedPacketNmb() const { return duplicatedPacketNmb_; }
+    [[nodiscard]] std::uint64_t GetReorderedPacketNmb() const { return reorderedPacketNmb_; }
+    [[nodiscard]] bool IsInBadState() const { return isBadState_; }
+private:
+    struct ScheduledPacket
+    {
+        double releaseTime = 0.0;
+        std::uint64_t sequence = 0;
+        std::unique_ptr<Packet> packet = nullptr;
+    };
+    /**
+     * \brief Schedule is a method that reserves the bandwidth for one copy of a packet and pushes it in the heap.
+     * \return false if the copy was dropped because the link queue is full
+     */
+    bool Schedule(std::unique_ptr<Packet> packet, std::size_t packetSize, bool isReliable, double currentTime);
+    [[nodiscard]] double SampleLatency();
+    [[nodiscard]] bool SampleLoss();
+    [[nodiscard]] bool SampleProbability(float probability);
+
+    const LinkConditions& conditions_;
+    std::mt19937 generator_;
+    std::vector<ScheduledPacket> scheduledPackets_;
+    std::uint64_t nextSequence_ = 0;
+    bool isBadState_ = false;
+    /**
+     * \brief linkFreeTime_ is the time when the last scheduled packet finishes being transmitted at the link bandwidth
+     */
+    double linkFreeTime_ = 0.0;
+    double lastReliableReleaseTime_ = 0.0;
+
+    std::uint64_t lostPacketNmb_ = 0;
+    std::uint64_t duplicatedPacketNmb_ = 0;
+    std::uint64_t reorderedPacketNmb_ = 0;
+};
+}
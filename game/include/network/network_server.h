@@ -14,7 +14,6 @@ namespace game
 struct ClientInfo
 {
     ClientId clientId = INVALID_CLIENT_ID;
-    unsigned long long timeDifference = 0;
     sf::IpAddress udpRemoteAddress;
     unsigned short udpRemotePort = 0;
 };
@@ -42,6 +41,7 @@ public:
     void End() override;
 
     void SetTcpPort(unsigned short i);
+    [[nodiscard]] unsigned short GetTcpPort() const { return tcpPort_; }
 
     [[nodiscard]] bool IsOpen() const;
     
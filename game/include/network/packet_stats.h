@@ -0,0 +1,111 @@
+/**
+ * \file packet_stats.h
+ */
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <string_view>
+
+#include <SFML/System/Time.hpp>
+
+#include "network/packet_type.h"
+
+namespace game
+{
+/**
+ * \brief PacketDirection is the direction of a packet seen from the owner of the PacketStats.
+ */
+enum class PacketDirection : std::uint8_t
+{
+    SENT = 0u,
+    RECEIVED,
+    LENGTH
+};
+
+/**
+ * \brief PacketCounter is a struct that contains the cumulated counters of one PacketType in one direction.
+ */
+struct PacketCounter
+{
+    std::uint64_t packetNmb = 0;
+    std::uint64_t byteNmb = 0;
+    /**
+     * \brief dropNmb is the number of packets that failed to be sent or were lost (simulated packet loss)
+     */
+    std::uint64_t dropNmb = 0;
+    /**
+     * \brief outOfOrderNmb is the number of packets received with an older frame than a previous one
+     */
+    std::uint64_t outOfOrderNmb = 0;
+};
+
+/**
+ * \brief PacketStats is a class that counts the packets and bytes sent and received by a client or a server, per PacketType and direction.
+ * Rates are computed over a packetStatsRatePeriod window and the counters can be dumped as JSON lines every packetStatsDumpPeriod.
+ */
+class PacketStats
+{
+public:
+    void AddPacket(PacketType packetType, PacketDirection direction, std::size_t byteNmb);
+    void AddDroppedPacket(PacketType packetType, PacketDirection direction);
+    void AddOutOfOrderPacket(PacketType packetType);
+    /**
+     * \brief AddLateInput is a method called when a received INPUT packet is discarded because a newer one was already received.
+     */
+    void AddLateInput();
+    /**
+     * \brief Update is a method that updates the rates and dumps the counters when a dump file is set.
+     */
+    void Update(sf::Time dt);
+    /**
+     * \brief DrawImGui is a method that draws the counters in the current ImGui window.
+     */
+    void DrawImGui() const;
+    /**
+     * \brief SetDumpFile is a method that opens the file where the counters are appended as JSON lines.
+     * \param name is written in each line to identify the source of the stats
+     * \param path is the path of the dump file
+     */
+    void SetDumpFile(std::string_view name, std::string_view path);
+    /**
+     * \brief SetDumpEnabled is a method that enables the dump, it needs to be called before SetDumpFile.
+     * The dump is disabled by default, so that the game and the tools running many clients or servers do not write files.
+     */
+    void SetDumpEnabled(bool isDumpEnabled);
+    /**
+     * \brief ToJson is a method that writes the counters and the rates as a single line JSON object.
+     */
+    [[nodiscard]] std::string ToJson() const;
+
+    [[nodiscard]] const PacketCounter& GetCounter(PacketType packetType, PacketDirection direction) const;
+    [[nodiscard]] PacketCounter GetTotalCounter(PacketDirection direction) const;
+    [[nodiscard]] std::uint64_t GetLateInputNmb() const { return lateInputNmb_; }
+    /**
+     * \brief GetByteRate is a method that returns the bytes per second of the last rate window in the given direction.
+     */
+    [[nodiscard]] float GetByteRate(PacketDirection direction) const;
+private:
+    static constexpr std::size_t directionNmb = static_cast<std::size_t>(PacketDirection::LENGTH);
+    using Counters = std::array<std::array<PacketCounter, packetTypeNmb>, directionNmb>;
+    using Rates = std::array<std::array<float, packetTypeNmb>, directionNmb>;
+
+    Counters counters_{};
+    /**
+     * \brief windowCounters_ are the counters at the start of the current rate window
+     */
+    Counters windowCounters_{};
+    Rates packetRates_{};
+    Rates byteRates_{};
+    std::uint64_t lateInputNmb_ = 0;
+    float rateTimer_ = 0.0f;
+    float dumpTimer_ = 0.0f;
+    float totalTime_ = 0.0f;
+
+    std::string name_;
+    std::ofstream dumpFile_;
+    bool isDumpEnabled_ = false;
+};
+}
@@ -6,8 +6,11 @@
 #include <SFML/Network/Packet.hpp>
 
 #include "game/game_globals.h"
+#include "network/clock_sync.h"
+#include "utils/log.h"
 #include <memory>
-#include <chrono>
+#include <string_view>
+#include <vector>
 
 namespace game
 {
@@ -25,9 +28,43 @@ enum class PacketType : std::uint8_t
     JOIN_ACK,
     WIN_GAME,
     PING,
+    RESYNC_REQUEST,
+    WORLD_SNAPSHOT,
     NONE,
 };
 
+/**
+ * \brief packetTypeNmb is the number of PacketType values, NONE included
+ */
+constexpr std::size_t packetTypeNmb = static_cast<std::size_t>(PacketType::NONE) + 1;
+
+/**
+ * \brief GetPacketTypeName is a function that returns a readable name of a PacketType, used for logs and stats.
+ */
+constexpr std::string_view GetPacketTypeName(PacketType packetType)
+{
+    constexpr std::array<std::string_view, packetTypeNmb> packetTypeNames
+    {
+        "JOIN",
+        "SPAWN_PLAYER",
+        "INPUT",
+        "SPAWN_BALL",
+        "SPAWN_BOUNDARY",
+        "SPAWN_HOME",
+        "SPAWN_HEALTHBAR",
+        "VALIDATE_STATE",
+        "START_GAME",
+        "JOIN_ACK",
+        "WIN_GAME",
+        "PING",
+        "RESYNC_REQUEST",
+        "WORLD_SNAPSHOT",
+        "NONE",
+    };
+    const auto index = static_cast<std::size_t>(packetType);
+    return index < packetTypeNames.size() ? packetTypeNames[index] : "UNKNOWN";
+}
+
 /**
  * \brief PhysicsState is the type of the physics state checksum
  */
@@ -87,23 +124,55 @@ sf::Packet& operator>>(sf::Packet& packet, std::array<T, N>& t)
     return packet;
 }
 
+template<typename T>
+sf::Packet& operator<<(sf::Packet& packet, const std::vector<T>& t)
+{
+    packet << static_cast<std::uint32_t>(t.size());
+    for (auto& tmp : t)
+    {
+        packet << tmp;
+    }
+    return packet;
+}
+
+template<typename T>
+sf::Packet& operator>>(sf::Packet& packet, std::vector<T>& t)
+{
+    std::uint32_t size = 0;
+    packet >> size;
+    //Every element takes at least one byte, a size bigger than the remaining data comes from a corrupted or hostile packet
+    if (!packet || size > packet.getDataSize() - packet.getReadPosition())
+    {
+        t.clear();
+        //Reading past the end marks the packet as invalid, so GenerateReceivedPacket drops it
+        std::uint8_t byte = 0;
+        while (packet >> byte) {}
+        return packet;
+    }
+    t.resize(size);
+    for (auto& tmp : t)
+    {
+        packet >> tmp;
+    }
+    return packet;
+}
+
 /**
  * \brief JoinPacket is a TCP Packet that is sent by a client to the server to join a game.
  */
 struct JoinPacket : TypedPacket<PacketType::JOIN>
 {
     std::array<std::uint8_t, sizeof(ClientId)> clientId{};
-    std::array<std::uint8_t, sizeof(unsigned long)> startTime{};
 };
 
 inline sf::Packet& operator<<(sf::Packet& packet, const JoinPacket& joinPacket)
 {
-    return packet << joinPacket.clientId << joinPacket.startTime;
+    return packet << joinPacket.clientId;
 }
 
 inline sf::Packet& operator>>(sf::Packet& packet, JoinPacket& joinPacket)
 {
-    return packet >> joinPacket.clientId >> joinPacket.startTime;
+    return packet >> joinPacket.clientId;
 }
 
 /**
@@ -254,11 +323,23 @@ inline sf::Packet& operator>>(sf::Packet& packet, PlayerInputPacket& playerInput
 
 /**
  * \brief StartGamePacket is a TCP Packet send by the server to start a game at a given time.
+ * The starting time is given in the server clock, the clients convert it with their estimated clock offset.
  */
 struct StartGamePacket : TypedPacket<PacketType::START_GAME>
 {
+    std::array<std::uint8_t, sizeof(NetworkTime)> startTime{};
 };
 
+inline sf::Packet& operator<<(sf::Packet& packet, const StartGamePacket& startGamePacket)
+{
+    return packet << startGamePacket.startTime;
+}
+
+inline sf::Packet& operator>>(sf::Packet& packet, StartGamePacket& startGamePacket)
+{
+    return packet >> startGamePacket.startTime;
+}
+
 /**
  * \brief ValidateFramePacket is an UDP packet that is sent by the server to validate the last physics state of the world.
  */
@@ -298,21 +379,62 @@ inline sf::Packet& operator>>(sf::Packet& packet, WinGamePacket& winGamePacket)
 
 /**
  * \brief PingPacket is an UDP Packet sent by the client to the server and resend by the server to measure the RTT between the client and the server.
+ * The server stamps it with its own clock to let the client estimate the clock offset (NTP-style exchange).
  */
 struct PingPacket : TypedPacket<PacketType::PING>
 {
-    std::array<std::uint8_t, sizeof(unsigned long long)> time{};
+    std::array<std::uint8_t, sizeof(NetworkTime)> time{};
     std::array<std::uint8_t, sizeof(ClientId)> clientId{};
+    std::array<std::uint8_t, sizeof(NetworkTime)> serverTime{};
 };
 
 inline sf::Packet& operator<<(sf::Packet& packet, const PingPacket& pingPacket)
 {
-    return packet << pingPacket.time << pingPacket.clientId;
+    return packet << pingPacket.time << pingPacket.clientId << pingPacket.serverTime;
 }
 
 inline sf::Packet& operator>>(sf::Packet& packet, PingPacket& pingPacket)
 {
-    return packet >> pingPacket.time >> pingPacket.clientId;
+    return packet >> pingPacket.time >> pingPacket.clientId >> pingPacket.serverTime;
+}
+
+/**
+ * \brief ResyncRequestPacket is a TCP Packet sent by a client to the server when its validated world does not match the server checksums.
+ */
+struct ResyncRequestPacket : TypedPacket<PacketType::RESYNC_REQUEST>
+{
+    PlayerNumber playerNumber = INVALID_PLAYER;
+    std::array<std::uint8_t, sizeof(Frame)> desyncFrame{};
+};
+
+inline sf::Packet& operator<<(sf::Packet& packet, const ResyncRequestPacket& resyncRequestPacket)
+{
+    return packet << resyncRequestPacket.playerNumber << resyncRequestPacket.desyncFrame;
+}
+
+inline sf::Packet& operator>>(sf::Packet& packet, ResyncRequestPacket& resyncRequestPacket)
+{
+    return packet >> resyncRequestPacket.playerNumber >> resyncRequestPacket.desyncFrame;
+}
+
+/**
+ * \brief WorldSnapshotPacket is a TCP Packet sent by the server to answer a ResyncRequestPacket.
+ * It contains the serialized validated world at validateFrame (see RollbackManager::SerializeValidateState).
+ */
+struct WorldSnapshotPacket : TypedPacket<PacketType::WORLD_SNAPSHOT>
+{
+    std::array<std::uint8_t, sizeof(Frame)> validateFrame{};
+    std::vector<std::uint8_t> snapshot;
+};
+
+inline sf::Packet& operator<<(sf::Packet& packet, const WorldSnapshotPacket& worldSnapshotPacket)
+{
+    return packet << worldSnapshotPacket.validateFrame << worldSnapshotPacket.snapshot;
+}
+
+inline sf::Packet& operator>>(sf::Packet& packet, WorldSnapshotPacket& worldSnapshotPacket)
+{
+    return packet >> worldSnapshotPacket.validateFrame >> worldSnapshotPacket.snapshot;
 }
 
 inline void GeneratePacket(sf::Packet& packet, Packet& sendingPacket)
@@ -371,6 +493,8 @@ inline void GeneratePacket(sf::Packet& packet, Packet& sendingPacket)
     }
     case PacketType::START_GAME:
     {
+        const auto& packetTmp = static_cast<StartGamePacket&>(sendingPacket);
+        packet << packetTmp;
         break;
     }
     case PacketType::JOIN_ACK:
@@ -391,6 +515,18 @@ inline void GeneratePacket(sf::Packet& packet, Packet& sendingPacket)
         packet << packetTmp;
         break;
     }
+    case PacketType::RESYNC_REQUEST:
+    {
+        const auto& packetTmp = static_cast<ResyncRequestPacket&>(sendingPacket);
+        packet << packetTmp;
+        break;
+    }
+    case PacketType::WORLD_SNAPSHOT:
+    {
+        const auto& packetTmp = static_cast<WorldSnapshotPacket&>(sendingPacket);
+        packet << packetTmp;
+        break;
+    }
 
     default:
         break;
@@ -463,6 +599,7 @@ inline std::unique_ptr<Packet> GenerateReceivedPacket(sf::Packet& packet)
     {
         auto startGamePacket = std::make_unique<StartGamePacket>();
         startGamePacket->packetType = packetTmp.packetType;
+        packet >> *startGamePacket;
         return startGamePacket;
     }
     case PacketType::JOIN_ACK:
@@ -486,11 +623,50 @@ inline std::unique_ptr<Packet> GenerateReceivedPacket(sf::Packet& packet)
         packet >> *pingPacket;
         return pingPacket;
     }
+    case PacketType::RESYNC_REQUEST:
+    {
+        auto resyncRequestPacket = std::make_unique<ResyncRequestPacket>();
+        resyncRequestPacket->packetType = packetTmp.packetType;
+        packet >> *resyncRequestPacket;
+        return resyncRequestPacket;
+    }
+    case PacketType::WORLD_SNAPSHOT:
+    {
+        auto worldSnapshotPacket = std::make_unique<WorldSnapshotPacket>();
+        worldSnapshotPacket->packetType = packetTmp.packetType;
+        packet >> *worldSnapshotPacket;
+        if (!packet)
+        {
+            CORE_LOG_WARNING("Dropping a world snapshot packet with an invalid snapshot size");
+            return nullptr;
+        }
+        return worldSnapshotPacket;
+    }
     default:;
     }
     return nullptr;
 }
 
+/**
+ * \brief GetPacketSize is a function that returns the size of the packet once serialized, as sent on the network.
+ */
+inline std::size_t GetPacketSize(Packet& packet)
+{
+    sf::Packet sendingPacket;
+    GeneratePacket(sendingPacket, packet);
+    return sendingPacket.getDataSize();
+}
+
+/**
+ * \brief ClonePacket is a function that creates a deep copy of a packet by serializing it.
+ */
+inline std::unique_ptr<Packet> ClonePacket(Packet& packet)
+{
+    sf::Packet sendingPacket;
+    GeneratePacket(sendingPacket, packet);
+    return GenerateReceivedPacket(sendingPacket);
+}
+
 /**
  * \brief PacketSenderInterface is a interface for any Server or Client who wants to send and receive packets
  */
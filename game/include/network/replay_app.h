@@ -0,0 +1,68 @@
+#pragma once
+#include <string>
+#include <string_view>
+
+#include "engine/app.h"
+#include "game/game_manager.h"
+#include "game/replay.h"
+#include "network/packet_type.h"
+
+namespace game
+{
+/**
+ * \brief ReplayApp is an application that shows a replay file with a ClientGameManager.
+ * Seeking loads the closest keyframe before the wanted frame and simulates the recorded inputs from it.
+ */
+class ReplayApp final : public core::App, public PacketSenderInterface
+{
+public:
+    explicit ReplayApp(std::string_view path);
+
+    void Begin() override;
+
+    void Update(sf::Time dt) override;
+
+    void End() override;
+
+    void DrawImGui() override;
+
+    void OnEvent(const sf::Event& event) override;
+
+    void Draw(sf::RenderTarget& window) override
+    {
+        gameManager_.Draw(window);
+    }
+
+    /**
+     * \brief The replayed game does not send any packet.
+     */
+    void SendReliablePacket([[maybe_unused]] std::unique_ptr<Packet> packet) override {}
+    void SendUnreliablePacket([[maybe_unused]] std::unique_ptr<Packet> packet) override {}
+
+    /**
+     * \brief Seek is a method that shows the world at the given frame, clamped to the recorded frames.
+     */
+    bool Seek(Frame frame);
+private:
+    /**
+     * \brief SpawnWorld is a method that spawns the entities in the same order as the server does when the match starts.
+     */
+    void SpawnWorld();
+    /**
+     * \brief StepFrame is a method that simulates the next recorded frame.
+     * \return false at the end of the replay
+     */
+    bool StepFrame();
+
+    std::string path_;
+    ReplayReader reader_;
+    ClientGameManager gameManager_;
+    ReplaySegment segment_;
+    std::size_t segmentIndex_ = 0;
+    bool isSegmentLoaded_ = false;
+    bool isPlaying_ = false;
+    float playSpeed_ = 1.0f;
+    float playTimer_ = 0.0f;
+    sf::Vector2u windowSize_;
+};
+}
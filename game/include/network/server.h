@@ -2,6 +2,7 @@
 #include <memory>
 
 #include "packet_type.h"
+#include "packet_stats.h"
 #include "engine/system.h"
 #include "game/game_globals.h"
 #include "game/game_manager.h"
@@ -14,6 +15,13 @@ namespace game
 class Server : public PacketSenderInterface, public core::SystemInterface
 
 {
+public:
+    [[nodiscard]] const PacketStats& GetPacketStats() const { return packetStats_; }
+    void SetPacketStatsDumpFile(std::string_view name, std::string_view path) { packetStats_.SetDumpFile(name, path); }
+    void SetPacketStatsDumpEnabled(bool isDumpEnabled) { packetStats_.SetDumpEnabled(isDumpEnabled); }
+#ifdef ENABLE_DESYNC_CHECK
+    void StartDesyncLog(std::string_view path) { gameManager_.StartDesyncLog(path); }
+#endif
 protected:
 
     virtual void SpawnNewPlayer(ClientId clientId, PlayerNumber playerNumber) = 0;
@@ -27,10 +35,11 @@ protected:
      */
     virtual void ReceivePacket(std::unique_ptr<Packet> packet);
 
-    //Server game manager
-    GameManager gameManager_;
+    //Server game manager, it only steps validated frames so it does not keep a rollback copy of the world
+    GameManager gameManager_{ RollbackMode::AUTHORITATIVE };
     PlayerNumber lastPlayerNumber_ = 0;
     std::array<ClientId, maxPlayerNmb> clientMap_{};
+    PacketStats packetStats_;
 
 
 };
@@ -1,12 +1,16 @@
 #pragma once
+#include "bot.h"
 #include "client.h"
 #include "simulation_client.h"
 #include "simulation_server.h"
+#include "clock_sync.h"
 #include "engine/app.h"
 #include "game/game_globals.h"
 
 #include <SFML/Graphics/RenderTexture.hpp>
 
+#include <vector>
+
 namespace game
 {
 /**
@@ -28,11 +32,23 @@ public:
     void Draw(sf::RenderTarget& window) override;
 
     void OnEvent(const sf::Event& event) override;
+    /**
+     * \brief SetHeadless is a method that runs the server and clients without framebuffers and graphical assets,
+     * with scripted inputs instead of the keyboard and a network time following the updates. It needs to be called before Begin.
+     */
+    void SetHeadless(bool isHeadless) { isHeadless_ = isHeadless; }
 private:
     std::array<std::unique_ptr<SimulationClient>, maxPlayerNmb> clients_;
     std::array<sf::RenderTexture, maxPlayerNmb> clientsFramebuffers_;
     SimulationServer server_;
     sf::Sprite screenQuad_;
     sf::Vector2u windowSize_;
+    bool isHeadless_ = false;
+    /**
+     * \brief bots_ are the scripted players of the headless mode
+     */
+    std::vector<Bot> bots_;
+    std::size_t updateNmb_ = 0;
+    NetworkTime simulatedTime_ = 0;
 };
 }
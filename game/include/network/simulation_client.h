@@ -31,6 +31,10 @@ public:
     
     void DrawImGui() override;
     void SetPlayerInput(PlayerInput input);
+    /**
+     * \brief Join is a method that sends the JOIN packet to the SimulationServer to spawn the player of this client.
+     */
+    void Join();
     
 private:
     SimulationServer& server_;
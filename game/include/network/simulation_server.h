@@ -1,25 +1,20 @@
 #pragma once
 #include <memory>
+#include <random>
 #include <SFML/System/Time.hpp>
 
 #include "debug_db.h"
+#include "network_emulator.h"
 #include "server.h"
 #include "graphics/graphics.h"
 
 namespace game
 {
-/**
- * \brief DelayPacket is a struct used by the SimulationServer to delay received Packet.
- */
-struct DelayPacket
-{
-	float currentTime = 0.0f;
-	std::unique_ptr<Packet> packet = nullptr;
-};
 class SimulationClient;
 
 /**
  * \brief SimulationServer is a Server that delays Packet internally before "receiving" them and then sends them back with delay to the SimulationClient.
+ * Each client has an uplink and a downlink NetworkLink emulating the latency, losses, reordering, duplication and bandwidth of the network.
  */
 class SimulationServer final : public Server, public core::DrawImGuiInterface
 {
@@ -29,11 +24,17 @@ public:
 	void Update(sf::Time dt) override;
 	void End() override;
 	void DrawImGui() override;
-	void PutPacketInReceiveQueue(std::unique_ptr<Packet> packet, bool unreliable);
+	void PutPacketInReceiveQueue(const SimulationClient& client, std::unique_ptr<Packet> packet, bool unreliable);
 	void SendReliablePacket(std::unique_ptr<Packet> packet) override;
 	void SendUnreliablePacket(std::unique_ptr<Packet> packet) override;
+	void SetLinkConditions(const LinkConditions& uplinkConditions, const LinkConditions& downlinkConditions);
+	/**
+	 * \brief SetSeed is a method that seeds all the links of the server and the ball directions,
+	 * the link of each client direction gets a different seed.
+	 */
+	void SetSeed(std::uint32_t seed);
 private:
-	void PutPacketInSendingQueue(std::unique_ptr<Packet> packet);
+	void PutPacketInSendingQueue(std::unique_ptr<Packet> packet, bool isReliable);
 	void ProcessReceivePacket(std::unique_ptr<Packet> packet);
 
 	void SpawnNewPlayer(ClientId clientId, PlayerNumber playerNumber) override;
@@ -42,11 +43,18 @@ private:
 	void SpawnNewHome(PlayerNumber playerNumberToSpawnHomeFor) override;
 	void SpawnNewHealthbar(PlayerNumber playerNumberToSpawnHealthbarFor) override;
 
-	std::vector<DelayPacket> receivedPackets_;
-	std::vector<DelayPacket> sentPackets_;
 	std::array<std::unique_ptr<SimulationClient>, maxPlayerNmb>& clients_;
-	float avgDelay_ = 0.25f;
-	float marginDelay_ = 0.1f;
-	float packetLoss_ = 0.0f;
+	LinkConditions uplinkConditions_;
+	LinkConditions downlinkConditions_;
+	std::vector<NetworkLink> uplinks_;
+	std::vector<NetworkLink> downlinks_;
+	/**
+	 * \brief currentTime_ is the simulated time in seconds used to release the packets
+	 */
+	double currentTime_ = 0.0;
+	/**
+	 * \brief generator_ picks the ball directions, seeded with the links to reproduce a match
+	 */
+	std::mt19937 generator_{ std::random_device{}() };
 };
 }
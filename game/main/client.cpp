@@ -1,13 +1,32 @@
+#include <string_view>
 
 #include "engine/engine.h"
 #include "network/client_app.h"
 
-int main()
+/**
+ * Usage: client [--render-thread] [--packet-stats]
+ * With --render-thread, the network and the game run on a simulation thread and the main thread only draws and displays.
+ * With --packet-stats, the packet counters are appended to client_<id>_packet_stats.jsonl.
+ */
+int main(int argc, char** argv)
 {
     core::Engine engine;
     game::ClientApp app;
     engine.RegisterApp(&app);
+    for (int i = 1; i < argc; i++)
+    {
+        const std::string_view arg = argv[i];
+        if (arg == "--render-thread")
+        {
+            engine.RegisterRecordDraw(&app);
+            engine.SetRenderThreadEnabled(true);
+        }
+        else if (arg == "--packet-stats")
+        {
+            app.SetPacketStatsDumpEnabled(true);
+        }
+    }
 
     engine.Run();
     return 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1,97 @@
+#include <chrono>
+#include <iostream>
+#include <string>
+
+#include <fmt/format.h>
+
+#include "game/physics_manager.h"
+
+namespace
+{
+constexpr auto bodyMask = static_cast<core::EntityMask>(core::ComponentType::BODY2D);
+
+/**
+ * \brief IntegrateChecked is the position integration of PhysicsManager::FixedUpdate written with the checked accessors.
+ * The rotation is left out as its out-of-line Degree operations hide the cost of the accessors.
+ */
+void IntegrateChecked(core::EntityManager& entityManager, game::BodyManager& bodyManager, float dt)
+{
+    for (core::Entity entity = 0; entity < entityManager.GetEntitiesSize(); entity++)
+    {
+        if (!entityManager.HasComponent(entity, bodyMask))
+            continue;
+        auto body = bodyManager.GetComponent(entity);
+        body.position += body.velocity * dt;
+        bodyManager.SetComponent(entity, body);
+    }
+}
+
+/**
+ * \brief IntegrateUnchecked is the same loop with the unchecked accessors used by the validated system loops.
+ */
+void IntegrateUnchecked(core::EntityManager& entityManager, game::BodyManager& bodyManager, float dt)
+{
+    for (core::Entity entity = 0; entity < entityManager.GetEntitiesSize(); entity++)
+    {
+        if (!entityManager.HasComponentUnchecked(entity, bodyMask))
+            continue;
+        auto body = bodyManager.GetComponentUnchecked(entity);
+        body.position += body.velocity * dt;
+        bodyManager.SetComponentUnchecked(entity, body);
+    }
+}
+
+template<typename Loop>
+double MeasureLoop(Loop loop, core::EntityManager& entityManager, game::BodyManager& bodyManager, std::size_t iterationNmb)
+{
+    const auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < iterationNmb; i++)
+    {
+        loop(entityManager, bodyManager, game::fixedPeriod);
+    }
+    const auto duration = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start);
+    return duration.count() / static_cast<double>(iterationNmb * entityManager.GetEntitiesSize());
+}
+}
+
+/**
+ * ComponentBenchmark compares the checked and unchecked component accessors in the physics integration loop,
+ * with the assertions selected by Gpr_Assert and Gpr_Assert_Level.
+ * Usage: component_benchmark [entity count] [iteration count]
+ */
+int main(int argc, char** argv)
+{
+    const std::size_t entityNmb = argc > 1 ? std::stoul(argv[1]) : 4096;
+    const std::size_t iterationNmb = argc > 2 ? std::stoul(argv[2]) : 10000;
+    //Assertion failures would be printed for every entity
+    core::SetLogLevel(core::LogLevel::ERR);
+
+    core::EntityManager entityManager(entityNmb);
+    game::BodyManager bodyManager(entityManager);
+    for (std::size_t i = 0; i < entityNmb; i++)
+    {
+        const auto entity = entityManager.CreateEntity();
+        //One entity out of four has no body, like the boundaries and health bars of the game
+        if (entity % 4 == 3)
+            continue;
+        bodyManager.AddComponent(entity);
+        game::Body body;
+        body.velocity = core::Vec2f(1.0f, static_cast<float>(entity % 7));
+        bodyManager.SetComponent(entity, body);
+    }
+
+    std::cout << fmt::format("Entities: {}, iterations: {}, GPR_ASSERT: {}, GPR_ASSERT_LEVEL: {}\n",
+        entityManager.GetEntitiesSize(), iterationNmb, GPR_ASSERT_ENABLED, GPR_ASSERT_LEVEL);
+    const auto checkedTime = MeasureLoop(IntegrateChecked, entityManager, bodyManager, iterationNmb);
+    const auto uncheckedTime = MeasureLoop(IntegrateUnchecked, entityManager, bodyManager, iterationNmb);
+    std::cout << fmt::format("Checked:   {:.3f} ns/entity\n", checkedTime);
+    std::cout << fmt::format("Unchecked: {:.3f} ns/entity ({:.2f}x)\n", uncheckedTime, checkedTime / uncheckedTime);
+    //The result is printed so the loops are not optimized away
+    float positionSum = 0.0f;
+    for (const auto& body : bodyManager.GetAllComponents())
+    {
+        positionSum += body.position.x;
+    }
+    std::cout << fmt::format("Position sum: {}\n", positionSum);
+    return 0;
+}
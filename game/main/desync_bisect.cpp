@@ -0,0 +1,129 @@
+#include <algorithm>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "game/desync_check.h"
+
+namespace
+{
+/**
+ * \brief LoadDesyncLog reads all the frames of a desync log. A frame validated again after a resync keeps its first state,
+ * which is the one that was compared to the server.
+ */
+bool LoadDesyncLog(const std::string& path, std::map<game::Frame, game::DesyncFrameState>& frames)
+{
+    game::DesyncLogReader reader;
+    if (!reader.Open(path))
+    {
+        return false;
+    }
+    while (auto frameState = reader.ReadNext())
+    {
+        frames.try_emplace(frameState->frame, std::move(*frameState));
+    }
+    return true;
+}
+
+std::string FormatInputs(const game::ReplayFrameInputs& inputs)
+{
+    std::string result;
+    for (game::PlayerNumber playerNumber = 0; playerNumber < game::maxPlayerNmb; playerNumber++)
+    {
+        result += fmt::format(" P{}=0x{:02x}", playerNumber + 1, inputs[playerNumber]);
+    }
+    return result;
+}
+}
+
+/**
+ * DesyncBisect compares two desync logs written with ENABLE_DESYNC_CHECK (the server one and a client one, or two clients)
+ * and scans their frame hashes to the first divergent frame, then prints the first divergent component and fields.
+ * Usage: desync_bisect <reference desynclog> <other desynclog>
+ */
+int main(int argc, char** argv)
+{
+    if (argc < 3)
+    {
+        std::cerr << "Usage: desync_bisect <reference desynclog> <other desynclog>\n";
+        return EXIT_FAILURE;
+    }
+    std::map<game::Frame, game::DesyncFrameState> referenceFrames;
+    std::map<game::Frame, game::DesyncFrameState> otherFrames;
+    if (!LoadDesyncLog(argv[1], referenceFrames) || !LoadDesyncLog(argv[2], otherFrames))
+    {
+        return EXIT_FAILURE;
+    }
+    std::vector<game::Frame> commonFrames;
+    for (const auto& [frame, frameState] : referenceFrames)
+    {
+        if (otherFrames.contains(frame))
+        {
+            commonFrames.push_back(frame);
+        }
+    }
+    if (commonFrames.empty())
+    {
+        std::cout << "No common validated frame\n";
+        return EXIT_FAILURE;
+    }
+    const auto isDiverged = [&](game::Frame frame)
+    {
+        return referenceFrames.at(frame).GetHash() != otherFrames.at(frame).GetHash();
+    };
+    //A resync puts a desynchronized client back in agreement with the server, so the hashes are not sorted
+    //by divergence and cannot be bisected. The block hashes are computed when logged, scanning them is cheap.
+    const auto firstDiverged = std::find_if(commonFrames.begin(), commonFrames.end(), isDiverged);
+    std::cout << fmt::format("Compared {} common frames ({} to {})\n",
+        commonFrames.size(), commonFrames.front(), commonFrames.back());
+    if (firstDiverged == commonFrames.end())
+    {
+        std::cout << "No divergence\n";
+        return EXIT_SUCCESS;
+    }
+    const auto frame = *firstDiverged;
+    const auto& reference = referenceFrames.at(frame);
+    const auto& other = otherFrames.at(frame);
+    std::cout << fmt::format("First divergent frame: {}\n", frame);
+    if (firstDiverged != commonFrames.begin())
+    {
+        std::cout << fmt::format("Last matching frame: {}\n", *(firstDiverged - 1));
+    }
+    std::cout << fmt::format("Reference inputs:{}\n", FormatInputs(reference.inputs));
+    std::cout << fmt::format("Other inputs:    {}\n", FormatInputs(other.inputs));
+    if (reference.inputs != other.inputs)
+    {
+        std::cout << "The inputs differ, the input streams diverged before the simulation\n";
+    }
+    if (reference.blocks.size() != other.blocks.size())
+    {
+        std::cout << fmt::format("Component count differs: {} and {}\n", reference.blocks.size(), other.blocks.size());
+    }
+    const auto blockNmb = std::min(reference.blocks.size(), other.blocks.size());
+    for (std::size_t i = 0; i < blockNmb; i++)
+    {
+        const auto& referenceBlock = reference.blocks[i];
+        const auto& otherBlock = other.blocks[i];
+        if (referenceBlock.hash == otherBlock.hash)
+        {
+            continue;
+        }
+        std::cout << fmt::format("First divergent component: {}\n", game::GetDesyncBlockName(referenceBlock));
+        const auto fields = game::GetDesyncFields(referenceBlock.block);
+        for (std::size_t fieldIndex = 0; fieldIndex < fields.size(); fieldIndex++)
+        {
+            if (referenceBlock.fields[fieldIndex] == otherBlock.fields[fieldIndex])
+            {
+                continue;
+            }
+            std::cout << fmt::format("  reference {}\n  other     {}\n",
+                game::FormatDesyncField(fields[fieldIndex], referenceBlock.fields[fieldIndex]),
+                game::FormatDesyncField(fields[fieldIndex], otherBlock.fields[fieldIndex]));
+        }
+        break;
+    }
+    return EXIT_FAILURE;
+}
@@ -0,0 +1,50 @@
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <string_view>
+
+#include <fmt/format.h>
+
+#include "engine/engine.h"
+#include "network/simulation_app.h"
+#include "utils/log.h"
+
+/**
+ * Headless runs the SimulationApp, a server and two scripted clients, with the Engine headless mode, without display.
+ * Usage: headless [update count] [unthrottled|fixed|realtime]
+ * The default unthrottled clock runs 60 Hz updates as fast as the CPU allows.
+ */
+int main(int argc, char** argv)
+{
+    const std::size_t maxUpdateNmb = argc > 1 ? std::stoul(argv[1]) : 60 * 60 * 3;
+    auto clock = core::EngineClock::UNTHROTTLED;
+    if (argc > 2)
+    {
+        const std::string_view clockArg = argv[2];
+        if (clockArg == "fixed")
+        {
+            clock = core::EngineClock::FIXED;
+        }
+        else if (clockArg == "realtime")
+        {
+            clock = core::EngineClock::REAL_TIME;
+        }
+    }
+    core::SetLogLevel(core::LogLevel::WARNING);
+
+    core::Engine engine;
+    game::SimulationApp app;
+    app.SetHeadless(true);
+    engine.RegisterApp(&app);
+    engine.SetHeadless(true);
+    engine.SetClock(clock, sf::seconds(1.0f / 60.0f));
+    engine.SetMaxUpdateNmb(maxUpdateNmb);
+
+    const auto start = std::chrono::steady_clock::now();
+    engine.Run();
+    const auto wallTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    const auto updateNmb = engine.GetUpdateNmb();
+    std::cout << fmt::format("Updates: {}, wall {:.2f}s ({:.0f} updates/s)\n",
+        updateNmb, wallTime, wallTime > 0.0 ? static_cast<double>(updateNmb) / wallTime : 0.0);
+    return updateNmb == maxUpdateNmb ? 0 : 1;
+}
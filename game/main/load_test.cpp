@@ -0,0 +1,260 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <ctime>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "network/bot.h"
+#include "network/network_client.h"
+#include "network/network_server.h"
+#include "utils/assert.h"
+
+namespace
+{
+using Clock = std::chrono::steady_clock;
+
+struct LoadConfig
+{
+    std::size_t maxClientNmb = 16;
+    float stageDuration = 20.0f;
+    unsigned short basePort = 23456;
+    std::size_t clientThreadNmb = std::max(1u, std::thread::hardware_concurrency() / 2);
+    sf::Time clientTickPeriod = sf::seconds(1.0f / 60.0f);
+    sf::Time serverTickPeriod = sf::seconds(1.0f / 120.0f);
+};
+
+struct StageResult
+{
+    std::size_t clientNmb = 0;
+    std::size_t matchNmb = 0;
+    std::size_t joinedClientNmb = 0;
+    std::size_t finishedMatchNmb = 0;
+    std::size_t assertNmb = 0;
+    /**
+     * \brief serverUpdateTimes are the wall durations in microseconds of each NetworkServer::Update
+     */
+    std::vector<float> serverUpdateTimes;
+    /**
+     * \brief serverTickTimes are the wall durations in microseconds to update all the servers once
+     */
+    std::vector<float> serverTickTimes;
+    /**
+     * \brief rttSamples are the round trip times in milliseconds measured by the PING packets of the bots
+     */
+    std::vector<float> rttSamples;
+    double serverBusyTime = 0.0;
+    double wallTime = 0.0;
+    double processCpuTime = 0.0;
+};
+
+/**
+ * \brief RunStage runs clientNmb bots against clientNmb / 2 NetworkServer on the loopback.
+ * The servers are updated on one thread, as one process hosting several matches, and the bots on clientThreadNmb threads.
+ */
+StageResult RunStage(const LoadConfig& config, std::size_t clientNmb)
+{
+    StageResult result;
+    result.clientNmb = clientNmb;
+    result.matchNmb = clientNmb / game::maxPlayerNmb;
+
+    std::vector<std::unique_ptr<game::NetworkServer>> servers(result.matchNmb);
+    for (std::size_t i = 0; i < servers.size(); i++)
+    {
+        servers[i] = std::make_unique<game::NetworkServer>();
+        servers[i]->SetTcpPort(static_cast<unsigned short>(config.basePort + i * game::maxPlayerNmb));
+        servers[i]->Begin();
+    }
+    std::vector<std::unique_ptr<game::NetworkClient>> clients(clientNmb);
+    for (auto& client : clients)
+    {
+        client = std::make_unique<game::NetworkClient>();
+        client->SetHeadless(true);
+        client->Begin();
+    }
+
+    std::atomic<bool> isRunning = true;
+    std::thread serverThread([&]()
+        {
+            const auto tickDuration = std::chrono::duration_cast<Clock::duration>(
+                std::chrono::microseconds(config.serverTickPeriod.asMicroseconds()));
+            auto nextTick = Clock::now();
+            auto lastTick = nextTick;
+            while (isRunning)
+            {
+                const auto tickStart = Clock::now();
+                const auto dt = sf::microseconds(std::chrono::duration_cast<std::chrono::microseconds>(tickStart - lastTick).count());
+                lastTick = tickStart;
+                for (auto& server : servers)
+                {
+                    const auto updateStart = Clock::now();
+                    try
+                    {
+                        server->Update(dt);
+                    }
+                    catch (const core::AssertException&)
+                    {
+                        result.assertNmb++;
+                    }
+                    result.serverUpdateTimes.push_back(
+                        std::chrono::duration<float, std::micro>(Clock::now() - updateStart).count());
+                }
+                const auto tickTime = std::chrono::duration<double>(Clock::now() - tickStart).count();
+                result.serverTickTimes.push_back(static_cast<float>(tickTime * 1'000'000.0));
+                result.serverBusyTime += tickTime;
+                nextTick += tickDuration;
+                std::this_thread::sleep_until(nextTick);
+            }
+        });
+
+    for (std::size_t i = 0; i < clients.size(); i++)
+    {
+        const auto& server = servers[i / game::maxPlayerNmb];
+        clients[i]->Join("127.0.0.1", server->GetTcpPort());
+    }
+
+    const auto clientThreadNmb = std::min(config.clientThreadNmb, clients.size());
+    std::vector<std::vector<float>> rttSamples(clientThreadNmb);
+    std::vector<std::size_t> clientAssertNmb(clientThreadNmb, 0);
+    std::vector<std::thread> clientThreads;
+    clientThreads.reserve(clientThreadNmb);
+    const auto stageStart = Clock::now();
+    const auto cpuStart = std::clock();
+    for (std::size_t threadIndex = 0; threadIndex < clientThreadNmb; threadIndex++)
+    {
+        clientThreads.emplace_back([&, threadIndex]()
+            {
+                std::vector<game::Bot> bots;
+                std::vector<std::uint64_t> pingSampleNmbs;
+                for (std::size_t i = threadIndex; i < clients.size(); i += clientThreadNmb)
+                {
+                    bots.emplace_back(game::BotType::RANDOM, static_cast<game::PlayerNumber>(i % game::maxPlayerNmb),
+                        static_cast<std::uint32_t>(i + 1));
+                    pingSampleNmbs.push_back(0);
+                }
+                const auto tickDuration = std::chrono::duration_cast<Clock::duration>(
+                    std::chrono::microseconds(config.clientTickPeriod.asMicroseconds()));
+                const auto stageEnd = stageStart + std::chrono::duration_cast<Clock::duration>(
+                    std::chrono::duration<float>(config.stageDuration));
+                auto nextTick = Clock::now();
+                for (std::size_t tick = 0; nextTick < stageEnd; tick++)
+                {
+                    for (std::size_t i = threadIndex, botIndex = 0; i < clients.size(); i += clientThreadNmb, botIndex++)
+                    {
+                        auto& client = *clients[i];
+                        try
+                        {
+                            client.SetPlayerInput(bots[botIndex].GetInput(tick));
+                            client.Update(config.clientTickPeriod);
+                        }
+                        catch (const core::AssertException&)
+                        {
+                            clientAssertNmb[threadIndex]++;
+                        }
+                        if (client.GetPingSampleNmb() != pingSampleNmbs[botIndex])
+                        {
+                            pingSampleNmbs[botIndex] = client.GetPingSampleNmb();
+                            rttSamples[threadIndex].push_back(client.GetLastPing());
+                        }
+                    }
+                    nextTick += tickDuration;
+                    std::this_thread::sleep_until(nextTick);
+                }
+            });
+    }
+    for (auto& clientThread : clientThreads)
+    {
+        clientThread.join();
+    }
+    isRunning = false;
+    serverThread.join();
+    result.wallTime = std::chrono::duration<double>(Clock::now() - stageStart).count();
+    result.processCpuTime = static_cast<double>(std::clock() - cpuStart) / CLOCKS_PER_SEC;
+
+    for (std::size_t threadIndex = 0; threadIndex < clientThreadNmb; threadIndex++)
+    {
+        result.rttSamples.insert(result.rttSamples.end(), rttSamples[threadIndex].begin(), rttSamples[threadIndex].end());
+        result.assertNmb += clientAssertNmb[threadIndex];
+    }
+    for (std::size_t i = 0; i < clients.size(); i++)
+    {
+        if (clients[i]->GetState() != game::NetworkClient::State::NONE &&
+            clients[i]->GetGameManager().GetPlayerNumber() != game::INVALID_PLAYER)
+        {
+            result.joinedClientNmb++;
+        }
+        if (i % game::maxPlayerNmb == 0 &&
+            clients[i]->GetGameManager().GetState() & game::ClientGameManager::FINISHED)
+        {
+            result.finishedMatchNmb++;
+        }
+        clients[i]->End();
+    }
+    for (auto& server : servers)
+    {
+        server->End();
+    }
+    return result;
+}
+
+void PrintStageResult(StageResult& result)
+{
+    const auto serverTickP50 = game::GetPercentile(result.serverTickTimes, 0.5f);
+    const auto serverTickP99 = game::GetPercentile(result.serverTickTimes, 0.99f);
+    const auto serverUpdateP50 = game::GetPercentile(result.serverUpdateTimes, 0.5f);
+    const auto serverUpdateP99 = game::GetPercentile(result.serverUpdateTimes, 0.99f);
+    const auto rttP50 = game::GetPercentile(result.rttSamples, 0.5f);
+    const auto rttP95 = game::GetPercentile(result.rttSamples, 0.95f);
+    const auto rttP99 = game::GetPercentile(result.rttSamples, 0.99f);
+    const auto serverCpuPerMatch = result.matchNmb == 0 ? 0.0 :
+        result.serverBusyTime / result.wallTime / static_cast<double>(result.matchNmb) * 100.0;
+    const auto processCpuPerMatch = result.matchNmb == 0 ? 0.0 :
+        result.processCpuTime / result.wallTime / static_cast<double>(result.matchNmb) * 100.0;
+    std::cout << fmt::format("{:>4} clients {:>3} matches | joined {:>4} finished {:>3} asserts {} | "
+        "server tick p50 {:>6.0f}us p99 {:>6.0f}us, match update p50 {:>5.0f}us p99 {:>5.0f}us | "
+        "rtt p50 {:>5.1f}ms p95 {:>5.1f}ms p99 {:>5.1f}ms ({} samples) | "
+        "server cpu/match {:>5.2f}% process cpu/match {:>5.2f}%",
+        result.clientNmb, result.matchNmb, result.joinedClientNmb, result.finishedMatchNmb, result.assertNmb,
+        serverTickP50, serverTickP99, serverUpdateP50, serverUpdateP99,
+        rttP50, rttP95, rttP99, result.rttSamples.size(),
+        serverCpuPerMatch, processCpuPerMatch) << std::endl;
+}
+}
+
+/**
+ * LoadTest runs headless bot NetworkClient against NetworkServer on the loopback, doubling the number of clients at each stage.
+ * Usage: load_test [max clients] [stage duration in seconds] [base port]
+ */
+int main(int argc, char** argv)
+{
+    LoadConfig config;
+    if (argc > 1)
+    {
+        config.maxClientNmb = std::max<std::size_t>(game::maxPlayerNmb, std::stoul(argv[1]));
+    }
+    if (argc > 2)
+    {
+        config.stageDuration = std::stof(argv[2]);
+    }
+    if (argc > 3)
+    {
+        config.basePort = static_cast<unsigned short>(std::stoi(argv[3]));
+    }
+    core::SetLogLevel(core::LogLevel::WARNING);
+
+    std::size_t failedStageNmb = 0;
+    for (std::size_t clientNmb = game::maxPlayerNmb; clientNmb <= config.maxClientNmb; clientNmb *= 2)
+    {
+        auto result = RunStage(config, clientNmb);
+        PrintStageResult(result);
+        if (result.assertNmb != 0 || result.joinedClientNmb != result.clientNmb)
+        {
+            failedStageNmb++;
+        }
+    }
+    return failedStageNmb == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
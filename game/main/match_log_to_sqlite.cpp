@@ -0,0 +1,75 @@
+#include <iostream>
+#include <string>
+
+#include "network/match_log.h"
+
+#ifdef ENABLE_SQLITE
+#include "network/debug_db.h"
+#include "utils/conversion.h"
+#endif
+
+/**
+ * MatchLogToSqlite exports a match log to a sqlite database with the DebugDatabase schema.
+ * Usage: match_log_to_sqlite <match log> [database]
+ */
+int main(int argc, [[maybe_unused]] char** argv)
+{
+    if (argc < 2)
+    {
+        std::cerr << "Usage: match_log_to_sqlite <match log> [database]\n";
+        return EXIT_FAILURE;
+    }
+#ifdef ENABLE_SQLITE
+    const std::string matchLogPath = argv[1];
+    const std::string databasePath = argc > 2 ? argv[2] : matchLogPath + ".db";
+    game::MatchLogReader reader;
+    if (!reader.Open(matchLogPath))
+    {
+        return EXIT_FAILURE;
+    }
+    game::DebugDatabase database;
+    database.Open(databasePath);
+
+    //The rings of the DebugDatabase are smaller than a match, the writer is flushed before they are full
+    constexpr std::size_t flushRecordNmb = 512;
+    std::size_t inputNmb = 0;
+    std::size_t physicsStateNmb = 0;
+    while (const auto record = reader.ReadNext())
+    {
+        if (const auto* input = std::get_if<game::MatchLogInput>(&*record))
+        {
+            game::PlayerInputPacket inputPacket;
+            inputPacket.playerNumber = input->playerNumber;
+            inputPacket.currentFrame = core::ConvertToBinary(input->frame);
+            inputPacket.inputs = input->inputs;
+            database.StorePacket(&inputPacket);
+            inputNmb++;
+        }
+        else if (const auto* physicsState = std::get_if<game::MatchLogPhysicsState>(&*record))
+        {
+            game::DbPhysicsState dbPhysicsState;
+            dbPhysicsState.validateFrame = physicsState->validateFrame;
+            dbPhysicsState.lastLocalValidateFrame = physicsState->lastLocalValidateFrame;
+            dbPhysicsState.serverStates = physicsState->serverStates;
+            dbPhysicsState.localStates = physicsState->localStates;
+            database.StorePhysicsState(dbPhysicsState);
+            physicsStateNmb++;
+        }
+        if ((inputNmb + physicsStateNmb) % flushRecordNmb == 0)
+        {
+            database.Flush();
+        }
+    }
+    database.Close();
+    std::cout << "Exported " << inputNmb << " inputs and " << physicsStateNmb << " physics states to " << databasePath;
+    if (reader.GetSkippedRecordNmb() != 0)
+    {
+        std::cout << ", skipped " << reader.GetSkippedRecordNmb() << " unknown records";
+    }
+    std::cout << '\n';
+    return database.GetDroppedRecordNmb() == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+#else
+    std::cerr << "match_log_to_sqlite needs to be built with ENABLE_SQLITE_STORE\n";
+    return EXIT_FAILURE;
+#endif
+}
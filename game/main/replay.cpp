@@ -0,0 +1,23 @@
+#include <iostream>
+
+#include "engine/engine.h"
+#include "network/replay_app.h"
+
+/**
+ * Replay shows a replay file recorded by a client built with ENABLE_REPLAY_RECORD.
+ * Usage: replay <replay file>
+ */
+int main(int argc, char** argv)
+{
+    if (argc < 2)
+    {
+        std::cerr << "Usage: replay <replay file>\n";
+        return EXIT_FAILURE;
+    }
+    core::Engine engine;
+    game::ReplayApp app(argv[1]);
+    engine.RegisterApp(&app);
+
+    engine.Run();
+    return 0;
+}
@@ -1,20 +1,34 @@
 #include <string>
+#include <string_view>
 
 #include "network/network_server.h"
 
+/**
+ * Usage: server [port] [--packet-stats]
+ * With --packet-stats, the packet counters are appended to server_<port>_packet_stats.jsonl.
+ */
 int main(int argc, char** argv)
 {
     unsigned short port = 0;
-    if (argc == 2)
+    bool isPacketStatsDumpEnabled = false;
+    for (int i = 1; i < argc; i++)
     {
-        const std::string portArg = argv[1];
-        port = static_cast<unsigned short>(std::stoi(portArg));
+        const std::string arg = argv[i];
+        if (arg == "--packet-stats")
+        {
+            isPacketStatsDumpEnabled = true;
+        }
+        else
+        {
+            port = static_cast<unsigned short>(std::stoi(arg));
+        }
     }
     game::NetworkServer server;
     if (port != 0)
     {
         server.SetTcpPort(port);
     }
+    server.SetPacketStatsDumpEnabled(isPacketStatsDumpEnabled);
     server.Begin();
     sf::Clock clock;
     while (server.IsOpen())
@@ -0,0 +1,271 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "network/bot.h"
+#include "network/clock_sync.h"
+#include "network/simulation_client.h"
+#include "network/simulation_server.h"
+#include "utils/assert.h"
+
+namespace
+{
+struct SoakConfig
+{
+    std::size_t matchNmb = 8;
+    std::size_t threadNmb = std::max(1u, std::thread::hardware_concurrency());
+    std::size_t maxTickNmb = 60 * 60 * 3;
+    std::uint32_t seed = 42;
+    game::BotType botType = game::BotType::RANDOM;
+    /**
+     * \brief tickPeriod is the simulated duration of one update, the matches run as fast as the CPU allows
+     */
+    sf::Time tickPeriod = sf::seconds(1.0f / 60.0f);
+    game::LinkConditions uplinkConditions;
+    game::LinkConditions downlinkConditions;
+};
+
+struct MatchResult
+{
+    std::size_t matchIndex = 0;
+    std::uint32_t seed = 0;
+    bool isFinished = false;
+    bool isDesyncFatal = false;
+    std::string error;
+    std::size_t tickNmb = 0;
+    double wallTime = 0.0;
+    std::array<game::RollbackStats, game::maxPlayerNmb> rollbackStats{};
+    std::array<std::uint32_t, game::maxPlayerNmb> desyncNmb{};
+    std::array<std::uint32_t, game::maxPlayerNmb> resyncNmb{};
+    /**
+     * \brief tickTimes are the wall durations in microseconds of the server and clients update of each tick
+     */
+    std::vector<float> tickTimes;
+};
+
+MatchResult RunMatch(const SoakConfig& config, std::size_t matchIndex)
+{
+    using Clock = std::chrono::steady_clock;
+    MatchResult result;
+    result.matchIndex = matchIndex;
+    result.seed = config.seed + static_cast<std::uint32_t>(matchIndex) * 7919u;
+    result.tickTimes.reserve(config.maxTickNmb);
+
+    //The simulated clock of this thread replaces the steady clock, the start delay and the pings follow the ticks
+    game::NetworkTime simulatedTime = 1'000'000;
+    const auto tickDuration = static_cast<game::NetworkTime>(config.tickPeriod.asMicroseconds());
+    game::SetSimulatedNetworkTime(simulatedTime);
+
+    std::array<std::unique_ptr<game::SimulationClient>, game::maxPlayerNmb> clients;
+    game::SimulationServer server(clients);
+    for (auto& client : clients)
+    {
+        client = std::make_unique<game::SimulationClient>(server);
+    }
+    server.SetLinkConditions(config.uplinkConditions, config.downlinkConditions);
+    server.SetSeed(result.seed);
+
+    std::vector<game::Bot> bots;
+    const auto matchStart = Clock::now();
+    try
+    {
+        for (auto& client : clients)
+        {
+            client->SetHeadless(true);
+            client->Begin();
+        }
+        server.Begin();
+        for (auto& client : clients)
+        {
+            client->Join();
+        }
+        for (game::PlayerNumber playerNumber = 0; playerNumber < game::maxPlayerNmb; playerNumber++)
+        {
+            bots.emplace_back(config.botType, playerNumber, result.seed + playerNumber + 1);
+        }
+
+        for (; result.tickNmb < config.maxTickNmb; result.tickNmb++)
+        {
+            simulatedTime += tickDuration;
+            game::SetSimulatedNetworkTime(simulatedTime);
+            for (std::size_t i = 0; i < clients.size(); i++)
+            {
+                clients[i]->SetPlayerInput(bots[i].GetInput(result.tickNmb));
+            }
+            const auto tickStart = Clock::now();
+            server.Update(config.tickPeriod);
+            for (auto& client : clients)
+            {
+                client->Update(config.tickPeriod);
+            }
+            const auto tickEnd = Clock::now();
+            result.tickTimes.push_back(std::chrono::duration<float, std::micro>(tickEnd - tickStart).count());
+
+            const bool isFinished = std::all_of(clients.begin(), clients.end(), [](const auto& client)
+                {
+                    return client->GetGameManager().GetState() & game::ClientGameManager::FINISHED;
+                });
+            if (isFinished)
+            {
+                result.isFinished = true;
+                break;
+            }
+            const bool isDesyncFatal = std::any_of(clients.begin(), clients.end(), [](const auto& client)
+                {
+                    return client->GetGameManager().IsDesyncFatal();
+                });
+            if (isDesyncFatal)
+            {
+                result.isDesyncFatal = true;
+                break;
+            }
+        }
+    }
+    catch (const core::AssertException& e)
+    {
+        result.error = e.what();
+    }
+    result.wallTime = std::chrono::duration<double>(Clock::now() - matchStart).count();
+
+    for (std::size_t i = 0; i < clients.size(); i++)
+    {
+        const auto& gameManager = clients[i]->GetGameManager();
+        result.rollbackStats[i] = gameManager.GetRollbackManager().GetRollbackStats();
+        result.desyncNmb[i] = gameManager.GetDesyncCount();
+        result.resyncNmb[i] = gameManager.GetResyncCount();
+    }
+    try
+    {
+        for (auto& client : clients)
+        {
+            client->End();
+        }
+        server.End();
+    }
+    catch (const core::AssertException& e)
+    {
+        result.error = e.what();
+    }
+    game::ResetSimulatedNetworkTime();
+    return result;
+}
+
+std::string FormatMatchResult(MatchResult& result, sf::Time tickPeriod)
+{
+    std::uint64_t rollbackNmb = 0;
+    std::uint64_t resimulatedFrameNmb = 0;
+    game::Frame maxRollbackFrameNmb = 0;
+    std::uint32_t desyncNmb = 0;
+    std::uint32_t resyncNmb = 0;
+    for (std::size_t i = 0; i < result.rollbackStats.size(); i++)
+    {
+        rollbackNmb += result.rollbackStats[i].rollbackNmb;
+        resimulatedFrameNmb += result.rollbackStats[i].resimulatedFrameNmb;
+        maxRollbackFrameNmb = std::max(maxRollbackFrameNmb, result.rollbackStats[i].maxRollbackFrameNmb);
+        desyncNmb += result.desyncNmb[i];
+        resyncNmb += result.resyncNmb[i];
+    }
+    const auto status = !result.error.empty() ? "ASSERT" :
+        result.isDesyncFatal ? "DESYNC" :
+        result.isFinished ? "FINISHED" : "TIMEOUT";
+    const auto simulatedTime = static_cast<double>(result.tickNmb) * tickPeriod.asSeconds();
+    auto line = fmt::format("match {:>3} seed {:>10} {:<8} ticks {:>6} sim {:>7.1f}s wall {:>6.2f}s (x{:.0f}) "
+        "rollbacks {:>6} resim {:>8} max depth {:>3} desyncs {} resyncs {} tick p50 {:.0f}us p99 {:.0f}us max {:.0f}us",
+        result.matchIndex, result.seed, status, result.tickNmb, simulatedTime, result.wallTime,
+        result.wallTime > 0.0 ? simulatedTime / result.wallTime : 0.0,
+        rollbackNmb, resimulatedFrameNmb, maxRollbackFrameNmb, desyncNmb, resyncNmb,
+        game::GetPercentile(result.tickTimes, 0.5f), game::GetPercentile(result.tickTimes, 0.99f),
+        result.tickTimes.empty() ? 0.0f : *std::max_element(result.tickTimes.begin(), result.tickTimes.end()));
+    if (!result.error.empty())
+    {
+        line += fmt::format("\n    {}", result.error);
+    }
+    return line;
+}
+}
+
+/**
+ * Soak runs many headless SimulationServer/SimulationClient matches in parallel with bots as players.
+ * Usage: soak [matches] [threads] [max ticks] [seed] [random|scripted]
+ * It returns a failure code if a match asserted or desynchronized.
+ */
+int main(int argc, char** argv)
+{
+    SoakConfig config;
+    if (argc > 1)
+    {
+        config.matchNmb = static_cast<std::size_t>(std::stoul(argv[1]));
+    }
+    if (argc > 2)
+    {
+        config.threadNmb = std::max<std::size_t>(1, std::stoul(argv[2]));
+    }
+    if (argc > 3)
+    {
+        config.maxTickNmb = static_cast<std::size_t>(std::stoul(argv[3]));
+    }
+    if (argc > 4)
+    {
+        config.seed = static_cast<std::uint32_t>(std::stoul(argv[4]));
+    }
+    if (argc > 5 && std::string(argv[5]) == "scripted")
+    {
+        config.botType = game::BotType::SCRIPTED;
+    }
+    config.uplinkConditions.goodLossProbability = 0.02f;
+    config.downlinkConditions.goodLossProbability = 0.02f;
+    //Logs of parallel matches would be interleaved and slow down the run
+    core::SetLogLevel(core::LogLevel::WARNING);
+
+    std::vector<MatchResult> results(config.matchNmb);
+    std::atomic<std::size_t> nextMatchIndex = 0;
+    std::mutex outputMutex;
+    std::vector<std::thread> workers;
+    const auto threadNmb = std::min(config.threadNmb, config.matchNmb);
+    workers.reserve(threadNmb);
+    for (std::size_t i = 0; i < threadNmb; i++)
+    {
+        workers.emplace_back([&]()
+            {
+                for (auto matchIndex = nextMatchIndex++; matchIndex < config.matchNmb; matchIndex = nextMatchIndex++)
+                {
+                    results[matchIndex] = RunMatch(config, matchIndex);
+                    const auto line = FormatMatchResult(results[matchIndex], config.tickPeriod);
+                    std::scoped_lock lock(outputMutex);
+                    std::cout << line << std::endl;
+                }
+            });
+    }
+    for (auto& worker : workers)
+    {
+        worker.join();
+    }
+
+    std::size_t finishedNmb = 0;
+    std::size_t failedNmb = 0;
+    std::uint64_t desyncNmb = 0;
+    std::uint64_t rollbackNmb = 0;
+    std::vector<float> tickTimes;
+    for (auto& result : results)
+    {
+        finishedNmb += result.isFinished ? 1 : 0;
+        failedNmb += result.error.empty() ? 0 : 1;
+        for (std::size_t i = 0; i < result.rollbackStats.size(); i++)
+        {
+            desyncNmb += result.desyncNmb[i];
+            rollbackNmb += result.rollbackStats[i].rollbackNmb;
+        }
+        tickTimes.insert(tickTimes.end(), result.tickTimes.begin(), result.tickTimes.end());
+    }
+    std::cout << fmt::format("{} matches on {} threads: {} finished, {} timeout, {} asserted, {} desyncs, {} rollbacks, tick p50 {:.0f}us p99 {:.0f}us",
+        config.matchNmb, threadNmb, finishedNmb, config.matchNmb - finishedNmb - failedNmb, failedNmb, desyncNmb, rollbackNmb,
+        game::GetPercentile(tickTimes, 0.5f), game::GetPercentile(tickTimes, 0.99f)) << std::endl;
+    return failedNmb == 0 && desyncNmb == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
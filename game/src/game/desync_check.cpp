@@ -0,0 +1,312 @@
+#include "game/desync_check.h"
+
+#include <bit>
+#include <type_traits>
+
+#include <fmt/format.h>
+
+#include "utils/log.h"
+
+#ifdef TRACY_ENABLE
+#include <Tracy.hpp>
+#endif
+
+namespace game
+{
+namespace
+{
+constexpr std::array<DesyncField, 6> bodyFields
+{ {
+    { "position.x", true },
+    { "position.y", true },
+    { "velocity.x", true },
+    { "velocity.y", true },
+    { "angularVelocity", true },
+    { "rotation", true },
+} };
+constexpr std::array<DesyncField, 4> playerCharacterFields
+{ {
+    { "input", false },
+    { "playerNumber", false },
+    { "health", false },
+    { "hurtTime", true },
+} };
+constexpr std::array<DesyncField, 1> ballFields
+{ {
+    { "playerNumber", false },
+} };
+
+/**
+ * \brief HashFields is a function that computes the FNV-1a hash of the fields of a block.
+ */
+void HashFields(DesyncBlockState& blockState)
+{
+    constexpr std::uint64_t fnvOffsetBasis = 14695981039346656037ull;
+    constexpr std::uint64_t fnvPrime = 1099511628211ull;
+    std::uint64_t hash = fnvOffsetBasis;
+    const auto hashByte = [&hash](std::uint8_t byte)
+    {
+        hash ^= byte;
+        hash *= fnvPrime;
+    };
+    hashByte(static_cast<std::uint8_t>(blockState.block));
+    hashByte(blockState.key);
+    for (const auto field : blockState.fields)
+    {
+        for (std::uint32_t shift = 0; shift < 32; shift += 8)
+        {
+            hashByte(static_cast<std::uint8_t>(field >> shift));
+        }
+    }
+    blockState.hash = hash;
+}
+
+template<typename T>
+std::uint32_t ToField(T value)
+{
+    if constexpr (std::is_floating_point_v<T>)
+    {
+        return std::bit_cast<std::uint32_t>(static_cast<float>(value));
+    }
+    else
+    {
+        return static_cast<std::uint32_t>(value);
+    }
+}
+
+template<typename T>
+bool ReadDesyncValue(std::ifstream& file, T& value)
+{
+    static_assert(std::is_trivially_copyable_v<T>);
+    return static_cast<bool>(file.read(reinterpret_cast<char*>(&value), sizeof(T)));
+}
+}
+
+std::uint64_t DesyncFrameState::GetHash() const
+{
+    std::uint64_t hash = 0;
+    for (const auto& blockState : blocks)
+    {
+        //Combining the block hashes like boost::hash_combine keeps the block order relevant
+        hash ^= blockState.hash + 0x9e3779b97f4a7c15ull + (hash << 6u) + (hash >> 2u);
+    }
+    return hash;
+}
+
+std::span<const DesyncField> GetDesyncFields(DesyncBlock block)
+{
+    switch (block)
+    {
+    case DesyncBlock::PLAYER_BODY:
+    case DesyncBlock::BALL_BODY:
+        return bodyFields;
+    case DesyncBlock::PLAYER_CHARACTER:
+        return playerCharacterFields;
+    case DesyncBlock::BALL:
+        return ballFields;
+    default:
+        return {};
+    }
+}
+
+std::string GetDesyncBlockName(const DesyncBlockState& blockState)
+{
+    switch (blockState.block)
+    {
+    case DesyncBlock::PLAYER_BODY:
+        return fmt::format("P{} Body", blockState.key + 1);
+    case DesyncBlock::PLAYER_CHARACTER:
+        return fmt::format("P{} PlayerCharacter", blockState.key + 1);
+    case DesyncBlock::BALL_BODY:
+        return fmt::format("Ball {} Body", blockState.key);
+    case DesyncBlock::BALL:
+        return fmt::format("Ball {} Ball", blockState.key);
+    default:
+        return "Unknown";
+    }
+}
+
+std::string FormatDesyncField(const DesyncField& field, std::uint32_t value)
+{
+    if (field.isFloat)
+    {
+        return fmt::format("{}={} (0x{:08x})", field.name, std::bit_cast<float>(value), value);
+    }
+    return fmt::format("{}={}", field.name, value);
+}
+
+DesyncBlockState HashBody(DesyncBlock block, std::uint8_t key, const Body& body)
+{
+    DesyncBlockState blockState;
+    blockState.block = block;
+    blockState.key = key;
+    blockState.fields = {
+        ToField(body.position.x),
+        ToField(body.position.y),
+        ToField(body.velocity.x),
+        ToField(body.velocity.y),
+        ToField(body.angularVelocity.value()),
+        ToField(body.rotation.value()),
+    };
+    HashFields(blockState);
+    return blockState;
+}
+
+DesyncBlockState HashPlayerCharacter(std::uint8_t key, const PlayerCharacter& playerCharacter)
+{
+    DesyncBlockState blockState;
+    blockState.block = DesyncBlock::PLAYER_CHARACTER;
+    blockState.key = key;
+    blockState.fields[0] = ToField(playerCharacter.input);
+    blockState.fields[1] = ToField(playerCharacter.playerNumber);
+    blockState.fields[2] = ToField(static_cast<std::uint16_t>(playerCharacter.health));
+    blockState.fields[3] = ToField(playerCharacter.hurtTime);
+    HashFields(blockState);
+    return blockState;
+}
+
+DesyncBlockState HashBall(std::uint8_t key, const Ball& ball)
+{
+    DesyncBlockState blockState;
+    blockState.block = DesyncBlock::BALL;
+    blockState.key = key;
+    blockState.fields[0] = ToField(ball.playerNumber);
+    HashFields(blockState);
+    return blockState;
+}
+
+bool DesyncChecker::OpenLog(std::string_view path)
+{
+    CloseLog();
+    log_.open(std::string(path), std::ios::binary | std::ios::trunc);
+    if (!log_.is_open())
+    {
+        CORE_LOG_ERROR("Could not open desync log: {}", path);
+        return false;
+    }
+    const DesyncLogHeader header{};
+    log_.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    return true;
+}
+
+void DesyncChecker::CloseLog()
+{
+    if (log_.is_open())
+    {
+        log_.close();
+    }
+}
+
+void DesyncChecker::RecordFrame(DesyncFrameState frameState)
+{
+
+#ifdef TRACY_ENABLE
+    ZoneScoped;
+#endif
+    if (log_.is_open())
+    {
+        DesyncFrameHeader frameHeader;
+        frameHeader.frame = frameState.frame;
+        frameHeader.blockNmb = static_cast<std::uint32_t>(frameState.blocks.size());
+        frameHeader.inputs = frameState.inputs;
+        log_.write(reinterpret_cast<const char*>(&frameHeader), sizeof(frameHeader));
+        log_.write(reinterpret_cast<const char*>(frameState.blocks.data()),
+            static_cast<std::streamsize>(frameState.blocks.size() * sizeof(DesyncBlockState)));
+    }
+    window_[frameState.frame % windowBufferSize] = std::move(frameState);
+}
+
+const DesyncFrameState* DesyncChecker::GetFrameState(Frame frame) const
+{
+    const auto& frameState = window_[frame % windowBufferSize];
+    if (frameState.frame != frame || frameState.blocks.empty())
+    {
+        return nullptr;
+    }
+    return &frameState;
+}
+
+void DesyncChecker::DumpMismatch(Frame lastConfirmedFrame, Frame validateFrame, PlayerNumber mismatchPlayer)
+{
+    CORE_LOG_WARNING("Desync at frame {}, frames validated since the last confirmed frame {}:",
+        validateFrame, lastConfirmedFrame);
+    for (Frame frame = lastConfirmedFrame + 1; frame <= validateFrame; frame++)
+    {
+        const auto* frameState = GetFrameState(frame);
+        if (frameState == nullptr)
+        {
+            continue;
+        }
+        std::string inputs;
+        for (PlayerNumber playerNumber = 0; playerNumber < maxPlayerNmb; playerNumber++)
+        {
+            inputs += fmt::format(" P{}=0x{:02x}", playerNumber + 1, frameState->inputs[playerNumber]);
+        }
+        CORE_LOG_WARNING("  frame {} inputs{} hash 0x{:016x}", frame, inputs, frameState->GetHash());
+    }
+    const auto* frameState = GetFrameState(validateFrame);
+    if (frameState == nullptr)
+    {
+        return;
+    }
+    //The server physics state only covers the bodies of the players
+    for (const auto& blockState : frameState->blocks)
+    {
+        if (blockState.block != DesyncBlock::PLAYER_BODY || blockState.key != mismatchPlayer)
+        {
+            continue;
+        }
+        const auto fields = GetDesyncFields(blockState.block);
+        std::string fieldValues;
+        for (std::size_t i = 0; i < fields.size(); i++)
+        {
+            fieldValues += ' ' + FormatDesyncField(fields[i], blockState.fields[i]);
+        }
+        CORE_LOG_WARNING("  first mismatch {}:{}", GetDesyncBlockName(blockState), fieldValues);
+    }
+    log_.flush();
+}
+
+bool DesyncLogReader::Open(std::string_view path)
+{
+    file_.open(std::string(path), std::ios::binary);
+    DesyncLogHeader header;
+    if (!file_.is_open() || !ReadDesyncValue(file_, header))
+    {
+        CORE_LOG_ERROR("Could not open desync log: {}", path);
+        return false;
+    }
+    if (header.magic != DesyncLogHeader::desyncLogMagic ||
+        header.version != DesyncLogHeader::desyncLogVersion ||
+        header.playerNmb != maxPlayerNmb)
+    {
+        CORE_LOG_ERROR("{} is not a desync log of version {}", path, DesyncLogHeader::desyncLogVersion);
+        file_.close();
+        return false;
+    }
+    return true;
+}
+
+std::optional<DesyncFrameState> DesyncLogReader::ReadNext()
+{
+    DesyncFrameHeader frameHeader;
+    //A frame holds a few components per player and per ball, a bigger count is a corrupted file
+    constexpr std::uint32_t maxBlockNmb = 1024;
+    if (!file_.is_open() || !ReadDesyncValue(file_, frameHeader) || frameHeader.blockNmb > maxBlockNmb)
+    {
+        return std::nullopt;
+    }
+    DesyncFrameState frameState;
+    frameState.frame = frameHeader.frame;
+    frameState.inputs = frameHeader.inputs;
+    frameState.blocks.resize(frameHeader.blockNmb);
+    for (auto& blockState : frameState.blocks)
+    {
+        if (!ReadDesyncValue(file_, blockState))
+        {
+            return std::nullopt;
+        }
+    }
+    return frameState;
+}
+}
@@ -1,14 +1,20 @@
 
 #include "game/game_manager.h"
 
+#include "utils/assert.h"
 #include "utils/log.h"
 
 #include "maths/basic.h"
 #include "utils/conversion.h"
 
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <iterator>
+#include <string>
+
 #include <fmt/format.h>
 #include <imgui.h>
-#include <chrono>
 
 
 #ifdef TRACY_ENABLE
@@ -19,9 +25,9 @@ namespace game
 {
 
 
-GameManager::GameManager() :
+GameManager::GameManager(RollbackMode rollbackMode) :
     transformManager_(entityManager_),
-    rollbackManager_(*this, entityManager_)
+    rollbackManager_(*this, entityManager_, rollbackMode)
 {
     playerEntityMap_.fill(core::INVALID_ENTITY);
 }
@@ -30,7 +36,7 @@ void GameManager::SpawnPlayer(PlayerNumber playerNumber, core::Vec2f position)
 {
     if (GetEntityFromPlayerNumber(playerNumber) != core::INVALID_ENTITY)
         return;
-    core::LogDebug("[GameManager] Spawning new player");
+    CORE_LOG_DEBUG("[GameManager] Spawning new player");
     const auto entity = entityManager_.CreateEntity();
     playerEntityMap_[playerNumber] = entity;
 
@@ -129,7 +135,7 @@ void GameManager::UpdatePlayerHealthBar(PlayerCharacter player, core::Entity& he
 }
 
 
-core::Entity GameManager::SpawnVisualizer(core::Vec2f position, [[maybe_unused]] sf::Texture& texture, [[maybe_unused]] sf::Color color)
+core::Entity GameManager::SpawnVisualizer(core::Vec2f position, [[maybe_unused]] const sf::IntRect& textureRect, [[maybe_unused]] sf::Color color)
 {
     const core::Entity entity = entityManager_.CreateEntity();
 
@@ -147,9 +153,9 @@ PlayerNumber GameManager::CheckWinner() const
     const auto& playerManager = rollbackManager_.GetPlayerCharacterManager();
     for (core::Entity entity = 0; entity < entityManager_.GetEntitiesSize(); entity++)
     {
-        if (!entityManager_.HasComponent(entity, static_cast<core::EntityMask>(ComponentType::PLAYER_CHARACTER)))
+        if (!entityManager_.HasComponentUnchecked(entity, static_cast<core::EntityMask>(ComponentType::PLAYER_CHARACTER)))
             continue;
-        const auto& player = playerManager.GetComponent(entity);
+        const auto& player = playerManager.GetComponentUnchecked(entity);
         if (player.health > 0)
         {
             alivePlayer++;
@@ -178,89 +184,174 @@ void ClientGameManager::Begin()
 #ifdef TRACY_ENABLE
     ZoneScoped;
 #endif
-    //load textures
-    if (!ballTexture_.loadFromFile("data/sprites/ball.png"))
-    {
-        core::LogError("Could not load ball sprite");
-    }
-    if (!playerLeftTexture_.loadFromFile("data/sprites/playerLeft.png"))
+    if (isHeadless_)
     {
-        core::LogError("Could not load left-side player sprite");
+        return;
     }
-    if (!playerRightTexture_.loadFromFile("data/sprites/playerRight.png"))
+    //The images and the font are decoded by the asset loader worker, so that the window and the join are not waiting for them.
+    //Only the texture upload is done by the thread owning the OpenGL context, in UploadResources.
+    assetLoader_.Submit("sprites atlas", [this]
     {
-        core::LogError("Could not load right-side player sprite");
-    }
-    if(!boundaryTexture_.loadFromFile("data/sprites/boundary.png"))
+        //load the sprites atlas packed at build time
+        if (atlasImage_.loadFromFile("data/sprites/atlas.png") &&
+            core::TextureAtlas::ReadTable("data/sprites/atlas.txt", atlasRegions_))
+        {
+            return true;
+        }
+        CORE_LOG_WARNING("Could not load the sprites atlas, packing the sprites at startup");
+        const std::array<std::string, 7> spritePaths =
+        {
+            "data/sprites/ball.png",
+            "data/sprites/playerLeft.png",
+            "data/sprites/playerRight.png",
+            "data/sprites/boundary.png",
+            "data/sprites/home.png",
+            "data/sprites/healthbar.png",
+            "data/sprites/healthbarBackground.png"
+        };
+        return core::TextureAtlas::PackImages(spritePaths, atlasImage_, atlasRegions_);
+    },
+    [this]
     {
-        core::LogError("Could not load boundary sprite");
-    }
-    if (!homeTexture_.loadFromFile("data/sprites/home.png"))
+        const bool isLoaded = textureAtlas_.LoadFromImage(atlasImage_, std::move(atlasRegions_));
+        //The decoded image is not needed once uploaded
+        atlasImage_ = sf::Image();
+        return isLoaded;
+    });
+    //The font glyphs are rendered when drawn, loading it is only parsing the file
+    assetLoader_.Submit("font", [this]
     {
-        core::LogError("Could not load home sprite");
-    }
-    if(!healthbarTexture_.loadFromFile("data/sprites/healthbar.png"))
+        return font_.loadFromFile("data/fonts/8-bit-hud.ttf");
+    },
+    [this]
     {
-        core::LogError("Could not load healthbar sprite");
-    }
-    if (!healthbarBackgroundTexture_.loadFromFile("data/sprites/healthbarBackground.png"))
+        isFontLoaded_ = true;
+        return true;
+    });
+    statusText_.SetFont(font_);
+    statusText_.SetCharacterSize(statusCharacterSize);
+}
+
+void ClientGameManager::Update(sf::Time dt)
+{
+#ifdef TRACY_ENABLE
+    ZoneScoped;
+#endif
+    fixedTimer_ += dt.asSeconds();
+    //The client ahead of the other players stretches its fixed period to let them catch up
+    const auto currentFixedPeriod = fixedPeriod * (1.0f + fixedPeriodStretch_);
+    while (fixedTimer_ > currentFixedPeriod)
     {
-        core::LogError("Could not load healthbar background sprite");
+        FixedUpdate();
+        fixedTimer_ -= currentFixedPeriod;
     }
-    //load fonts
-    if (!font_.loadFromFile("data/fonts/8-bit-hud.ttf"))
+    if (state_ & STARTED)
     {
-        core::LogError("Could not load font");
+        //The remainder of the fixed timer is how far the display is between the current frame and the next one
+        UpdateWorldVisuals(interpolateVisuals_ ? std::clamp(fixedTimer_ / currentFixedPeriod, 0.0f, 1.0f) : 1.0f);
     }
-    textRenderer_.setFont(font_);
 }
 
-void ClientGameManager::Update(sf::Time dt)
+void ClientGameManager::UpdateWorldVisuals(float interpolation)
 {
+
 #ifdef TRACY_ENABLE
     ZoneScoped;
 #endif
-    if (state_ & STARTED)
+    const auto& rollbackTransformManager = rollbackManager_.GetTransformManager();
+    const auto currentFrame = rollbackManager_.GetCurrentFrame();
+    const bool isNewFrame = currentFrame != visualFrame_;
+    if (isNewFrame)
     {
-        rollbackManager_.SimulateToCurrentFrame();
-        //Copy rollback transform position to our own
-        for (core::Entity entity = 0; entity < entityManager_.GetEntitiesSize(); entity++)
+        //Until simulated, the rollback transforms still hold the last simulated frame.
+        //The unchanged entities already hold it in the previous arrays, only the changed ones are saved before the simulation overwrites them
+        for (const auto entity : interpolatedEntities_)
         {
-            if (entityManager_.HasComponent(entity,
-                static_cast<core::EntityMask>(ComponentType::PLAYER_CHARACTER) |
-                static_cast<core::EntityMask>(core::ComponentType::SPRITE)))
+            isInterpolated_[entity] = 0u;
+            if (entity >= previousPositions_.size())
             {
-                const auto& player = rollbackManager_.GetPlayerCharacterManager().GetComponent(entity);
-               
-                if (player.hurtTime > 0.0f &&
-                    std::fmod(player.hurtTime, playeHurtFlashPeriod) > playeHurtFlashPeriod / 2.0f)
-                {
-                    spriteManager_.SetColor(entity, sf::Color::Transparent);
-                }
-                else
-                {
-                    spriteManager_.SetColor(entity, playerColors[player.playerNumber]);
-                }
+                continue;
             }
-
+            previousPositions_[entity] = rollbackTransformManager.GetPosition(entity);
+            previousRotations_[entity] = rollbackTransformManager.GetRotation(entity);
             if (entityManager_.HasComponent(entity, static_cast<core::EntityMask>(core::ComponentType::TRANSFORM)))
             {
-                transformManager_.SetPosition(entity, rollbackManager_.GetTransformManager().GetPosition(entity));
-                transformManager_.SetScale(entity, rollbackManager_.GetTransformManager().GetScale(entity));
-                transformManager_.SetRotation(entity, rollbackManager_.GetTransformManager().GetRotation(entity));
+                transformManager_.SetPosition(entity, previousPositions_[entity]);
+                transformManager_.SetRotation(entity, previousRotations_[entity]);
             }
         }
+        interpolatedEntities_.clear();
     }
-    fixedTimer_ += dt.asSeconds();
-    while (fixedTimer_ > fixedPeriod)
+    rollbackManager_.SimulateToCurrentFrame();
+    const auto& positions = rollbackTransformManager.GetAllPositions();
+    const auto& scales = rollbackTransformManager.GetAllScales();
+    const auto& rotations = rollbackTransformManager.GetAllRotations();
+    //Several frames were simulated at once or the replay seeked, nothing to interpolate from
+    const bool isSkippingFrames = isNewFrame && currentFrame != visualFrame_ + 1;
+    visualFrame_ = currentFrame;
+    if (previousPositions_.size() < positions.size())
     {
-        FixedUpdate();
-        fixedTimer_ -= fixedPeriod;
-
+        previousPositions_.resize(positions.size());
+        previousRotations_.resize(rotations.size());
+        isInterpolated_.resize(positions.size(), 0u);
     }
 
+    //Only the transforms changed by the simulation are read from the rollback arrays
+    for (const auto entity : rollbackTransformManager.GetChangedEntities())
+    {
+        const auto changes = rollbackTransformManager.GetChanges(entity);
+        if (isSkippingFrames || changes & static_cast<std::uint8_t>(core::TransformChange::ADDED))
+        {
+            //A spawned entity has no previous state
+            previousPositions_[entity] = positions[entity];
+            previousRotations_[entity] = rotations[entity];
+        }
+        if (changes & static_cast<std::uint8_t>(core::TransformChange::SCALE))
+        {
+            transformManager_.SetScale(entity, scales[entity]);
+        }
+        if (isInterpolated_[entity] == 0u)
+        {
+            isInterpolated_[entity] = 1u;
+            interpolatedEntities_.push_back(entity);
+        }
+    }
+    rollbackManager_.ClearTransformChanges();
 
+    for (const auto entity : interpolatedEntities_)
+    {
+        if (!entityManager_.HasComponent(entity, static_cast<core::EntityMask>(core::ComponentType::TRANSFORM)) ||
+            entity >= previousPositions_.size())
+        {
+            continue;
+        }
+        const auto previousRotation = previousRotations_[entity].value();
+        //Interpolate along the shortest arc, 350 to 10 degrees turns by 20 degrees
+        const auto deltaRotation = std::remainder(rotations[entity].value() - previousRotation, 360.0f);
+        transformManager_.SetPosition(entity, core::Vec2f::Lerp(previousPositions_[entity], positions[entity], interpolation));
+        transformManager_.SetRotation(entity, core::Degree(previousRotation + deltaRotation * interpolation));
+    }
 
+    for (PlayerNumber playerNumber = 0; playerNumber < maxPlayerNmb; playerNumber++)
+    {
+        const auto entity = GetEntityFromPlayerNumber(playerNumber);
+        if (entity == core::INVALID_ENTITY || !entityManager_.HasComponent(entity,
+            static_cast<core::EntityMask>(ComponentType::PLAYER_CHARACTER) |
+            static_cast<core::EntityMask>(core::ComponentType::SPRITE)))
+        {
+            continue;
+        }
+        const auto& player = rollbackManager_.GetPlayerCharacterManager().GetComponent(entity);
+        if (player.hurtTime > 0.0f &&
+            std::fmod(player.hurtTime, playeHurtFlashPeriod) > playeHurtFlashPeriod / 2.0f)
+        {
+            spriteManager_.SetColor(entity, sf::Color::Transparent);
+        }
+        else
+        {
+            spriteManager_.SetColor(entity, playerColors[player.playerNumber]);
+        }
+    }
 }
 
 void ClientGameManager::End()
@@ -287,6 +378,7 @@ void ClientGameManager::Draw(sf::RenderTarget& target)
 #ifdef TRACY_ENABLE
     ZoneScoped;
 #endif
+    UploadResources();
     target.setView(originalView_);
 
     spriteManager_.Draw(target);
@@ -299,63 +391,74 @@ void ClientGameManager::Draw(sf::RenderTarget& target)
 
     // Draw texts on screen
     target.setView(originalView_);
+    sf::Color statusColor;
+    if (isFontLoaded_ && GetStatusText(statusString_, statusColor))
+    {
+        statusText_.SetString(statusString_);
+        statusText_.SetColor(statusColor);
+        statusText_.SetCenter(sf::Vector2f(windowSize_) / 2.0f);
+        statusText_.Draw(target);
+    }
+}
+
+void ClientGameManager::UploadResources()
+{
+    assetLoader_.Update();
+}
+
+void ClientGameManager::RecordDraw(core::RenderSnapshot& snapshot)
+{
+
+#ifdef TRACY_ENABLE
+    ZoneScoped;
+#endif
+    snapshot.SetView(originalView_);
+    spriteManager_.RecordDraw(snapshot);
+    if (drawPhysics_)
+    {
+        rollbackManager_.GetCurrentPhysicsManager().RecordDraw(snapshot);
+    }
+    sf::Color statusColor;
+    if (isFontLoaded_ && GetStatusText(statusString_, statusColor))
+    {
+        snapshot.AddText(font_, statusString_, statusCharacterSize, statusColor, sf::Vector2f(windowSize_) / 2.0f);
+    }
+}
+
+bool ClientGameManager::GetStatusText(std::string& text, sf::Color& color) const
+{
     if (state_ & FINISHED)
     {
         if (winner_ == GetPlayerNumber())
         {
-            const std::string winnerText = fmt::format("You won!");
-            textRenderer_.setFillColor(playerColors[winner_]);
-            textRenderer_.setString(winnerText);
-            textRenderer_.setCharacterSize(32);
-            const auto textBounds = textRenderer_.getLocalBounds();
-            textRenderer_.setPosition(static_cast<float>(windowSize_.x) / 2.0f - textBounds.width / 2.0f,
-                static_cast<float>(windowSize_.y) / 2.0f - textBounds.height / 2.0f);
-            target.draw(textRenderer_);
+            text = "You won!";
+            color = playerColors[winner_];
         }
         else if (winner_ != INVALID_PLAYER)
         {
-            const std::string winnerText = fmt::format("You lost ):");
-            textRenderer_.setFillColor(playerColors[GetPlayerNumber()]);
-            textRenderer_.setString(winnerText);
-            textRenderer_.setCharacterSize(32);
-            const auto textBounds = textRenderer_.getLocalBounds();
-            textRenderer_.setPosition(static_cast<float>(windowSize_.x) / 2.0f - textBounds.width / 2.0f,
-                static_cast<float>(windowSize_.y) / 2.0f - textBounds.height / 2.0f);
-            target.draw(textRenderer_);
+            text = "You lost ):";
+            color = playerColors[GetPlayerNumber()];
         }
         else
         {
-            const std::string errorMessage = fmt::format("Error with other players");
-            textRenderer_.setFillColor(sf::Color::Red);
-            textRenderer_.setString(errorMessage);
-            textRenderer_.setCharacterSize(32);
-            const auto textBounds = textRenderer_.getLocalBounds();
-            textRenderer_.setPosition(static_cast<float>(windowSize_.x) / 2.0f - textBounds.width / 2.0f,
-                static_cast<float>(windowSize_.y) / 2.0f - textBounds.height / 2.0f);
-            target.draw(textRenderer_);
+            text = "Error with other players";
+            color = sf::Color::Red;
         }
+        return true;
     }
-    if (!(state_ & STARTED))
+    if (!(state_ & STARTED) && startingTime_ != 0)
     {
-        if (startingTime_ != 0)
+        const auto currentTime = GetNetworkTime();
+        if (currentTime < startingTime_)
         {
-            using namespace std::chrono;
-            unsigned long long ms = duration_cast<milliseconds>(
-                system_clock::now().time_since_epoch()
-                ).count();
-            if (ms < startingTime_)
-            {
-                const std::string countDownText = fmt::format("Starts in {}", ((startingTime_ - ms) / 1000 + 1));
-                textRenderer_.setFillColor(sf::Color::White);
-                textRenderer_.setString(countDownText);
-                textRenderer_.setCharacterSize(32);
-                const auto textBounds = textRenderer_.getLocalBounds();
-                textRenderer_.setPosition(static_cast<float>(windowSize_.x) / 2.0f - textBounds.width / 2.0f,
-                    static_cast<float>(windowSize_.y) / 2.0f - textBounds.height / 2.0f);
-                target.draw(textRenderer_);
-            }
+            //Formatted in the capacity of text, the CachedText only lays it out again when the second changes
+            text.clear();
+            fmt::format_to(std::back_inserter(text), "Starts in {}", ((startingTime_ - currentTime) / 1'000'000 + 1));
+            color = sf::Color::White;
+            return true;
         }
     }
+    return false;
 }
 
 void ClientGameManager::SetClientPlayer(PlayerNumber clientPlayer)
@@ -367,21 +470,15 @@ void ClientGameManager::SetClientPlayer(PlayerNumber clientPlayer)
 
 void ClientGameManager::SpawnPlayer(PlayerNumber playerNumber, core::Vec2f position)
 {
-    core::LogDebug(fmt::format("Spawn player: {}", playerNumber));
+    CORE_LOG_DEBUG("Spawn player: {}", playerNumber);
 
     GameManager::SpawnPlayer(playerNumber, position);
     const auto entity = GetEntityFromPlayerNumber(playerNumber);
 
     spriteManager_.AddComponent(entity);
-    if(playerNumber == 0)
-    {
-        spriteManager_.SetTexture(entity, playerLeftTexture_);
-    }
-    else if(playerNumber == 1)
-    {
-        spriteManager_.SetTexture(entity, playerRightTexture_);
-    }
-    spriteManager_.SetOrigin(entity, sf::Vector2f(playerLeftTexture_.getSize()) / 2.0f);
+    const auto playerRect = GetAtlasRect(playerNumber == 0 ? "playerLeft" : "playerRight");
+    spriteManager_.SetTexture(entity, textureAtlas_.GetTexture(), playerRect);
+    spriteManager_.SetOrigin(entity, sf::Vector2f(playerRect.width / 2.0f, playerRect.height / 2.0f));
     spriteManager_.SetColor(entity, playerColors[playerNumber]);
 
 }
@@ -391,8 +488,9 @@ core::Entity ClientGameManager::SpawnBall(core::Vec2f position, core::Vec2f velo
     const auto entity = GameManager::SpawnBall(position, velocity);
 
     spriteManager_.AddComponent(entity);
-    spriteManager_.SetTexture(entity, ballTexture_);
-    spriteManager_.SetOrigin(entity, sf::Vector2f(ballTexture_.getSize()) / 2.0f);
+    const auto ballRect = GetAtlasRect("ball");
+    spriteManager_.SetTexture(entity, textureAtlas_.GetTexture(), ballRect);
+    spriteManager_.SetOrigin(entity, sf::Vector2f(ballRect.width / 2.0f, ballRect.height / 2.0f));
     spriteManager_.SetColor(entity, ballColorBeforeGameStart);
 
     return entity;
@@ -401,12 +499,13 @@ core::Entity ClientGameManager::SpawnBall(core::Vec2f position, core::Vec2f velo
 core::Entity ClientGameManager::SpawnBoundary(core::Vec2f position)
 {
     const auto entity = GameManager::SpawnBoundary(position);
-    const auto boundaryVisualizer = SpawnVisualizer(position, boundaryTexture_, core::Color::black());
-    VisualizeEntity(boundaryVisualizer, boundaryTexture_, core::Color::black());
+    const auto boundaryRect = GetAtlasRect("boundary");
+    const auto boundaryVisualizer = SpawnVisualizer(position, boundaryRect, core::Color::black());
+    VisualizeEntity(boundaryVisualizer, boundaryRect, core::Color::black());
 
     spriteManager_.AddComponent(entity);
-    spriteManager_.SetTexture(entity, boundaryTexture_);
-    spriteManager_.SetOrigin(entity, sf::Vector2f(boundaryTexture_.getSize()) / 2.0f);
+    spriteManager_.SetTexture(entity, textureAtlas_.GetTexture(), boundaryRect);
+    spriteManager_.SetOrigin(entity, sf::Vector2f(boundaryRect.width / 2.0f, boundaryRect.height / 2.0f));
     spriteManager_.SetColor(entity, core::Color::black());
 
     return entity;
@@ -415,12 +514,13 @@ core::Entity ClientGameManager::SpawnBoundary(core::Vec2f position)
 core::Entity ClientGameManager::SpawnHome(PlayerNumber playerNumber, core::Vec2f position)
 {
     const auto entity = GameManager::SpawnHome(playerNumber, position);
-    const auto homeVisualizer = SpawnVisualizer(position, homeTexture_, playerColors[playerNumber]);
-    VisualizeEntity(homeVisualizer, homeTexture_, playerColors[playerNumber]);
+    const auto homeRect = GetAtlasRect("home");
+    const auto homeVisualizer = SpawnVisualizer(position, homeRect, playerColors[playerNumber]);
+    VisualizeEntity(homeVisualizer, homeRect, playerColors[playerNumber]);
 
     spriteManager_.AddComponent(entity);
-    spriteManager_.SetTexture(entity, homeTexture_);
-    spriteManager_.SetOrigin(entity, sf::Vector2f(homeTexture_.getSize()) / 2.0f);
+    spriteManager_.SetTexture(entity, textureAtlas_.GetTexture(), homeRect);
+    spriteManager_.SetOrigin(entity, sf::Vector2f(homeRect.width / 2.0f, homeRect.height / 2.0f));
     spriteManager_.SetColor(entity, playerColors[playerNumber]);
     return entity;
 }
@@ -430,8 +530,9 @@ core::Entity ClientGameManager::SpawnHealthBar(core::Vec2f position)
     const auto entity = GameManager::SpawnHealthBar(position);
 
     spriteManager_.AddComponent(entity);
-    spriteManager_.SetTexture(entity, healthbarTexture_);
-    spriteManager_.SetOrigin(entity, sf::Vector2f(0, healthbarTexture_.getSize().y / 2.0f));
+    const auto healthbarRect = GetAtlasRect("healthbar");
+    spriteManager_.SetTexture(entity, textureAtlas_.GetTexture(), healthbarRect);
+    spriteManager_.SetOrigin(entity, sf::Vector2f(0, healthbarRect.height / 2.0f));
     return entity;
 }
 
@@ -440,19 +541,41 @@ core::Entity ClientGameManager::SpawnHealthBarBackground(PlayerNumber playerNumb
     const auto entity = GameManager::SpawnHealthBarBackground(playerNumber, position);
 
     spriteManager_.AddComponent(entity);
-    spriteManager_.SetTexture(entity, healthbarBackgroundTexture_);
-    spriteManager_.SetOrigin(entity, sf::Vector2f(0, healthbarBackgroundTexture_.getSize().y / 2.0f));
+    const auto healthbarBackgroundRect = GetAtlasRect("healthbarBackground");
+    spriteManager_.SetTexture(entity, textureAtlas_.GetTexture(), healthbarBackgroundRect);
+    spriteManager_.SetOrigin(entity, sf::Vector2f(0, healthbarBackgroundRect.height / 2.0f));
     spriteManager_.SetColor(entity, playerColors[playerNumber]);
 
     return entity;
 }
 
 
-void ClientGameManager::VisualizeEntity(const core::Entity& entity, const sf::Texture& texture, sf::Color color)
+sf::IntRect ClientGameManager::GetAtlasRect(std::string_view name)
+{
+    //The headless clients do not load the atlas, their sprites are never drawn
+    if (isHeadless_)
+    {
+        return {};
+    }
+    WaitForAssets();
+    return textureAtlas_.GetRect(name);
+}
+
+void ClientGameManager::WaitForAssets()
+{
+    if (assetLoader_.IsReady())
+    {
+        return;
+    }
+    CORE_LOG_WARNING("Waiting for the assets to be loaded");
+    assetLoader_.Wait();
+}
+
+void ClientGameManager::VisualizeEntity(const core::Entity& entity, const sf::IntRect& textureRect, sf::Color color)
 {
     spriteManager_.AddComponent(entity);
-    spriteManager_.SetTexture(entity, texture);
-    spriteManager_.SetOrigin(entity, sf::Vector2f(texture.getSize()) / 2.0f);
+    spriteManager_.SetTexture(entity, textureAtlas_.GetTexture(), textureRect);
+    spriteManager_.SetOrigin(entity, sf::Vector2f(textureRect.width / 2.0f, textureRect.height / 2.0f));
     spriteManager_.SetColor(entity, color);
 }
 
@@ -468,13 +591,14 @@ void ClientGameManager::FixedUpdate()
     {
         if (startingTime_ != 0)
         {
-            using namespace std::chrono;
-            const auto ms = duration_cast<duration<unsigned long long, std::milli>>(
-                system_clock::now().time_since_epoch()
-                ).count();
-            if (ms > startingTime_)
+            if (GetNetworkTime() > startingTime_)
             {
+                //The assets ready gate, the match cannot start with missing sprites
+                WaitForAssets();
                 state_ = state_ | STARTED;
+                //The fixed steps are anchored to the synchronized starting time instead of the local tick phase,
+                //Update removes this step from the timer, the next ones are due every fixed period after the start
+                fixedTimer_ = static_cast<float>(GetNetworkTime() - startingTime_) / 1'000'000.0f;
             }
             else
             {
@@ -493,19 +617,7 @@ void ClientGameManager::FixedUpdate()
     }
     if(state_ & STARTED)
     {
-        //we set the ball visible when the start counter ends
-        if(ballVisibilityIndicator_ == 0)
-        {
-            for (core::Entity entity = 0; entity < entityManager_.GetEntitiesSize(); entity++)
-            {
-                if (entityManager_.HasComponent(entity, static_cast<core::EntityMask>(ComponentType::BALL)))
-                {
-                    spriteManager_.SetColor(entity, ballColorAfterGameStart);
-                    ballVisibilityIndicator_++;
-                }
-            }
-        }
-       
+        ShowBalls();
     }
 
     //We send the player inputs when the game started
@@ -513,7 +625,7 @@ void ClientGameManager::FixedUpdate()
     if (playerNumber == INVALID_PLAYER)
     {
         //We still did not receive the spawn player packet, but receive the start game packet
-        core::LogWarning(fmt::format("Invalid Player Entity in {}:line {}", __FILE__, __LINE__));
+        CORE_LOG_WARNING("Invalid Player Entity in {}:line {}", __FILE__, __LINE__);
         return;
     }
     const auto& inputs = rollbackManager_.GetInputs(playerNumber);
@@ -534,6 +646,49 @@ void ClientGameManager::FixedUpdate()
 
     currentFrame_++;
     rollbackManager_.StartNewFrame(currentFrame_);
+    UpdateFrameAdvantage();
+}
+
+void ClientGameManager::ShowBalls()
+{
+    //we set the ball visible when the start counter ends
+    if (ballVisibilityIndicator_ != 0)
+    {
+        return;
+    }
+    for (core::Entity entity = 0; entity < entityManager_.GetEntitiesSize(); entity++)
+    {
+        if (entityManager_.HasComponent(entity, static_cast<core::EntityMask>(ComponentType::BALL)))
+        {
+            spriteManager_.SetColor(entity, ballColorAfterGameStart);
+            ballVisibilityIndicator_++;
+        }
+    }
+}
+
+void ClientGameManager::UpdateFrameAdvantage()
+{
+    //We look for the slowest other player, the one whose inputs are the oldest
+    Frame remoteFrame = std::numeric_limits<Frame>::max();
+    for (PlayerNumber playerNumber = 0; playerNumber < maxPlayerNmb; playerNumber++)
+    {
+        if (playerNumber == GetPlayerNumber())
+            continue;
+        remoteFrame = std::min(remoteFrame, rollbackManager_.GetLastReceivedFrame(playerNumber));
+    }
+    if (remoteFrame == 0 || remoteFrame == std::numeric_limits<Frame>::max())
+    {
+        //We did not receive any input yet
+        return;
+    }
+    //Inputs of the other players travel through the server, which takes about one RTT
+    const auto latencyFrames = currentPing_ / 1000.0f / fixedPeriod;
+    const auto advantage = static_cast<float>(currentFrame_) - (static_cast<float>(remoteFrame) + latencyFrames);
+    frameAdvantage_ = core::Lerp(frameAdvantage_, advantage, frameAdvantageSmoothing);
+
+    fixedPeriodStretch_ = frameAdvantage_ > frameAdvantageTolerance ?
+        std::min((frameAdvantage_ - frameAdvantageTolerance) * fixedPeriodStretchPerFrame, maxFixedPeriodStretch) :
+        0.0f;
 }
 
 void ClientGameManager::SetPlayerInput(PlayerNumber playerNumber, PlayerInput playerInput, std::uint32_t inputFrame)
@@ -543,9 +698,9 @@ void ClientGameManager::SetPlayerInput(PlayerNumber playerNumber, PlayerInput pl
     GameManager::SetPlayerInput(playerNumber, playerInput, inputFrame);
 }
 
-void ClientGameManager::StartGame(unsigned long long int startingTime)
+void ClientGameManager::StartGame(NetworkTime startingTime)
 {
-    core::LogDebug(fmt::format("Start game at starting time: {}", startingTime));
+    CORE_LOG_DEBUG("Start game at starting time: {}", startingTime);
     startingTime_ = startingTime;
 }
 
@@ -554,14 +709,23 @@ void ClientGameManager::DrawImGui()
     ImGui::Text(state_ & STARTED ? "Game has started" : "Game has not started");
     if (startingTime_ != 0)
     {
-        ImGui::Text("Starting Time: %llu", startingTime_);
-        using namespace std::chrono;
-        unsigned long long ms = duration_cast<milliseconds>(
-            system_clock::now().time_since_epoch()
-            ).count();
-        ImGui::Text("Current Time: %llu", ms);
+        ImGui::Text("Starting Time: %lld us", static_cast<long long>(startingTime_));
+        ImGui::Text("Current Time: %lld us", static_cast<long long>(GetNetworkTime()));
     }
+    ImGui::Text("Frame Advantage: %f", frameAdvantage_);
+    ImGui::Text("Fixed Period Stretch: %f", fixedPeriodStretch_);
+    ImGui::Text("Resync: %u%s", resyncCount_, resyncPending_ ? " (pending)" : "");
+    ImGui::Checkbox("Interpolate Visuals", &interpolateVisuals_);
     ImGui::Checkbox("Draw Physics", &drawPhysics_);
+    if (drawPhysics_)
+    {
+        auto& currentPhysicsManager = rollbackManager_.GetCurrentPhysicsManager();
+        unsigned debugLayers = currentPhysicsManager.GetDebugLayers();
+        ImGui::CheckboxFlags("Boxes", &debugLayers, static_cast<unsigned>(PhysicsDebugLayer::BOXES));
+        ImGui::CheckboxFlags("Velocities", &debugLayers, static_cast<unsigned>(PhysicsDebugLayer::VELOCITIES));
+        ImGui::CheckboxFlags("Contacts", &debugLayers, static_cast<unsigned>(PhysicsDebugLayer::CONTACTS));
+        currentPhysicsManager.SetDebugLayers(static_cast<std::uint8_t>(debugLayers));
+    }
 }
 
 
@@ -570,7 +734,7 @@ void ClientGameManager::ConfirmValidateFrame(Frame newValidateFrame,
 {
     if (newValidateFrame < rollbackManager_.GetLastValidateFrame())
     {
-        core::LogWarning(fmt::format("New validate frame is too old"));
+        CORE_LOG_WARNING("New validate frame is too old");
         return;
     }
     for (PlayerNumber playerNumber = 0; playerNumber < maxPlayerNmb; playerNumber++)
@@ -578,17 +742,140 @@ void ClientGameManager::ConfirmValidateFrame(Frame newValidateFrame,
         if (rollbackManager_.GetLastReceivedFrame(playerNumber) < newValidateFrame)
         {
             
-            core::LogWarning(fmt::format("Trying to validate frame {} while playerNumber {} is at input frame {}, client player {}",
+            CORE_LOG_WARNING("Trying to validate frame {} while playerNumber {} is at input frame {}, client player {}",
                 newValidateFrame,
                 playerNumber + 1,
                 rollbackManager_.GetLastReceivedFrame(playerNumber),
-                GetPlayerNumber()+1));
+                GetPlayerNumber()+1);
             
 
             return;
         }
     }
-    rollbackManager_.ConfirmFrame(newValidateFrame, physicsStates);
+    const auto previousValidateFrame = rollbackManager_.GetLastValidateFrame();
+    if (replayRecorder_.IsOpen() && !replayRecorder_.HasKeyframe())
+    {
+        //The replay starts from the validated world before the first recorded frame
+        replayRecorder_.RecordKeyframe(previousValidateFrame, rollbackManager_.SerializeValidateState());
+    }
+    const auto isConfirmed = rollbackManager_.ConfirmFrame(newValidateFrame, physicsStates);
+    RecordReplayFrames(previousValidateFrame, newValidateFrame, isConfirmed);
+    if (isConfirmed)
+    {
+        return;
+    }
+    desyncCount_++;
+    if (!resyncPending_ && !isDesyncFatal_)
+    {
+        CORE_LOG_WARNING("Client P{} desynchronized at frame {}, requesting a world snapshot",
+            GetPlayerNumber() + 1, newValidateFrame);
+        RequestResync(newValidateFrame);
+    }
+}
+
+void ClientGameManager::RequestResync(Frame desyncFrame)
+{
+    auto resyncRequestPacket = std::make_unique<ResyncRequestPacket>();
+    resyncRequestPacket->playerNumber = GetPlayerNumber();
+    resyncRequestPacket->desyncFrame = core::ConvertToBinary(desyncFrame);
+    packetSenderInterface_.SendReliablePacket(std::move(resyncRequestPacket));
+    resyncPending_ = true;
+}
+
+void ClientGameManager::ApplyWorldSnapshot(Frame validateFrame, const std::vector<std::uint8_t>& snapshot)
+{
+
+#ifdef TRACY_ENABLE
+    ZoneScoped;
+#endif
+    //The snapshot is sent to all clients, only the desynchronized ones apply it
+    if (!resyncPending_)
+    {
+        return;
+    }
+    resyncPending_ = false;
+    if (!rollbackManager_.ApplyValidateState(validateFrame, snapshot))
+    {
+        //The snapshot does not match the local world layout (e.g. not the same balls), the next snapshots would not either
+        CORE_LOG_ERROR("Client P{} could not apply the world snapshot of frame {}, the desynchronization cannot be recovered",
+            GetPlayerNumber() + 1, validateFrame);
+        isDesyncFatal_ = true;
+        return;
+    }
+    resyncCount_++;
+    CORE_LOG_DEBUG("Client P{} resynchronized at frame {}", GetPlayerNumber() + 1, validateFrame);
+    if (replayRecorder_.IsOpen() && replayRecorder_.HasKeyframe())
+    {
+        //The frames recorded since the desynchronization are followed by the resynchronized world
+        replayRecorder_.RecordKeyframe(rollbackManager_.GetLastValidateFrame(), rollbackManager_.SerializeValidateState());
+    }
+}
+
+void ClientGameManager::RecordReplayFrames(Frame previousValidateFrame, Frame newValidateFrame, bool isConfirmed)
+{
+    if (!replayRecorder_.IsOpen())
+    {
+        return;
+    }
+    for (Frame frame = previousValidateFrame + 1; frame <= newValidateFrame; frame++)
+    {
+        ReplayFrameInputs inputs{};
+        for (PlayerNumber playerNumber = 0; playerNumber < maxPlayerNmb; playerNumber++)
+        {
+            inputs[playerNumber] = rollbackManager_.GetInputAtFrame(playerNumber, frame);
+        }
+        replayRecorder_.RecordInputs(frame, inputs);
+    }
+    //A desynchronized world is not a keyframe, the next one is recorded when the world snapshot is applied
+    if (isConfirmed && !resyncPending_ && replayRecorder_.IsKeyframeDue(newValidateFrame))
+    {
+        replayRecorder_.RecordKeyframe(newValidateFrame, rollbackManager_.SerializeValidateState());
+    }
+}
+
+bool ClientGameManager::StartReplayRecording(std::string_view path)
+{
+    return replayRecorder_.Open(path);
+}
+
+bool ClientGameManager::LoadReplayKeyframe(Frame keyframe, const std::vector<std::uint8_t>& snapshot)
+{
+
+#ifdef TRACY_ENABLE
+    ZoneScoped;
+#endif
+    if (!rollbackManager_.LoadValidateState(keyframe, snapshot))
+    {
+        return false;
+    }
+    currentFrame_ = keyframe;
+    state_ = state_ | STARTED;
+    ShowBalls();
+    return true;
+}
+
+void ClientGameManager::ReplayInputs(Frame firstFrame, std::span<const ReplayFrameInputs> inputs)
+{
+
+#ifdef TRACY_ENABLE
+    ZoneScoped;
+#endif
+    gpr_assert(firstFrame == currentFrame_ + 1, "Replay inputs need to follow the current frame");
+    //The frames are validated before they leave the input window
+    constexpr Frame maxUnvalidatedFrameNmb = windowBufferSize - 1;
+    for (std::size_t i = 0; i < inputs.size(); i++)
+    {
+        const auto frame = firstFrame + static_cast<Frame>(i);
+        for (PlayerNumber playerNumber = 0; playerNumber < maxPlayerNmb; playerNumber++)
+        {
+            rollbackManager_.SetPlayerInput(playerNumber, inputs[i][playerNumber], frame);
+        }
+        if (frame - rollbackManager_.GetLastValidateFrame() >= maxUnvalidatedFrameNmb || i + 1 == inputs.size())
+        {
+            Validate(frame);
+        }
+    }
+    currentFrame_ = rollbackManager_.GetCurrentFrame();
 }
 
 void ClientGameManager::WinGame(PlayerNumber winner)
@@ -1,7 +1,12 @@
 #include "game/physics_manager.h"
 #include "engine/transform.h"
 
-#include <SFML/Graphics/RectangleShape.hpp>
+#include "graphics/color.h"
+#include "graphics/render_snapshot.h"
+
+#include <algorithm>
+#include <cmath>
+#include <span>
 
 #ifdef TRACY_ENABLE
 #include <Tracy.hpp>
@@ -31,31 +36,33 @@ void PhysicsManager::FixedUpdate(sf::Time dt)
 #endif
     for (core::Entity entity = 0; entity < entityManager_.GetEntitiesSize(); entity++)
     {
-        if (!entityManager_.HasComponent(entity, static_cast<core::EntityMask>(core::ComponentType::BODY2D)))
+        if (!entityManager_.HasComponentUnchecked(entity, static_cast<core::EntityMask>(core::ComponentType::BODY2D)))
             continue;
-        auto body = bodyManager_.GetComponent(entity);
+        auto body = bodyManager_.GetComponentUnchecked(entity);
         
         body.position += body.velocity * dt.asSeconds();
         body.rotation += body.angularVelocity * dt.asSeconds();
-        bodyManager_.SetComponent(entity, body);
+        bodyManager_.SetComponentUnchecked(entity, body);
     }
+    const bool recordContacts = HasDebugLayer(PhysicsDebugLayer::CONTACTS);
+    contactPoints_.clear();
     for (core::Entity entity = 0; entity < entityManager_.GetEntitiesSize(); entity++)
     {
-        if (!entityManager_.HasComponent(entity,
+        if (!entityManager_.HasComponentUnchecked(entity,
             static_cast<core::EntityMask>(core::ComponentType::BODY2D) |
             static_cast<core::EntityMask>(core::ComponentType::BOX_COLLIDER2D)) ||
-            entityManager_.HasComponent(entity, static_cast<core::EntityMask>(ComponentType::DESTROYED)))
+            entityManager_.HasComponentUnchecked(entity, static_cast<core::EntityMask>(ComponentType::DESTROYED)))
             continue;
         for (core::Entity otherEntity = entity + 1; otherEntity < entityManager_.GetEntitiesSize(); otherEntity++)
         {
-            if (!entityManager_.HasComponent(otherEntity,
+            if (!entityManager_.HasComponentUnchecked(otherEntity,
                 static_cast<core::EntityMask>(core::ComponentType::BODY2D) | static_cast<core::EntityMask>(core::ComponentType::BOX_COLLIDER2D)) ||
-                entityManager_.HasComponent(otherEntity, static_cast<core::EntityMask>(ComponentType::DESTROYED)))
+                entityManager_.HasComponentUnchecked(otherEntity, static_cast<core::EntityMask>(ComponentType::DESTROYED)))
                 continue;
-            const Body& body1 = bodyManager_.GetComponent(entity);
-            const Box& box1 = boxManager_.GetComponent(entity);
-            const Body& body2 = bodyManager_.GetComponent(otherEntity);
-            const Box& box2 = boxManager_.GetComponent(otherEntity);
+            const Body& body1 = bodyManager_.GetComponentUnchecked(entity);
+            const Box& box1 = boxManager_.GetComponentUnchecked(entity);
+            const Body& body2 = bodyManager_.GetComponentUnchecked(otherEntity);
+            const Box& box2 = boxManager_.GetComponentUnchecked(otherEntity);
 
 
             if (Box2Box(
@@ -68,6 +75,15 @@ void PhysicsManager::FixedUpdate(sf::Time dt)
                 box2.extends.x * 2.0f,
                 box2.extends.y * 2.0f))
             {
+                if (recordContacts)
+                {
+                    //Center of the overlap of the two boxes
+                    const auto minX = std::max(body1.position.x - box1.extends.x, body2.position.x - box2.extends.x);
+                    const auto maxX = std::min(body1.position.x + box1.extends.x, body2.position.x + box2.extends.x);
+                    const auto minY = std::max(body1.position.y - box1.extends.y, body2.position.y - box2.extends.y);
+                    const auto maxY = std::min(body1.position.y + box1.extends.y, body2.position.y + box2.extends.y);
+                    contactPoints_.emplace_back((minX + maxX) / 2.0f, (minY + maxY) / 2.0f);
+                }
                 onTriggerAction_.Execute(entity, otherEntity);
             }
 
@@ -119,26 +135,97 @@ void PhysicsManager::CopyAllComponents(const PhysicsManager& physicsManager)
 
 void PhysicsManager::Draw(sf::RenderTarget& renderTarget)
 {
+
+#ifdef TRACY_ENABLE
+    ZoneScoped;
+#endif
+    BuildDebugVertices();
+    renderTarget.draw(debugVertices_);
+}
+
+void PhysicsManager::RecordDraw(core::RenderSnapshot& snapshot)
+{
+
+#ifdef TRACY_ENABLE
+    ZoneScoped;
+#endif
+    BuildDebugVertices();
+    if (debugVertices_.getVertexCount() > 0)
+    {
+        snapshot.AddVertices(std::span(&debugVertices_[0], debugVertices_.getVertexCount()), sf::Triangles);
+    }
+}
+
+void PhysicsManager::BuildDebugVertices()
+{
+    constexpr float lineThickness = 2.0f;
+    constexpr float contactSize = 6.0f;
+    //The velocity vectors show the motion of the next velocityDrawPeriod seconds
+    constexpr float velocityDrawPeriod = 0.25f;
+    debugVertices_.clear();
+    const bool drawBoxes = HasDebugLayer(PhysicsDebugLayer::BOXES);
+    const bool drawVelocities = HasDebugLayer(PhysicsDebugLayer::VELOCITIES);
     for (core::Entity entity = 0; entity < entityManager_.GetEntitiesSize(); entity++)
     {
-        if (!entityManager_.HasComponent(entity,
-            static_cast<core::EntityMask>(core::ComponentType::BODY2D) |
-            static_cast<core::EntityMask>(core::ComponentType::BOX_COLLIDER2D)) ||
-            entityManager_.HasComponent(entity, static_cast<core::EntityMask>(ComponentType::DESTROYED)))
+        if (!entityManager_.HasComponentUnchecked(entity, static_cast<core::EntityMask>(core::ComponentType::BODY2D)) ||
+            entityManager_.HasComponentUnchecked(entity, static_cast<core::EntityMask>(ComponentType::DESTROYED)))
             continue;
-        const auto& [extends, isTrigger] = boxManager_.GetComponent(entity);
-        const auto& body = bodyManager_.GetComponent(entity);
-        sf::RectangleShape rectShape;
-        rectShape.setFillColor(core::Color::transparent());
-        rectShape.setOutlineColor(core::Color::green());
-        rectShape.setOutlineThickness(2.0f);
-        const auto position = body.position;
-        rectShape.setOrigin({ extends.x * core::pixelPerMeter, extends.y * core::pixelPerMeter });
-        rectShape.setPosition(
-            position.x * core::pixelPerMeter + center_.x,
-            windowSize_.y - (position.y * core::pixelPerMeter + center_.y));
-        rectShape.setSize({ extends.x * 2.0f * core::pixelPerMeter, extends.y * 2.0f * core::pixelPerMeter });
-        renderTarget.draw(rectShape);
+        const auto& body = bodyManager_.GetComponentUnchecked(entity);
+        if (drawBoxes && entityManager_.HasComponentUnchecked(entity, static_cast<core::EntityMask>(core::ComponentType::BOX_COLLIDER2D)))
+        {
+            const auto& extends = boxManager_.GetComponentUnchecked(entity).extends;
+            const auto topLeft = ToScreenPosition(body.position + core::Vec2f(-extends.x, extends.y));
+            const auto topRight = ToScreenPosition(body.position + extends);
+            const auto bottomLeft = ToScreenPosition(body.position - extends);
+            const auto bottomRight = ToScreenPosition(body.position + core::Vec2f(extends.x, -extends.y));
+            AppendDebugLine(topLeft, topRight, lineThickness, core::Color::green());
+            AppendDebugLine(topRight, bottomRight, lineThickness, core::Color::green());
+            AppendDebugLine(bottomRight, bottomLeft, lineThickness, core::Color::green());
+            AppendDebugLine(bottomLeft, topLeft, lineThickness, core::Color::green());
+        }
+        if (drawVelocities && (body.velocity.x != 0.0f || body.velocity.y != 0.0f))
+        {
+            AppendDebugLine(ToScreenPosition(body.position),
+                ToScreenPosition(body.position + body.velocity * velocityDrawPeriod),
+                lineThickness, core::Color::yellow());
+        }
+    }
+    if (HasDebugLayer(PhysicsDebugLayer::CONTACTS))
+    {
+        for (const auto& contactPoint : contactPoints_)
+        {
+            const auto center = ToScreenPosition(contactPoint);
+            AppendDebugLine(center - sf::Vector2f(contactSize, 0.0f), center + sf::Vector2f(contactSize, 0.0f),
+                lineThickness, core::Color::red());
+            AppendDebugLine(center - sf::Vector2f(0.0f, contactSize), center + sf::Vector2f(0.0f, contactSize),
+                lineThickness, core::Color::red());
+        }
     }
 }
+
+sf::Vector2f PhysicsManager::ToScreenPosition(core::Vec2f position) const
+{
+    return {
+        position.x * core::pixelPerMeter + center_.x,
+        windowSize_.y - (position.y * core::pixelPerMeter + center_.y) };
+}
+
+void PhysicsManager::AppendDebugLine(sf::Vector2f start, sf::Vector2f end, float thickness, sf::Color color)
+{
+    const auto direction = end - start;
+    const auto length = std::sqrt(direction.x * direction.x + direction.y * direction.y);
+    if (length <= 0.0f)
+        return;
+    //The quad is extended by half the thickness at both ends so that the box corners are closed
+    const sf::Vector2f tangent(direction.x / length * thickness / 2.0f, direction.y / length * thickness / 2.0f);
+    const sf::Vector2f normal(-tangent.y, tangent.x);
+    const auto lineStart = start - tangent;
+    const auto lineEnd = end + tangent;
+    debugVertices_.append(sf::Vertex(lineStart + normal, color));
+    debugVertices_.append(sf::Vertex(lineStart - normal, color));
+    debugVertices_.append(sf::Vertex(lineEnd + normal, color));
+    debugVertices_.append(sf::Vertex(lineEnd + normal, color));
+    debugVertices_.append(sf::Vertex(lineStart - normal, color));
+    debugVertices_.append(sf::Vertex(lineEnd - normal, color));
+}
 }
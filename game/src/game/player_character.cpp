@@ -28,7 +28,7 @@ void PlayerCharacterManager::FixedUpdate(sf::Time dt)
             continue;
         auto playerBody = physicsManager_.GetBody(playerEntity);
         const auto playerBox = physicsManager_.GetBox(playerEntity);
-        auto playerCharacter = GetComponent(playerEntity);
+        auto playerCharacter = GetComponentUnchecked(playerEntity);
         const auto input = playerCharacter.input;
 
         const bool up = (input & PlayerInputEnum::PlayerInput::UP) && playerBody.position.y + playerBox.extends.y < topBoundaryPos.y;
@@ -46,7 +46,7 @@ void PlayerCharacterManager::FixedUpdate(sf::Time dt)
         if (playerCharacter.hurtTime > 0.0f)
         {
             playerCharacter.hurtTime -= dt.asSeconds();
-            SetComponent(playerEntity, playerCharacter);
+            SetComponentUnchecked(playerEntity, playerCharacter);
         }
     }
 }
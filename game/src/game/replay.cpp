@@ -0,0 +1,301 @@
+#include "game/replay.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <type_traits>
+
+#include <fmt/format.h>
+
+#include "utils/assert.h"
+#include "utils/log.h"
+
+#ifdef TRACY_ENABLE
+#include <Tracy.hpp>
+#endif
+
+namespace game
+{
+namespace
+{
+template<typename T>
+bool ReadReplayValue(const core::MappedFile& file, std::size_t offset, T& value)
+{
+    static_assert(std::is_trivially_copyable_v<T>);
+    if (offset + sizeof(T) > file.GetSize())
+    {
+        return false;
+    }
+    std::memcpy(&value, file.GetData() + offset, sizeof(T));
+    return true;
+}
+}
+
+ReplayRecorder::~ReplayRecorder()
+{
+    Close();
+}
+
+bool ReplayRecorder::Open(std::string_view path, Frame keyframePeriod)
+{
+    Close();
+    file_.open(std::string(path), std::ios::binary | std::ios::trunc);
+    if (!file_.is_open())
+    {
+        CORE_LOG_ERROR("Could not open replay file: {}", path);
+        return false;
+    }
+    keyframePeriod_ = keyframePeriod;
+    ReplayHeader header{};
+    header.keyframePeriod = keyframePeriod_;
+    Write(header);
+    return true;
+}
+
+void ReplayRecorder::Close()
+{
+    if (!file_.is_open())
+    {
+        return;
+    }
+    WritePendingInputs();
+    ReplayFooter footer{};
+    footer.indexOffset = static_cast<std::uint64_t>(file_.tellp());
+    footer.lastFrame = lastFrame_;
+    footer.keyframeNmb = static_cast<std::uint32_t>(index_.size());
+    WriteChunkHeader(ReplayChunkType::INDEX, index_.size() * sizeof(ReplayIndexEntry));
+    file_.write(reinterpret_cast<const char*>(index_.data()),
+        static_cast<std::streamsize>(index_.size() * sizeof(ReplayIndexEntry)));
+    Write(footer);
+    file_.close();
+    index_.clear();
+    pendingInputs_.clear();
+    lastFrame_ = 0;
+}
+
+void ReplayRecorder::RecordInputs(Frame frame, const ReplayFrameInputs& inputs)
+{
+    if (!file_.is_open() || index_.empty())
+    {
+        return;
+    }
+    if (frame != lastFrame_ + 1)
+    {
+        CORE_LOG_WARNING("Replay inputs of frame {} do not follow frame {}", frame, lastFrame_);
+        return;
+    }
+    pendingInputs_.push_back(inputs);
+    lastFrame_ = frame;
+}
+
+void ReplayRecorder::RecordKeyframe(Frame frame, const std::vector<std::uint8_t>& snapshot)
+{
+
+#ifdef TRACY_ENABLE
+    ZoneScoped;
+#endif
+    if (!file_.is_open())
+    {
+        return;
+    }
+    if (!index_.empty() && frame != lastFrame_)
+    {
+        CORE_LOG_WARNING("Replay keyframe {} does not match the last recorded frame {}", frame, lastFrame_);
+    }
+    WritePendingInputs();
+    ReplayIndexEntry entry;
+    entry.frame = frame;
+    entry.snapshotSize = static_cast<std::uint32_t>(snapshot.size());
+    entry.offset = static_cast<std::uint64_t>(file_.tellp());
+    index_.push_back(entry);
+
+    WriteChunkHeader(ReplayChunkType::KEYFRAME, sizeof(Frame) + snapshot.size());
+    Write(frame);
+    file_.write(reinterpret_cast<const char*>(snapshot.data()), static_cast<std::streamsize>(snapshot.size()));
+    lastFrame_ = frame;
+}
+
+bool ReplayRecorder::IsKeyframeDue(Frame frame) const
+{
+    return index_.empty() || frame >= index_.back().frame + keyframePeriod_;
+}
+
+void ReplayRecorder::WritePendingInputs()
+{
+    if (pendingInputs_.empty())
+    {
+        return;
+    }
+    const auto firstFrame = static_cast<Frame>(lastFrame_ - pendingInputs_.size() + 1);
+    WriteChunkHeader(ReplayChunkType::INPUTS, sizeof(Frame) + pendingInputs_.size() * sizeof(ReplayFrameInputs));
+    Write(firstFrame);
+    file_.write(reinterpret_cast<const char*>(pendingInputs_.data()),
+        static_cast<std::streamsize>(pendingInputs_.size() * sizeof(ReplayFrameInputs)));
+    pendingInputs_.clear();
+}
+
+void ReplayRecorder::WriteChunkHeader(ReplayChunkType type, std::size_t size)
+{
+    gpr_assert(size <= std::numeric_limits<std::uint32_t>::max(), "Replay chunk is too big");
+    const ReplayChunkHeader chunkHeader{ type, static_cast<std::uint32_t>(size) };
+    Write(chunkHeader);
+}
+
+template<typename T>
+void ReplayRecorder::Write(const T& value)
+{
+    static_assert(std::is_trivially_copyable_v<T>);
+    file_.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+bool ReplayReader::Open(std::string_view path)
+{
+    index_.clear();
+    lastFrame_ = 0;
+    if (!file_.Open(path, core::MappedFile::Mode::READ))
+    {
+        return false;
+    }
+    if (!ReadReplayValue(file_, 0, header_) ||
+        header_.magic != ReplayHeader::replayMagic ||
+        header_.version != ReplayHeader::replayVersion ||
+        header_.playerNmb != maxPlayerNmb)
+    {
+        CORE_LOG_ERROR("{} is not a replay of version {}", path, ReplayHeader::replayVersion);
+        file_.Close();
+        return false;
+    }
+    if (!ReadIndex())
+    {
+        CORE_LOG_WARNING("Replay {} was not closed, scanning its chunks", path);
+        ScanChunks();
+    }
+    if (index_.empty())
+    {
+        CORE_LOG_ERROR("Replay {} has no keyframe", path);
+        file_.Close();
+        return false;
+    }
+    return true;
+}
+
+std::size_t ReplayReader::FindSegment(Frame frame) const
+{
+    const auto it = std::upper_bound(index_.begin(), index_.end(), frame,
+        [](Frame value, const ReplayIndexEntry& entry)
+        {
+            return value < entry.frame;
+        });
+    return it == index_.begin() ? 0 : static_cast<std::size_t>(std::distance(index_.begin(), it) - 1);
+}
+
+bool ReplayReader::ReadSegment(std::size_t segmentIndex, ReplaySegment& segment) const
+{
+
+#ifdef TRACY_ENABLE
+    ZoneScoped;
+#endif
+    if (segmentIndex >= index_.size())
+    {
+        return false;
+    }
+    const auto& entry = index_[segmentIndex];
+    auto offset = static_cast<std::size_t>(entry.offset);
+    ReplayChunkHeader chunkHeader;
+    if (!ReadReplayValue(file_, offset, chunkHeader) ||
+        chunkHeader.type != ReplayChunkType::KEYFRAME ||
+        chunkHeader.size != sizeof(Frame) + entry.snapshotSize ||
+        offset + sizeof(chunkHeader) + chunkHeader.size > file_.GetSize())
+    {
+        CORE_LOG_WARNING("Replay keyframe {} is malformed", entry.frame);
+        return false;
+    }
+    const auto* snapshotData = file_.GetData() + offset + sizeof(chunkHeader) + sizeof(Frame);
+    segment.keyframe = entry.frame;
+    segment.snapshot.assign(snapshotData, snapshotData + entry.snapshotSize);
+    segment.inputs.clear();
+    offset += sizeof(chunkHeader) + chunkHeader.size;
+
+    //The inputs chunks follow their keyframe until the next keyframe or the index
+    while (ReadReplayValue(file_, offset, chunkHeader) &&
+        offset + sizeof(chunkHeader) + chunkHeader.size <= file_.GetSize())
+    {
+        if (chunkHeader.type == ReplayChunkType::KEYFRAME || chunkHeader.type == ReplayChunkType::INDEX)
+        {
+            break;
+        }
+        if (chunkHeader.type == ReplayChunkType::INPUTS && chunkHeader.size >= sizeof(Frame))
+        {
+            Frame firstFrame = 0;
+            ReadReplayValue(file_, offset + sizeof(chunkHeader), firstFrame);
+            if (firstFrame != segment.GetLastFrame() + 1)
+            {
+                CORE_LOG_WARNING("Replay inputs of frame {} do not follow frame {}", firstFrame, segment.GetLastFrame());
+                break;
+            }
+            const auto frameNmb = (chunkHeader.size - sizeof(Frame)) / sizeof(ReplayFrameInputs);
+            const auto* inputsData = file_.GetData() + offset + sizeof(chunkHeader) + sizeof(Frame);
+            const auto previousSize = segment.inputs.size();
+            segment.inputs.resize(previousSize + frameNmb);
+            std::memcpy(segment.inputs.data() + previousSize, inputsData, frameNmb * sizeof(ReplayFrameInputs));
+        }
+        offset += sizeof(chunkHeader) + chunkHeader.size;
+    }
+    return true;
+}
+
+bool ReplayReader::ReadIndex()
+{
+    ReplayFooter footer;
+    if (file_.GetSize() < header_.headerSize + sizeof(footer) ||
+        !ReadReplayValue(file_, file_.GetSize() - sizeof(footer), footer) ||
+        footer.magic != ReplayHeader::replayMagic)
+    {
+        return false;
+    }
+    ReplayChunkHeader chunkHeader;
+    const auto indexOffset = static_cast<std::size_t>(footer.indexOffset);
+    if (!ReadReplayValue(file_, indexOffset, chunkHeader) ||
+        chunkHeader.type != ReplayChunkType::INDEX ||
+        chunkHeader.size != footer.keyframeNmb * sizeof(ReplayIndexEntry) ||
+        indexOffset + sizeof(chunkHeader) + chunkHeader.size > file_.GetSize() - sizeof(footer))
+    {
+        return false;
+    }
+    index_.resize(footer.keyframeNmb);
+    std::memcpy(index_.data(), file_.GetData() + indexOffset + sizeof(chunkHeader), chunkHeader.size);
+    lastFrame_ = footer.lastFrame;
+    return true;
+}
+
+void ReplayReader::ScanChunks()
+{
+    std::size_t offset = header_.headerSize;
+    ReplayChunkHeader chunkHeader;
+    while (ReadReplayValue(file_, offset, chunkHeader) &&
+        offset + sizeof(chunkHeader) + chunkHeader.size <= file_.GetSize())
+    {
+        Frame frame = 0;
+        ReadReplayValue(file_, offset + sizeof(chunkHeader), frame);
+        if (chunkHeader.type == ReplayChunkType::KEYFRAME && chunkHeader.size >= sizeof(Frame))
+        {
+            ReplayIndexEntry entry;
+            entry.frame = frame;
+            entry.snapshotSize = static_cast<std::uint32_t>(chunkHeader.size - sizeof(Frame));
+            entry.offset = offset;
+            index_.push_back(entry);
+            lastFrame_ = std::max(lastFrame_, frame);
+        }
+        else if (chunkHeader.type == ReplayChunkType::INPUTS && chunkHeader.size >= sizeof(Frame))
+        {
+            const auto frameNmb = static_cast<Frame>((chunkHeader.size - sizeof(Frame)) / sizeof(ReplayFrameInputs));
+            if (frameNmb > 0)
+            {
+                lastFrame_ = std::max(lastFrame_, frame + frameNmb - 1);
+            }
+        }
+        offset += sizeof(chunkHeader) + chunkHeader.size;
+    }
+}
+}
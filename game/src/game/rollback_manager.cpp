@@ -1,7 +1,9 @@
 #include <game/rollback_manager.h>
 #include <game/game_manager.h>
 #include "utils/assert.h"
+#include "utils/conversion.h"
 #include <utils/log.h>
+#include <algorithm>
 #include <fmt/format.h>
 
 #ifdef TRACY_ENABLE
@@ -11,7 +13,17 @@
 namespace game
 {
 
-RollbackManager::RollbackManager(GameManager& gameManager, core::EntityManager& entityManager) :
+LastValidateWorld::LastValidateWorld(core::EntityManager& entityManager, GameManager& gameManager) :
+    physicsManager(entityManager),
+    playerManager(entityManager, physicsManager, gameManager),
+    ballManager(entityManager, gameManager),
+    boundaryManager(entityManager, gameManager),
+    homeManager(entityManager, gameManager),
+    healthBarManager(entityManager, gameManager)
+{
+}
+
+RollbackManager::RollbackManager(GameManager& gameManager, core::EntityManager& entityManager, RollbackMode rollbackMode) :
     gameManager_(gameManager),entityManager_(entityManager),
     currentTransformManager_(entityManager),
     currentPhysicsManager_(entityManager), currentPlayerManager_(entityManager, currentPhysicsManager_, gameManager_),
@@ -19,19 +31,19 @@ RollbackManager::RollbackManager(GameManager& gameManager, core::EntityManager&
     currentBoundaryManager_(entityManager, gameManager),
     currentHomeManager_(entityManager, gameManager),
     currentHealthBarManager(entityManager, gameManager),
-
-    lastValidatePhysicsManager_(entityManager),
-    lastValidatePlayerManager_(entityManager, lastValidatePhysicsManager_, gameManager_),
-	lastValidateBallManager_(entityManager, gameManager),
-    lastValidateBoundaryManager_(entityManager, gameManager),
-    lastValidateHomeManager_(entityManager, gameManager),
-    lastValidateHealthBarManager_(entityManager, gameManager)
+    rollbackMode_(rollbackMode)
 
 {
     for (auto& input : inputs_)
     {
         std::fill(input.begin(), input.end(), '\0');
     }
+    //The authoritative server only simulates confirmed frames and does not need a second copy of the world
+    if (rollbackMode_ == RollbackMode::ROLLBACK)
+    {
+        lastValidate_ = std::make_unique<LastValidateWorld>(entityManager, gameManager);
+        currentTransformManager_.SetChangeTracking(true);
+    }
     currentPhysicsManager_.RegisterTriggerListener(*this);
     //currentPlayerManager_.RegisterHealthChangeTriggerListener(clientGameManager.GetHealthChangeTrigger());
 }
@@ -43,8 +55,17 @@ void RollbackManager::SimulateToCurrentFrame()
 #ifdef TRACY_ENABLE
     ZoneScoped;
 #endif
+    if (rollbackMode_ != RollbackMode::ROLLBACK)
+    {
+        gpr_assert(false, "SimulateToCurrentFrame needs a last validated world to rollback to");
+        return;
+    }
     const auto currentFrame = gameManager_.GetCurrentFrame();
     const auto lastValidateFrame = gameManager_.GetLastValidateFrame();
+    const auto rollbackFrameNmb = currentFrame - lastValidateFrame;
+    rollbackStats_.rollbackNmb++;
+    rollbackStats_.resimulatedFrameNmb += rollbackFrameNmb;
+    rollbackStats_.maxRollbackFrameNmb = std::max(rollbackStats_.maxRollbackFrameNmb, rollbackFrameNmb);
     //Destroying all created Entities after the last validated frame
     for (const auto& createdEntity : createdEntities_)
     {
@@ -57,19 +78,19 @@ void RollbackManager::SimulateToCurrentFrame()
     //Remove DESTROY flags
     for (core::Entity entity = 0; entity < entityManager_.GetEntitiesSize(); entity++)
     {
-        if (entityManager_.HasComponent(entity, static_cast<core::EntityMask>(ComponentType::DESTROYED)))
+        if (entityManager_.HasComponentUnchecked(entity, static_cast<core::EntityMask>(ComponentType::DESTROYED)))
         {
             entityManager_.RemoveComponent(entity, static_cast<core::EntityMask>(ComponentType::DESTROYED));
         }
     }
 
     //Revert the current game state to the last validated game state
-    currentBallManager_.CopyAllComponents(lastValidateBallManager_.GetAllComponents());
-    currentPhysicsManager_.CopyAllComponents(lastValidatePhysicsManager_);
-    currentPlayerManager_.CopyAllComponents(lastValidatePlayerManager_.GetAllComponents());
-    currentBoundaryManager_.CopyAllComponents(lastValidateBoundaryManager_.GetAllComponents());
-    currentHomeManager_.CopyAllComponents(lastValidateHomeManager_.GetAllComponents());
-    currentHealthBarManager.CopyAllComponents(lastValidateHealthBarManager_.GetAllComponents());
+    currentBallManager_.CopyAllComponents(lastValidate_->ballManager.GetAllComponents());
+    currentPhysicsManager_.CopyAllComponents(lastValidate_->physicsManager);
+    currentPlayerManager_.CopyAllComponents(lastValidate_->playerManager.GetAllComponents());
+    currentBoundaryManager_.CopyAllComponents(lastValidate_->boundaryManager.GetAllComponents());
+    currentHomeManager_.CopyAllComponents(lastValidate_->homeManager.GetAllComponents());
+    currentHealthBarManager.CopyAllComponents(lastValidate_->healthBarManager.GetAllComponents());
     
 
     for (Frame frame = lastValidateFrame + 1; frame <= currentFrame; frame++)
@@ -82,7 +103,7 @@ void RollbackManager::SimulateToCurrentFrame()
             const auto playerEntity = gameManager_.GetEntityFromPlayerNumber(playerNumber);
             if (playerEntity == core::INVALID_ENTITY)
             {
-                core::LogWarning(fmt::format("Invalid Entity in {}:line {}", __FILE__, __LINE__));
+                CORE_LOG_WARNING("Invalid Entity in {}:line {}", __FILE__, __LINE__);
                 continue;
             }
             auto playerCharacter = currentPlayerManager_.GetComponent(playerEntity);
@@ -96,7 +117,7 @@ void RollbackManager::SimulateToCurrentFrame()
     //Copy the physics states to the transforms
     for (core::Entity entity = 0; entity < entityManager_.GetEntitiesSize(); entity++)
     {
-        if (!entityManager_.HasComponent(entity,
+        if (!entityManager_.HasComponentUnchecked(entity,
             static_cast<core::EntityMask>(core::ComponentType::BODY2D) |
             static_cast<core::EntityMask>(core::ComponentType::TRANSFORM)))
             continue;
@@ -169,6 +190,28 @@ void RollbackManager::ValidateFrame(Frame newValidateFrame)
             return;
         }
     }
+    if (rollbackMode_ == RollbackMode::AUTHORITATIVE)
+    {
+        //The current world is the validated one, we only step it forward to the new validated frame
+        for (Frame frame = lastValidateFrame_ + 1; frame <= newValidateFrame; frame++)
+        {
+            SimulateFrame(frame);
+#ifdef ENABLE_DESYNC_CHECK
+            RecordDesyncState(frame);
+#endif
+        }
+        //Definitely remove DESTROY entities
+        for (core::Entity entity = 0; entity < entityManager_.GetEntitiesSize(); entity++)
+        {
+            if (entityManager_.HasComponentUnchecked(entity, static_cast<core::EntityMask>(ComponentType::DESTROYED)))
+            {
+                entityManager_.DestroyEntity(entity);
+            }
+        }
+        lastValidateFrame_ = newValidateFrame;
+        createdEntities_.clear();
+        return;
+    }
     //Destroying all created Entities after the last validated frame
     for (const auto& createdEntity : createdEntities_)
     {
@@ -181,7 +224,7 @@ void RollbackManager::ValidateFrame(Frame newValidateFrame)
     //Remove DESTROYED flag
     for (core::Entity entity = 0; entity < entityManager_.GetEntitiesSize(); entity++)
     {
-        if (entityManager_.HasComponent(entity, static_cast<core::EntityMask>(ComponentType::DESTROYED)))
+        if (entityManager_.HasComponentUnchecked(entity, static_cast<core::EntityMask>(ComponentType::DESTROYED)))
         {
             entityManager_.RemoveComponent(entity, static_cast<core::EntityMask>(ComponentType::DESTROYED));
         }
@@ -190,77 +233,353 @@ void RollbackManager::ValidateFrame(Frame newValidateFrame)
     createdEntities_.clear();
 
     //We use the current game state as the temporary new validate game state
-    currentBallManager_.CopyAllComponents(lastValidateBallManager_.GetAllComponents());
-    currentPhysicsManager_.CopyAllComponents(lastValidatePhysicsManager_);
-    currentPlayerManager_.CopyAllComponents(lastValidatePlayerManager_.GetAllComponents());
-    currentBoundaryManager_.CopyAllComponents(lastValidateBoundaryManager_.GetAllComponents());
-    currentHomeManager_.CopyAllComponents(lastValidateHomeManager_.GetAllComponents());
-    currentHealthBarManager.CopyAllComponents(lastValidateHealthBarManager_.GetAllComponents());
+    currentBallManager_.CopyAllComponents(lastValidate_->ballManager.GetAllComponents());
+    currentPhysicsManager_.CopyAllComponents(lastValidate_->physicsManager);
+    currentPlayerManager_.CopyAllComponents(lastValidate_->playerManager.GetAllComponents());
+    currentBoundaryManager_.CopyAllComponents(lastValidate_->boundaryManager.GetAllComponents());
+    currentHomeManager_.CopyAllComponents(lastValidate_->homeManager.GetAllComponents());
+    currentHealthBarManager.CopyAllComponents(lastValidate_->healthBarManager.GetAllComponents());
 
     //We simulate the frames until the new validated frame
     for (Frame frame = lastValidateFrame_ + 1; frame <= newValidateFrame; frame++)
     {
-        testedFrame_ = frame;
-        //Copy the players inputs into the player manager
-        for (PlayerNumber playerNumber = 0; playerNumber < maxPlayerNmb; playerNumber++)
-        {
-            const auto playerInput = GetInputAtFrame(playerNumber, frame);
-            const auto playerEntity = gameManager_.GetEntityFromPlayerNumber(playerNumber);
-            auto playerCharacter = currentPlayerManager_.GetComponent(playerEntity);
-            playerCharacter.input = playerInput;
-            currentPlayerManager_.SetComponent(playerEntity, playerCharacter);
-        }
-        //We simulate one frame
-        currentPlayerManager_.FixedUpdate(sf::seconds(fixedPeriod));
-        currentPhysicsManager_.FixedUpdate(sf::seconds(fixedPeriod));
-      
+        SimulateFrame(frame);
+#ifdef ENABLE_DESYNC_CHECK
+        RecordDesyncState(frame);
+#endif
     }
     //Definitely remove DESTROY entities
     for (core::Entity entity = 0; entity < entityManager_.GetEntitiesSize(); entity++)
     {
-        if (entityManager_.HasComponent(entity, static_cast<core::EntityMask>(ComponentType::DESTROYED)))
+        if (entityManager_.HasComponentUnchecked(entity, static_cast<core::EntityMask>(ComponentType::DESTROYED)))
         {
             entityManager_.DestroyEntity(entity);
         }
     }
     //Copy back the new validate game state to the last validated game state
-    lastValidateBallManager_.CopyAllComponents(currentBallManager_.GetAllComponents());
-    lastValidatePlayerManager_.CopyAllComponents(currentPlayerManager_.GetAllComponents());
-    lastValidatePhysicsManager_.CopyAllComponents(currentPhysicsManager_);
-    lastValidateBoundaryManager_.CopyAllComponents(currentBoundaryManager_.GetAllComponents());
-    lastValidateHomeManager_.CopyAllComponents(currentHomeManager_.GetAllComponents());
-    lastValidateHealthBarManager_.CopyAllComponents(currentHealthBarManager.GetAllComponents());
+    lastValidate_->ballManager.CopyAllComponents(currentBallManager_.GetAllComponents());
+    lastValidate_->playerManager.CopyAllComponents(currentPlayerManager_.GetAllComponents());
+    lastValidate_->physicsManager.CopyAllComponents(currentPhysicsManager_);
+    lastValidate_->boundaryManager.CopyAllComponents(currentBoundaryManager_.GetAllComponents());
+    lastValidate_->homeManager.CopyAllComponents(currentHomeManager_.GetAllComponents());
+    lastValidate_->healthBarManager.CopyAllComponents(currentHealthBarManager.GetAllComponents());
     lastValidateFrame_ = newValidateFrame;
     createdEntities_.clear();
 }
 
-void RollbackManager::ConfirmFrame(Frame newValidateFrame, const std::array<PhysicsState, maxPlayerNmb>& serverPhysicsState)
+bool RollbackManager::ConfirmFrame(Frame newValidateFrame, const std::array<PhysicsState, maxPlayerNmb>& serverPhysicsState)
 {
 
 #ifdef TRACY_ENABLE
     ZoneScoped;
+#endif
+#ifdef ENABLE_DESYNC_CHECK
+    const auto lastConfirmedFrame = lastValidateFrame_;
+    PlayerNumber mismatchPlayer = INVALID_PLAYER;
 #endif
     ValidateFrame(newValidateFrame);
+    bool isConfirmed = true;
     for (PlayerNumber playerNumber = 0; playerNumber < maxPlayerNmb; playerNumber++)
     {
         const PhysicsState lastPhysicsState = GetValidatePhysicsState(playerNumber);
         if (serverPhysicsState[playerNumber] != lastPhysicsState)
         {
-            gpr_assert(false, fmt::format("Physics State are not equal for player {} (server frame: {}, client frame: {}, server: {}, client: {})", 
+            CORE_LOG_WARNING("Physics State are not equal for player {} (server frame: {}, client frame: {}, server: {}, client: {})", 
                 playerNumber+1, 
                 newValidateFrame, 
                 lastValidateFrame_, 
                 serverPhysicsState[playerNumber], 
-                lastPhysicsState));
+                lastPhysicsState);
+            isConfirmed = false;
+#ifdef ENABLE_DESYNC_CHECK
+            if (mismatchPlayer == INVALID_PLAYER)
+            {
+                mismatchPlayer = playerNumber;
+            }
+#endif
+        }
+    }
+#ifdef ENABLE_DESYNC_CHECK
+    if (!isConfirmed)
+    {
+        desyncChecker_.DumpMismatch(lastConfirmedFrame, newValidateFrame, mismatchPlayer);
+    }
+#endif
+    return isConfirmed;
+}
+
+namespace
+{
+template<typename T>
+void WriteSnapshotValue(std::vector<std::uint8_t>& snapshot, const T& value)
+{
+    const auto data = core::ConvertToBinary(value);
+    snapshot.insert(snapshot.end(), data.begin(), data.end());
+}
+
+template<typename T>
+bool ReadSnapshotValue(const std::vector<std::uint8_t>& snapshot, std::size_t& offset, T& value)
+{
+    if (offset + sizeof(T) > snapshot.size())
+    {
+        return false;
+    }
+    std::array<std::uint8_t, sizeof(T)> data{};
+    std::copy_n(snapshot.begin() + static_cast<std::ptrdiff_t>(offset), sizeof(T), data.begin());
+    value = core::ConvertFromBinary<T>(data);
+    offset += sizeof(T);
+    return true;
+}
+}
+
+std::vector<std::uint8_t> RollbackManager::SerializeValidateState() const
+{
+
+#ifdef TRACY_ENABLE
+    ZoneScoped;
+#endif
+    const auto& physicsManager = GetValidatePhysicsManager();
+    const auto& playerManager = GetValidatePlayerManager();
+    const auto& ballManager = GetValidateBallManager();
+    const auto ballEntities = GetBallEntities();
+
+    std::vector<std::uint8_t> snapshot;
+    snapshot.reserve(maxPlayerNmb * (sizeof(Body) + sizeof(PlayerCharacter)) +
+        sizeof(std::uint32_t) + ballEntities.size() * (sizeof(Body) + sizeof(Ball)));
+    for (PlayerNumber playerNumber = 0; playerNumber < maxPlayerNmb; playerNumber++)
+    {
+        const auto playerEntity = gameManager_.GetEntityFromPlayerNumber(playerNumber);
+        WriteSnapshotValue(snapshot, physicsManager.GetBody(playerEntity));
+        WriteSnapshotValue(snapshot, playerManager.GetComponent(playerEntity));
+    }
+    WriteSnapshotValue(snapshot, static_cast<std::uint32_t>(ballEntities.size()));
+    for (const auto ballEntity : ballEntities)
+    {
+        WriteSnapshotValue(snapshot, physicsManager.GetBody(ballEntity));
+        WriteSnapshotValue(snapshot, ballManager.GetComponent(ballEntity));
+    }
+    return snapshot;
+}
+
+bool RollbackManager::ApplyValidateState(Frame validateFrame, const std::vector<std::uint8_t>& snapshot)
+{
+
+#ifdef TRACY_ENABLE
+    ZoneScoped;
+#endif
+    if (lastValidate_ == nullptr)
+    {
+        gpr_assert(false, "Only the clients can apply a validated world snapshot");
+        return false;
+    }
+    if (validateFrame > currentFrame_ || currentFrame_ - validateFrame >= windowBufferSize)
+    {
+        CORE_LOG_WARNING("Cannot apply world snapshot of frame {} at current frame {}", validateFrame, currentFrame_);
+        return false;
+    }
+    //Read everything before touching the validated world to keep it intact if the snapshot is malformed
+    SnapshotState snapshotState;
+    if (!ReadSnapshotState(snapshot, snapshotState))
+    {
+        return false;
+    }
+    if (!WriteSnapshotState(snapshotState, lastValidate_->physicsManager, lastValidate_->playerManager, lastValidate_->ballManager))
+    {
+        return false;
+    }
+
+    //Entities created before the snapshot are now part of the validated world
+    createdEntities_.erase(std::remove_if(createdEntities_.begin(), createdEntities_.end(),
+        [validateFrame](const CreatedEntity& createdEntity)
+        {
+            return createdEntity.createdFrame <= validateFrame;
+        }), createdEntities_.end());
+    const auto previousValidateFrame = lastValidateFrame_;
+    lastValidateFrame_ = validateFrame;
+    //The client validated further than the server snapshot, we resimulate the validated frames from it
+    if (previousValidateFrame > validateFrame)
+    {
+        ValidateFrame(previousValidateFrame);
+    }
+    return true;
+}
+
+bool RollbackManager::LoadValidateState(Frame validateFrame, const std::vector<std::uint8_t>& snapshot)
+{
+
+#ifdef TRACY_ENABLE
+    ZoneScoped;
+#endif
+    SnapshotState snapshotState;
+    if (!ReadSnapshotState(snapshot, snapshotState))
+    {
+        return false;
+    }
+    //Entities created after the last validated frame do not exist at the loaded frame
+    for (const auto& createdEntity : createdEntities_)
+    {
+        if (createdEntity.createdFrame > lastValidateFrame_)
+        {
+            entityManager_.DestroyEntity(createdEntity.entity);
+        }
+    }
+    createdEntities_.clear();
+    for (core::Entity entity = 0; entity < entityManager_.GetEntitiesSize(); entity++)
+    {
+        if (entityManager_.HasComponentUnchecked(entity, static_cast<core::EntityMask>(ComponentType::DESTROYED)))
+        {
+            entityManager_.RemoveComponent(entity, static_cast<core::EntityMask>(ComponentType::DESTROYED));
+        }
+    }
+    const bool isWritten = lastValidate_ != nullptr ?
+        WriteSnapshotState(snapshotState, lastValidate_->physicsManager, lastValidate_->playerManager, lastValidate_->ballManager) :
+        WriteSnapshotState(snapshotState, currentPhysicsManager_, currentPlayerManager_, currentBallManager_);
+    if (!isWritten)
+    {
+        return false;
+    }
+    //The loaded frame becomes the only known frame, the inputs before it are not needed anymore
+    for (auto& inputs : inputs_)
+    {
+        std::fill(inputs.begin(), inputs.end(), PlayerInput{});
+    }
+    lastReceivedFrame_.fill(validateFrame);
+    currentFrame_ = validateFrame;
+    testedFrame_ = validateFrame;
+    lastValidateFrame_ = validateFrame;
+    return true;
+}
+
+bool RollbackManager::ReadSnapshotState(const std::vector<std::uint8_t>& snapshot, SnapshotState& snapshotState)
+{
+    std::size_t offset = 0;
+    for (PlayerNumber playerNumber = 0; playerNumber < maxPlayerNmb; playerNumber++)
+    {
+        if (!ReadSnapshotValue(snapshot, offset, snapshotState.playerBodies[playerNumber]) ||
+            !ReadSnapshotValue(snapshot, offset, snapshotState.playerCharacters[playerNumber]))
+        {
+            CORE_LOG_WARNING("World snapshot is malformed");
+            return false;
         }
     }
+    std::uint32_t ballNmb = 0;
+    if (!ReadSnapshotValue(snapshot, offset, ballNmb))
+    {
+        CORE_LOG_WARNING("World snapshot is malformed");
+        return false;
+    }
+    snapshotState.balls.resize(ballNmb);
+    for (auto& [ballBody, ball] : snapshotState.balls)
+    {
+        if (!ReadSnapshotValue(snapshot, offset, ballBody) ||
+            !ReadSnapshotValue(snapshot, offset, ball))
+        {
+            CORE_LOG_WARNING("World snapshot is malformed");
+            return false;
+        }
+    }
+    return true;
+}
+
+bool RollbackManager::WriteSnapshotState(const SnapshotState& snapshotState,
+    PhysicsManager& physicsManager, PlayerCharacterManager& playerManager, BallManager& ballManager) const
+{
+    //The balls are matched by order, the world is left untouched if they cannot be
+    const auto ballEntities = GetBallEntities();
+    if (ballEntities.size() != snapshotState.balls.size())
+    {
+        CORE_LOG_WARNING("World snapshot has {} balls while client has {}, cannot apply it",
+            snapshotState.balls.size(), ballEntities.size());
+        return false;
+    }
+    for (PlayerNumber playerNumber = 0; playerNumber < maxPlayerNmb; playerNumber++)
+    {
+        const auto playerEntity = gameManager_.GetEntityFromPlayerNumber(playerNumber);
+        physicsManager.SetBody(playerEntity, snapshotState.playerBodies[playerNumber]);
+        playerManager.SetComponent(playerEntity, snapshotState.playerCharacters[playerNumber]);
+    }
+    for (std::size_t i = 0; i < ballEntities.size(); i++)
+    {
+        physicsManager.SetBody(ballEntities[i], snapshotState.balls[i].first);
+        ballManager.SetComponent(ballEntities[i], snapshotState.balls[i].second);
+    }
+    return true;
+}
+
+void RollbackManager::SimulateFrame(Frame frame)
+{
+    testedFrame_ = frame;
+    //Copy the players inputs into the player manager
+    for (PlayerNumber playerNumber = 0; playerNumber < maxPlayerNmb; playerNumber++)
+    {
+        const auto playerInput = GetInputAtFrame(playerNumber, frame);
+        const auto playerEntity = gameManager_.GetEntityFromPlayerNumber(playerNumber);
+        auto playerCharacter = currentPlayerManager_.GetComponent(playerEntity);
+        playerCharacter.input = playerInput;
+        currentPlayerManager_.SetComponent(playerEntity, playerCharacter);
+    }
+    //We simulate one frame
+    currentPlayerManager_.FixedUpdate(sf::seconds(fixedPeriod));
+    currentPhysicsManager_.FixedUpdate(sf::seconds(fixedPeriod));
+}
+
+const PhysicsManager& RollbackManager::GetValidatePhysicsManager() const
+{
+    return lastValidate_ != nullptr ? lastValidate_->physicsManager : currentPhysicsManager_;
 }
 
+const PlayerCharacterManager& RollbackManager::GetValidatePlayerManager() const
+{
+    return lastValidate_ != nullptr ? lastValidate_->playerManager : currentPlayerManager_;
+}
+
+const BallManager& RollbackManager::GetValidateBallManager() const
+{
+    return lastValidate_ != nullptr ? lastValidate_->ballManager : currentBallManager_;
+}
+
+std::vector<core::Entity> RollbackManager::GetBallEntities() const
+{
+    std::vector<core::Entity> ballEntities;
+    for (core::Entity entity = 0; entity < entityManager_.GetEntitiesSize(); entity++)
+    {
+        if (entityManager_.HasComponentUnchecked(entity, static_cast<core::EntityMask>(ComponentType::BALL)) &&
+            !entityManager_.HasComponentUnchecked(entity, static_cast<core::EntityMask>(ComponentType::DESTROYED)))
+        {
+            ballEntities.push_back(entity);
+        }
+    }
+    return ballEntities;
+}
+
+#ifdef ENABLE_DESYNC_CHECK
+void RollbackManager::RecordDesyncState(Frame frame)
+{
+    DesyncFrameState frameState;
+    frameState.frame = frame;
+    for (PlayerNumber playerNumber = 0; playerNumber < maxPlayerNmb; playerNumber++)
+    {
+        const auto playerEntity = gameManager_.GetEntityFromPlayerNumber(playerNumber);
+        frameState.inputs[playerNumber] = GetInputAtFrame(playerNumber, frame);
+        frameState.blocks.push_back(HashBody(DesyncBlock::PLAYER_BODY, playerNumber, currentPhysicsManager_.GetBody(playerEntity)));
+        frameState.blocks.push_back(HashPlayerCharacter(playerNumber, currentPlayerManager_.GetComponent(playerEntity)));
+    }
+    const auto ballEntities = GetBallEntities();
+    for (std::size_t i = 0; i < ballEntities.size(); i++)
+    {
+        const auto key = static_cast<std::uint8_t>(i);
+        frameState.blocks.push_back(HashBody(DesyncBlock::BALL_BODY, key, currentPhysicsManager_.GetBody(ballEntities[i])));
+        frameState.blocks.push_back(HashBall(key, currentBallManager_.GetComponent(ballEntities[i])));
+    }
+    desyncChecker_.RecordFrame(std::move(frameState));
+}
+#endif
+
 PhysicsState RollbackManager::GetValidatePhysicsState(PlayerNumber playerNumber) const
 {
     PhysicsState state = 0;
     const core::Entity playerEntity = gameManager_.GetEntityFromPlayerNumber(playerNumber);
-    const auto& playerBody = lastValidatePhysicsManager_.GetBody(playerEntity);
+    const auto& playerBody = GetValidatePhysicsManager().GetBody(playerEntity);
 
     const auto pos = playerBody.position;
     const auto* posPtr = reinterpret_cast<const PhysicsState*>(&pos);
@@ -315,14 +634,16 @@ void RollbackManager::SpawnPlayer(PlayerNumber playerNumber, core::Entity entity
     currentPhysicsManager_.AddBox(entity);
     currentPhysicsManager_.SetBox(entity, playerBox);
 
-    lastValidatePlayerManager_.AddComponent(entity);
-    lastValidatePlayerManager_.SetComponent(entity, playerCharacter);
-
-    lastValidatePhysicsManager_.AddBody(entity);
-    lastValidatePhysicsManager_.SetBody(entity, playerBody);
-    lastValidatePhysicsManager_.AddBox(entity);
-    lastValidatePhysicsManager_.SetBox(entity, playerBox);
-
+    if (lastValidate_ != nullptr)
+    {
+        lastValidate_->playerManager.AddComponent(entity);
+        lastValidate_->playerManager.SetComponent(entity, playerCharacter);
+        
+        lastValidate_->physicsManager.AddBody(entity);
+        lastValidate_->physicsManager.SetBody(entity, playerBody);
+        lastValidate_->physicsManager.AddBox(entity);
+        lastValidate_->physicsManager.SetBox(entity, playerBox);
+    }
     currentTransformManager_.AddComponent(entity);
     currentTransformManager_.SetPosition(entity, position);
 }
@@ -411,12 +732,12 @@ void RollbackManager::OnTrigger(core::Entity entity1, core::Entity entity2)
         for (core::Entity entity = 0; entity < entityManager_.GetEntitiesSize(); entity++)
         {
             //...we find an entity that has an healthbar component type
-            const bool foundAnHealthBar = entityManager_.HasComponent(entity,
+            const bool foundAnHealthBar = entityManager_.HasComponentUnchecked(entity,
                 static_cast<core::EntityMask>(game::ComponentType::HEALTHBAR)) ? true : false;
             if (foundAnHealthBar)
             {
                 //...we determine if that entity corresponds to the player that was damaged
-                const auto& healthbar = currentHealthBarManager.GetComponent(entity);
+                const auto& healthbar = currentHealthBarManager.GetComponentUnchecked(entity);
                 const bool foundDamagedPlayerHealthBar = healthbar.playerNumber == home.playerNumber ? true : false;
                 if (foundDamagedPlayerHealthBar)
                 {
@@ -530,14 +851,16 @@ void RollbackManager::SpawnBall(core::Entity entity, core::Vec2f position, core:
     currentPhysicsManager_.AddBox(entity);
     currentPhysicsManager_.SetBox(entity, ballBox);
 
-    lastValidateBallManager_.AddComponent(entity);
-    lastValidateBallManager_.SetComponent(entity, { startPlayerNumber });
-
-    lastValidatePhysicsManager_.AddBody(entity);
-    lastValidatePhysicsManager_.SetBody(entity, ballBody);
-    lastValidatePhysicsManager_.AddBox(entity);
-    lastValidatePhysicsManager_.SetBox(entity, ballBox);
-
+    if (lastValidate_ != nullptr)
+    {
+        lastValidate_->ballManager.AddComponent(entity);
+        lastValidate_->ballManager.SetComponent(entity, { startPlayerNumber });
+        
+        lastValidate_->physicsManager.AddBody(entity);
+        lastValidate_->physicsManager.SetBody(entity, ballBody);
+        lastValidate_->physicsManager.AddBox(entity);
+        lastValidate_->physicsManager.SetBox(entity, ballBox);
+    }
     currentTransformManager_.AddComponent(entity);
     currentTransformManager_.SetPosition(entity, position);
     currentTransformManager_.SetScale(entity, core::Vec2f::one() * ballScale);
@@ -565,14 +888,16 @@ void RollbackManager::SpawnBoundary(core::Entity entity, core::Vec2f position)
     currentPhysicsManager_.AddBox(entity);
     currentPhysicsManager_.SetBox(entity, boundaryBox);
 
-    lastValidateBoundaryManager_.AddComponent(entity);
-    lastValidateBoundaryManager_.SetComponent(entity, {position});
-
-    lastValidatePhysicsManager_.AddBody(entity);
-    lastValidatePhysicsManager_.SetBody(entity, boundaryBody);
-    lastValidatePhysicsManager_.AddBox(entity);
-    lastValidatePhysicsManager_.SetBox(entity, boundaryBox);
-
+    if (lastValidate_ != nullptr)
+    {
+        lastValidate_->boundaryManager.AddComponent(entity);
+        lastValidate_->boundaryManager.SetComponent(entity, {position});
+        
+        lastValidate_->physicsManager.AddBody(entity);
+        lastValidate_->physicsManager.SetBody(entity, boundaryBody);
+        lastValidate_->physicsManager.AddBox(entity);
+        lastValidate_->physicsManager.SetBox(entity, boundaryBox);
+    }
     currentTransformManager_.AddComponent(entity);
     currentTransformManager_.SetPosition(entity, position);
 }
@@ -600,14 +925,16 @@ void RollbackManager::SpawnHome(core::Entity entity, PlayerNumber playerNumber,
     currentPhysicsManager_.AddBox(entity);
     currentPhysicsManager_.SetBox(entity, homeBox);
 
-    lastValidateHomeManager_.AddComponent(entity);
-    lastValidateHomeManager_.SetComponent(entity, { playerNumber, position });
-
-    lastValidatePhysicsManager_.AddBody(entity);
-    lastValidatePhysicsManager_.SetBody(entity, homeBody);
-    lastValidatePhysicsManager_.AddBox(entity);
-    lastValidatePhysicsManager_.SetBox(entity, homeBox);
-
+    if (lastValidate_ != nullptr)
+    {
+        lastValidate_->homeManager.AddComponent(entity);
+        lastValidate_->homeManager.SetComponent(entity, { playerNumber, position });
+        
+        lastValidate_->physicsManager.AddBody(entity);
+        lastValidate_->physicsManager.SetBody(entity, homeBody);
+        lastValidate_->physicsManager.AddBox(entity);
+        lastValidate_->physicsManager.SetBox(entity, homeBox);
+    }
     currentTransformManager_.AddComponent(entity);
     currentTransformManager_.SetPosition(entity, position);
 }
@@ -635,9 +962,11 @@ void RollbackManager::SpawnHealthBarBackground(core::Entity entity, PlayerNumber
     currentHealthBarManager.AddComponent(entity);
     currentHealthBarManager.SetComponent(entity, { playerNumber, position });
 
-    lastValidateHealthBarManager_.AddComponent(entity);
-	lastValidateHealthBarManager_.SetComponent(entity, { playerNumber, position });
-
+    if (lastValidate_ != nullptr)
+    {
+        lastValidate_->healthBarManager.AddComponent(entity);
+        lastValidate_->healthBarManager.SetComponent(entity, { playerNumber, position });
+    }
     currentTransformManager_.AddComponent(entity);
     currentTransformManager_.SetPosition(entity, position);
 }
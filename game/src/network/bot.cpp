@@ -0,0 +1,51 @@
+#include "network/bot.h"
+
+#include <algorithm>
+#include <array>
+
+namespace game
+{
+Bot::Bot(BotType botType, PlayerNumber playerNumber, std::uint32_t seed) :
+    botType_(botType), playerNumber_(playerNumber), generator_(seed)
+{
+}
+
+PlayerInput Bot::GetInput(std::size_t tick)
+{
+    using namespace PlayerInputEnum;
+    switch (botType_)
+    {
+    case BotType::SCRIPTED:
+    {
+        constexpr std::size_t period = 90;
+        const auto phase = (tick + playerNumber_ * period / 2) % period;
+        return phase < period / 2 ? UP : DOWN;
+    }
+    case BotType::RANDOM:
+    default:
+    {
+        if (holdTickNmb_ == 0)
+        {
+            constexpr std::array<game::PlayerInput, 3> inputs{ NONE, UP, DOWN };
+            std::uniform_int_distribution<std::size_t> inputDistribution(0, inputs.size() - 1);
+            std::uniform_int_distribution<std::size_t> holdDistribution(1, 60);
+            currentInput_ = inputs[inputDistribution(generator_)];
+            holdTickNmb_ = holdDistribution(generator_);
+        }
+        holdTickNmb_--;
+        return currentInput_;
+    }
+    }
+}
+
+float GetPercentile(std::vector<float>& values, float percentile)
+{
+    if (values.empty())
+    {
+        return 0.0f;
+    }
+    const auto index = static_cast<std::size_t>(percentile * static_cast<float>(values.size() - 1));
+    std::nth_element(values.begin(), values.begin() + static_cast<std::ptrdiff_t>(index), values.end());
+    return values[index];
+}
+}
@@ -38,12 +38,19 @@ void Client::ReceivePacket(const Packet* packet)
     }
     case PacketType::START_GAME:
     {
-        core::LogDebug("Start Game Packet Received");
-        using namespace std::chrono;
-        const auto startingTime = (duration_cast<duration<long long, std::milli>>(
-            system_clock::now().time_since_epoch()
-            ) + milliseconds(startDelay)).count() - milliseconds(static_cast<long long>(currentPing_)).count();
-        gameManager_.StartGame(startingTime);
+        CORE_LOG_DEBUG("Start Game Packet Received");
+        const auto* startGamePacket = static_cast<const StartGamePacket*>(packet);
+        serverStartingTime_ = core::ConvertFromBinary<NetworkTime>(startGamePacket->startTime);
+        if (!clockSync_.IsSynchronized())
+        {
+            //Fallback until we have enough samples, the start packet took about half an RTT to arrive
+            const auto oneWayDelay = static_cast<NetworkTime>(currentPing_ * 1000.0f / 2.0f);
+            gameManager_.StartGame(GetNetworkTime() + startDelay * 1000 - oneWayDelay);
+        }
+        else
+        {
+            gameManager_.StartGame(clockSync_.ToLocalTime(serverStartingTime_));
+        }
         break;
     }
     case PacketType::INPUT:
@@ -51,6 +58,9 @@ void Client::ReceivePacket(const Packet* packet)
         const auto* playerInputPacket = static_cast<const PlayerInputPacket*>(packet);
         const auto playerNumber = playerInputPacket->playerNumber;
         const auto inputFrame = core::ConvertFromBinary<Frame>(playerInputPacket->currentFrame);
+#ifdef ENABLE_MATCH_LOG
+        matchLog_.WriteInput(*playerInputPacket);
+#endif
 
         if (playerNumber == gameManager_.GetPlayerNumber())
         {
@@ -79,6 +89,8 @@ void Client::ReceivePacket(const Packet* packet)
         //discard delayed input packet
         if (inputFrame < gameManager_.GetRollbackManager().GetLastReceivedFrame(playerNumber))
         {
+            packetStats_.AddOutOfOrderPacket(PacketType::INPUT);
+            packetStats_.AddLateInput();
             break;
         }
         for (Frame i = 0; i < playerInputPacket->inputs.size(); i++)
@@ -98,16 +110,38 @@ void Client::ReceivePacket(const Packet* packet)
     {
         const auto* validateFramePacket = static_cast<const ValidateFramePacket*>(packet);
         const auto newValidateFrame = core::ConvertFromBinary<Frame>(validateFramePacket->newValidateFrame);
+        if (newValidateFrame < gameManager_.GetLastValidateFrame())
+        {
+            packetStats_.AddOutOfOrderPacket(PacketType::VALIDATE_STATE);
+        }
         std::array<PhysicsState, maxPlayerNmb> physicsStates{};
         for (size_t i = 0; i < validateFramePacket->physicsState.size(); i++)
         {
             auto* statePtr = reinterpret_cast<std::uint8_t*>(physicsStates.data());
             statePtr[i] = validateFramePacket->physicsState[i];
         }
+#ifdef ENABLE_MATCH_LOG
+        MatchLogPhysicsState matchLogState;
+        matchLogState.validateFrame = newValidateFrame;
+        matchLogState.lastLocalValidateFrame = gameManager_.GetLastValidateFrame();
+        matchLogState.serverStates = physicsStates;
+        for (PlayerNumber playerNumber = 0; playerNumber < maxPlayerNmb; playerNumber++)
+        {
+            matchLogState.localStates[playerNumber] = gameManager_.GetRollbackManager().GetValidatePhysicsState(playerNumber);
+        }
+        matchLog_.WritePhysicsState(matchLogState);
+#endif
         gameManager_.ConfirmValidateFrame(newValidateFrame, physicsStates);
         //logDebug("Client received validate frame " + std::to_string(newValidateFrame));
         break;
     }
+    case PacketType::WORLD_SNAPSHOT:
+    {
+        const auto* worldSnapshotPacket = static_cast<const WorldSnapshotPacket*>(packet);
+        const auto validateFrame = core::ConvertFromBinary<Frame>(worldSnapshotPacket->validateFrame);
+        gameManager_.ApplyWorldSnapshot(validateFrame, worldSnapshotPacket->snapshot);
+        break;
+    }
     case PacketType::WIN_GAME:
     {
         const auto* winGamePacket = static_cast<const WinGamePacket*>(packet);
@@ -120,13 +154,20 @@ void Client::ReceivePacket(const Packet* packet)
         const auto clientId = core::ConvertFromBinary<ClientId>(pingPacket->clientId);
         if (clientId == clientId_)
         {
-            const auto originTime = core::ConvertFromBinary<unsigned long long>(pingPacket->time);
-            using namespace std::chrono;
-            const auto currentTime = duration_cast<duration<unsigned long long, std::milli>>(
-                system_clock::now().time_since_epoch()
-                ).count();
-            const auto delta = currentTime - originTime;
-            const auto ping = static_cast<float>(delta);
+            const auto originTime = core::ConvertFromBinary<NetworkTime>(pingPacket->time);
+            const auto serverTime = core::ConvertFromBinary<NetworkTime>(pingPacket->serverTime);
+            const auto currentTime = GetNetworkTime();
+            const auto ping = static_cast<float>(currentTime - originTime) / 1000.0f;
+            lastPing_ = ping;
+            pingSampleNmb_++;
+
+            clockSync_.AddSample(originTime, serverTime, currentTime);
+            //Refine the starting time with the new offset estimation until the game starts
+            if (serverStartingTime_ != 0 && clockSync_.IsSynchronized() &&
+                !(gameManager_.GetState() & ClientGameManager::STARTED))
+            {
+                gameManager_.StartGame(clockSync_.ToLocalTime(serverStartingTime_));
+            }
 
             //calculate average and var ping
             if (srtt_ < 0.0f)
@@ -142,6 +183,7 @@ void Client::ReceivePacket(const Packet* packet)
 
             rto_ = srtt_ + std::max(g, k * rttvar_);
             currentPing_ = srtt_;
+            gameManager_.SetCurrentPing(currentPing_);
         }
         break;
 
@@ -168,7 +210,7 @@ void Client::ReceivePacket(const Packet* packet)
         const auto* spawnHomePacket = static_cast<const SpawnHomePacket*>(packet);
         const PlayerNumber playerNumber = spawnHomePacket->playerNumber;
         const auto pos = core::ConvertFromBinary<core::Vec2f>(spawnHomePacket->pos);
-        core::LogDebug("Spawn Home");
+        CORE_LOG_DEBUG("Spawn Home");
         gameManager_.SpawnHome(playerNumber, pos);
         break;
     }
@@ -177,7 +219,7 @@ void Client::ReceivePacket(const Packet* packet)
 		const auto* spawnHealthbarPacket = static_cast<const SpawnHealthBarPacket*>(packet);
         const PlayerNumber playerNumber = spawnHealthbarPacket->playerNumber;
         const auto pos = core::ConvertFromBinary<core::Vec2f>(spawnHealthbarPacket->pos);
-        core::LogDebug("Spawn Healthbar");
+        CORE_LOG_DEBUG("Spawn Healthbar");
         gameManager_.SpawnHealthBar(pos);
         gameManager_.SpawnHealthBarBackground(playerNumber, pos);
         break;
@@ -192,19 +234,19 @@ void Client::Update(sf::Time dt)
 #ifdef TRACY_ENABLE
     ZoneScoped;
 #endif
+    packetStats_.Update(dt);
     pingTimer_ -= dt.asSeconds();
     if (pingTimer_ < 0.0f)
     {
         if (clientId_ != INVALID_CLIENT_ID)
         {
-            using namespace std::chrono;
             auto pingPacket = std::make_unique<PingPacket>();
-            pingPacket->time = core::ConvertToBinary(duration_cast<duration<unsigned long long, std::milli>>(
-                system_clock::now().time_since_epoch()).count());
+            pingPacket->time = core::ConvertToBinary(GetNetworkTime());
             pingPacket->clientId = core::ConvertToBinary(clientId_);
             SendUnreliablePacket(std::move(pingPacket));
         }
-        pingTimer_ = pingPeriod_;
+        //We ping faster until we have enough samples to synchronize the clock
+        pingTimer_ = clockSync_.IsSynchronized() ? pingPeriod_ : clockSyncPingPeriod;
     }
 }
 }
@@ -0,0 +1,64 @@
+#include "network/clock_sync.h"
+
+#include <algorithm>
+#include <chrono>
+
+namespace game
+{
+namespace
+{
+thread_local bool isNetworkTimeSimulated = false;
+thread_local NetworkTime simulatedNetworkTime = 0;
+}
+
+NetworkTime GetNetworkTime()
+{
+    if (isNetworkTimeSimulated)
+    {
+        return simulatedNetworkTime;
+    }
+    using namespace std::chrono;
+    return duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+void SetSimulatedNetworkTime(NetworkTime simulatedTime)
+{
+    isNetworkTimeSimulated = true;
+    simulatedNetworkTime = simulatedTime;
+}
+
+void ResetSimulatedNetworkTime()
+{
+    isNetworkTimeSimulated = false;
+}
+
+void ClockSync::AddSample(NetworkTime clientSendTime, NetworkTime serverTime, NetworkTime clientReceiveTime)
+{
+    if (clientReceiveTime < clientSendTime)
+        return;
+    //The server answers immediately, so its receive and send times are the same
+    ClockSyncSample sample;
+    sample.rtt = clientReceiveTime - clientSendTime;
+    sample.offset = serverTime - (clientSendTime + clientReceiveTime) / 2;
+
+    samples_[nextSample_] = sample;
+    nextSample_ = (nextSample_ + 1) % samples_.size();
+    sampleCount_ = std::min(sampleCount_ + 1, samples_.size());
+
+    //Average the offsets of the samples with the smallest RTT
+    std::array<ClockSyncSample, clockSyncSampleNmb> sortedSamples = samples_;
+    const auto begin = sortedSamples.begin();
+    const auto end = begin + static_cast<std::ptrdiff_t>(sampleCount_);
+    std::sort(begin, end, [](const auto& sample1, const auto& sample2)
+        {
+            return sample1.rtt < sample2.rtt;
+        });
+    const auto bestSampleNmb = std::min(sampleCount_, clockSyncBestSampleNmb);
+    NetworkTime offsetSum = 0;
+    for (std::size_t i = 0; i < bestSampleNmb; i++)
+    {
+        offsetSum += sortedSamples[i].offset;
+    }
+    offset_ = offsetSum / static_cast<NetworkTime>(bestSampleNmb);
+}
+}
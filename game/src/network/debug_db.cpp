@@ -14,6 +14,7 @@
 #endif
 
 #include <filesystem>
+#include <iterator>
 
 namespace fs = std::filesystem;
 
@@ -24,27 +25,37 @@ namespace game
 static int callback([[maybe_unused]] void* NotUsed, int argc, char** argv, char** azColName)
 {
     for (int i = 0; i < argc; i++) {
-        core::LogDebug(fmt::format("{} = {}", azColName[i], argv[i] ? argv[i] : "NULL"));
+        CORE_LOG_DEBUG("{} = {}", azColName[i], argv[i] ? argv[i] : "NULL");
     }
     return 0;
 }
 
+DebugDatabase::~DebugDatabase()
+{
+    Close();
+}
+
 void DebugDatabase::Open(std::string_view path)
 {
     if (fs::exists(path))
     {
         fs::remove(path);
     }
-    const auto rc = sqlite3_open(path.data(), &db);
+    const auto rc = sqlite3_open(std::string(path).c_str(), &db);
     if (rc != SQLITE_OK)
     {
-        core::LogError(fmt::format("Can't open database: {}\n", sqlite3_errmsg(db)));
+        CORE_LOG_ERROR("Can't open database: {}\n", sqlite3_errmsg(db));
         sqlite3_close(db);
         db = nullptr;
+        return;
     }
+    //The database is a debug record, losing the last transaction on a crash of the OS is acceptable
+    Execute("PRAGMA journal_mode = WAL;");
+    Execute("PRAGMA synchronous = NORMAL;");
     CreateTables();
+    PrepareStatements();
+    isOver_.store(false, std::memory_order_release);
     t_ = std::thread{ &DebugDatabase::Loop, this };
-    t_.detach();
 }
 
 void DebugDatabase::StorePacket(const PlayerInputPacket* inputPacket)
@@ -52,25 +63,22 @@ void DebugDatabase::StorePacket(const PlayerInputPacket* inputPacket)
 #ifdef TRACY_ENABLE
     ZoneScoped;
 #endif
-    const PlayerNumber playerNumber = inputPacket->playerNumber;
-    const auto frame = core::ConvertFromBinary<Frame>(inputPacket->currentFrame);
-    const PlayerInput input = inputPacket->inputs[0];
-
-    auto query = fmt::format("INSERT INTO inputs (player_number, frame, up, down, left, right, shoot) VALUES({}, {}, {}, {}, {}, {},  {});",
-        playerNumber,
-        frame,
-        (input & PlayerInputEnum::UP) == PlayerInputEnum::UP,
-        (input & PlayerInputEnum::DOWN) == PlayerInputEnum::DOWN,
-        (input & PlayerInputEnum::LEFT) == PlayerInputEnum::LEFT,
-        (input & PlayerInputEnum::RIGHT) == PlayerInputEnum::RIGHT,
-        (input & PlayerInputEnum::SHOOT) == PlayerInputEnum::SHOOT);
-
+    if (db == nullptr)
     {
-        std::lock_guard lock(m_);
-        commands_.push_back(query);
+        return;
+    }
+    const DbInput input
+    {
+        core::ConvertFromBinary<Frame>(inputPacket->currentFrame),
+        inputPacket->playerNumber,
+        inputPacket->inputs[0]
+    };
+    inputs_.TryPush(input);
+    //Only the push filling a batch wakes up the writer, a missed wake up is caught by the flush period
+    if (inputs_.GetSizeApprox() == recordBatchSize)
+    {
+        cv_.notify_one();
     }
-
-    cv_.notify_one();
 }
 
 void DebugDatabase::StorePhysicsState(const DbPhysicsState& physicsState)
@@ -78,30 +86,36 @@ void DebugDatabase::StorePhysicsState(const DbPhysicsState& physicsState)
 #ifdef TRACY_ENABLE
     ZoneScoped;
 #endif
-
-    std::string query = "INSERT INTO physics_state (local_frame, validate_frame ";
-    std::string arguments;
-    std::string values = fmt::format(" VALUES ({}, {}", physicsState.lastLocalValidateFrame, physicsState.validateFrame);
-    for (PlayerNumber playerNumber = 0; playerNumber < maxPlayerNmb; playerNumber++)
+    if (db == nullptr)
     {
-        arguments += fmt::format(",state_p{}_local, state_p{}_server ", playerNumber + 1, playerNumber + 1);
-        values += fmt::format(",{},{}", physicsState.localStates[playerNumber], physicsState.serverStates[playerNumber]);
+        return;
     }
-    query += arguments + ") " + values + " );";
+    physicsStates_.TryPush(physicsState);
+    if (physicsStates_.GetSizeApprox() == recordBatchSize)
     {
-        std::lock_guard lock(m_);
-        commands_.push_back(query);
+        cv_.notify_one();
     }
-
-    cv_.notify_one();
 }
 
 void DebugDatabase::Close()
 {
-    isOver_.store(true, std::memory_order_release);
+    {
+        std::lock_guard lock(m_);
+        isOver_.store(true, std::memory_order_release);
+    }
     cv_.notify_one();
-
-    //t_.join();
+    if (t_.joinable())
+    {
+        t_.join();
+        if (GetDroppedRecordNmb() != 0)
+        {
+            CORE_LOG_WARNING("Debug database dropped {} records", GetDroppedRecordNmb());
+        }
+    }
+    sqlite3_finalize(insertInputStatement_);
+    insertInputStatement_ = nullptr;
+    sqlite3_finalize(insertPhysicsStateStatement_);
+    insertPhysicsStateStatement_ = nullptr;
     if (db != nullptr)
     {
         sqlite3_close(db);
@@ -111,42 +125,137 @@ void DebugDatabase::Close()
 
 void DebugDatabase::Loop()
 {
-    std::unique_lock lock(m_);
-    while (!isOver_.load(std::memory_order_acquire))
+    std::vector<DbInput> inputs;
+    inputs.reserve(inputCapacity);
+    std::vector<DbPhysicsState> physicsStates;
+    physicsStates.reserve(physicsStateCapacity);
+    while (true)
+    {
+        {
+            std::unique_lock lock(m_);
+            cv_.wait_for(lock, flushPeriod, [this]
+                {
+                    return isOver_.load(std::memory_order_acquire) ||
+                        isFlushRequested_.load(std::memory_order_acquire) ||
+                        inputs_.GetSizeApprox() >= recordBatchSize ||
+                        physicsStates_.GetSizeApprox() >= recordBatchSize;
+                });
+        }
+        //The records pushed before Close are committed before leaving
+        const bool isOver = isOver_.load(std::memory_order_acquire);
+        inputs_.PopBatch(std::back_inserter(inputs));
+        physicsStates_.PopBatch(std::back_inserter(physicsStates));
+        WriteBatch(inputs, physicsStates);
+        inputs.clear();
+        physicsStates.clear();
+        isFlushRequested_.store(false, std::memory_order_release);
+        if (isOver)
+        {
+            break;
+        }
+    }
+}
+
+void DebugDatabase::Flush()
+{
+    if (!t_.joinable())
+    {
+        return;
+    }
+    do
     {
-        while (!commands_.empty())
+        isFlushRequested_.store(true, std::memory_order_release);
+        cv_.notify_one();
+        while (isFlushRequested_.load(std::memory_order_acquire))
         {
-            if (isOver_.load(std::memory_order_acquire))
-            {
-                break;
-            }
+            std::this_thread::yield();
+        }
+    } while (inputs_.GetSizeApprox() != 0 || physicsStates_.GetSizeApprox() != 0);
+}
+
+std::uint64_t DebugDatabase::GetDroppedRecordNmb() const
+{
+    return inputs_.GetDroppedNmb() + physicsStates_.GetDroppedNmb();
+}
+
+void DebugDatabase::WriteBatch(const std::vector<DbInput>& inputs, const std::vector<DbPhysicsState>& physicsStates)
+{
+    if (inputs.empty() && physicsStates.empty())
+    {
+        return;
+    }
 #ifdef TRACY_ENABLE
-            ZoneNamedN(sqlExecuteCommand, "SQL Execute Command", true);
+    ZoneNamedN(sqlWriteBatch, "SQL Write Batch", true);
 #endif
-            std::string command = std::move(commands_[0]);
-            commands_.erase(commands_.begin());
-            lock.unlock();
-            /* Execute SQL statement */
-
-            char* zErrMsg = nullptr;
-            const auto rc = sqlite3_exec(db, command.c_str(), callback, nullptr, &zErrMsg);
-
-            if (rc != SQLITE_OK) {
-                core::LogError(fmt::format("SQL error with storing input: {}", zErrMsg));
-                sqlite3_free(zErrMsg);
-            }
-            lock.lock();
+    Execute("BEGIN TRANSACTION;");
+    for (const auto& input : inputs)
+    {
+        sqlite3_bind_int(insertInputStatement_, 1, input.playerNumber);
+        sqlite3_bind_int64(insertInputStatement_, 2, input.frame);
+        sqlite3_bind_int(insertInputStatement_, 3, (input.input & PlayerInputEnum::UP) == PlayerInputEnum::UP);
+        sqlite3_bind_int(insertInputStatement_, 4, (input.input & PlayerInputEnum::DOWN) == PlayerInputEnum::DOWN);
+        sqlite3_bind_int(insertInputStatement_, 5, (input.input & PlayerInputEnum::LEFT) == PlayerInputEnum::LEFT);
+        sqlite3_bind_int(insertInputStatement_, 6, (input.input & PlayerInputEnum::RIGHT) == PlayerInputEnum::RIGHT);
+        if (sqlite3_step(insertInputStatement_) != SQLITE_DONE)
+        {
+            CORE_LOG_ERROR("SQL error with storing input: {}", sqlite3_errmsg(db));
         }
-        if (isOver_.load(std::memory_order_acquire))
-            break;
-        cv_.wait(lock);
+        sqlite3_reset(insertInputStatement_);
+    }
+    for (const auto& physicsState : physicsStates)
+    {
+        int index = 1;
+        sqlite3_bind_int64(insertPhysicsStateStatement_, index++, physicsState.lastLocalValidateFrame);
+        sqlite3_bind_int64(insertPhysicsStateStatement_, index++, physicsState.validateFrame);
+        for (PlayerNumber playerNumber = 0; playerNumber < maxPlayerNmb; playerNumber++)
+        {
+            sqlite3_bind_int(insertPhysicsStateStatement_, index++, physicsState.localStates[playerNumber]);
+            sqlite3_bind_int(insertPhysicsStateStatement_, index++, physicsState.serverStates[playerNumber]);
+        }
+        if (sqlite3_step(insertPhysicsStateStatement_) != SQLITE_DONE)
+        {
+            CORE_LOG_ERROR("SQL error with storing physics state: {}", sqlite3_errmsg(db));
+        }
+        sqlite3_reset(insertPhysicsStateStatement_);
+    }
+    Execute("COMMIT;");
+}
+
+void DebugDatabase::Execute(const char* command) const
+{
+    char* zErrMsg = nullptr;
+    const auto rc = sqlite3_exec(db, command, nullptr, nullptr, &zErrMsg);
+    if (rc != SQLITE_OK) {
+        CORE_LOG_ERROR("SQL error with {}: {}", command, zErrMsg);
+        sqlite3_free(zErrMsg);
+    }
+}
+
+void DebugDatabase::PrepareStatements()
+{
+    const auto insertInput = "INSERT INTO inputs (player_number, frame, up, down, left, right) VALUES (?, ?, ?, ?, ?, ?);";
+    if (sqlite3_prepare_v2(db, insertInput, -1, &insertInputStatement_, nullptr) != SQLITE_OK)
+    {
+        CORE_LOG_ERROR("SQL error while preparing input insert: {}", sqlite3_errmsg(db));
+    }
+
+    std::string insertPhysicsState = "INSERT INTO physics_state (local_frame, validate_frame";
+    std::string values = " VALUES (?, ?";
+    for (PlayerNumber playerNumber = 0; playerNumber < maxPlayerNmb; playerNumber++)
+    {
+        insertPhysicsState += fmt::format(", state_p{}_local, state_p{}_server", playerNumber + 1, playerNumber + 1);
+        values += ", ?, ?";
+    }
+    insertPhysicsState += ")" + values + ");";
+    if (sqlite3_prepare_v2(db, insertPhysicsState.c_str(), -1, &insertPhysicsStateStatement_, nullptr) != SQLITE_OK)
+    {
+        CORE_LOG_ERROR("SQL error while preparing physics state insert: {}", sqlite3_errmsg(db));
     }
-    isOver_ = false;
 }
 
 void DebugDatabase::CreateTables() const
 {
-    //playerNumber, frame, up, down, left, right, shoot
+    //playerNumber, frame, up, down, left, right
 
     const auto createInputTable = "CREATE TABLE inputs ("\
         "input_id INTEGER PRIMARY KEY,"\
@@ -155,8 +264,7 @@ void DebugDatabase::CreateTables() const
         "up INTEGER NOT NULL,"\
         "down INTEGER NOT NULL,"\
         "left INTEGER NOT NULL,"\
-        "right INTEGER NOT NULL,"\
-        "shoot INTEGER NOT NULL);";
+        "right INTEGER NOT NULL);";
 
     /* Execute SQL statement */
 
@@ -164,7 +272,7 @@ void DebugDatabase::CreateTables() const
     const auto rc = sqlite3_exec(db, createInputTable, callback, nullptr, &zErrMsg);
 
     if (rc != SQLITE_OK) {
-        core::LogError(fmt::format("SQL error while creating table: {}", zErrMsg));
+        CORE_LOG_ERROR("SQL error while creating table: {}", zErrMsg);
         sqlite3_free(zErrMsg);
     }
 
@@ -181,7 +289,7 @@ void DebugDatabase::CreateTables() const
     zErrMsg = nullptr;
     const auto rc2 = sqlite3_exec(db, createPhysicsStateTable.data(), callback, nullptr, &zErrMsg);
     if (rc2 != SQLITE_OK) {
-        core::LogError(fmt::format("SQL error while creating table: {}", zErrMsg));
+        CORE_LOG_ERROR("SQL error while creating table: {}", zErrMsg);
         sqlite3_free(zErrMsg);
     }
 }
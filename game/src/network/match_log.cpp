@@ -0,0 +1,156 @@
+#include "network/match_log.h"
+
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+#include <fmt/format.h>
+
+#include "utils/conversion.h"
+#include "utils/log.h"
+
+#ifdef TRACY_ENABLE
+#include <Tracy.hpp>
+#endif
+
+namespace game
+{
+MatchLogWriter::~MatchLogWriter()
+{
+    Close();
+}
+
+bool MatchLogWriter::Open(std::string_view path)
+{
+    if (!file_.Open(path, core::MappedFile::Mode::WRITE, initialFileSize))
+    {
+        return false;
+    }
+    const MatchLogHeader header{};
+    std::memcpy(file_.GetData(), &header, sizeof(header));
+    writePosition_ = sizeof(header);
+    return true;
+}
+
+void MatchLogWriter::Close()
+{
+    //Not checked with IsOpen, a failed Resize leaves the file unmapped but still to be truncated and closed
+    if (writePosition_ > 0)
+    {
+        file_.Close(writePosition_);
+    }
+    writePosition_ = 0;
+}
+
+void MatchLogWriter::WriteInput(const PlayerInputPacket& inputPacket)
+{
+    MatchLogInput input;
+    input.frame = core::ConvertFromBinary<Frame>(inputPacket.currentFrame);
+    input.playerNumber = inputPacket.playerNumber;
+    input.inputs = inputPacket.inputs;
+    Append(MatchLogRecordType::INPUT, input);
+}
+
+void MatchLogWriter::WritePhysicsState(const MatchLogPhysicsState& physicsState)
+{
+    Append(MatchLogRecordType::PHYSICS_STATE, physicsState);
+}
+
+template<typename T>
+void MatchLogWriter::Append(MatchLogRecordType type, const T& record)
+{
+#ifdef TRACY_ENABLE
+    ZoneScoped;
+#endif
+    static_assert(std::is_trivially_copyable_v<T>);
+    static_assert(sizeof(T) <= std::numeric_limits<std::uint16_t>::max());
+    if (!file_.IsOpen())
+    {
+        return;
+    }
+    const MatchLogRecordHeader recordHeader{ type, static_cast<std::uint16_t>(sizeof(T)) };
+    const auto recordSize = sizeof(recordHeader) + sizeof(T);
+    //One more record header is kept free for the END marker that the zeroed grown file provides
+    if (writePosition_ + recordSize + sizeof(MatchLogRecordHeader) > file_.GetSize() &&
+        !file_.Resize(file_.GetSize() * 2))
+    {
+        CORE_LOG_ERROR("Could not grow the match log, closing it");
+        Close();
+        return;
+    }
+    auto* data = file_.GetData() + writePosition_;
+    std::memcpy(data, &recordHeader, sizeof(recordHeader));
+    std::memcpy(data + sizeof(recordHeader), &record, sizeof(T));
+    writePosition_ += recordSize;
+}
+
+bool MatchLogReader::Open(std::string_view path)
+{
+    if (!file_.Open(path, core::MappedFile::Mode::READ))
+    {
+        return false;
+    }
+    if (file_.GetSize() < sizeof(MatchLogHeader))
+    {
+        CORE_LOG_ERROR("Match log {} is too small", path);
+        file_.Close();
+        return false;
+    }
+    std::memcpy(&header_, file_.GetData(), sizeof(header_));
+    if (header_.magic != MatchLogHeader::matchLogMagic ||
+        header_.version != MatchLogHeader::matchLogVersion ||
+        header_.playerNmb != maxPlayerNmb ||
+        header_.inputNmb != maxInputNmb)
+    {
+        CORE_LOG_ERROR("{} is not a match log of version {}", path, MatchLogHeader::matchLogVersion);
+        file_.Close();
+        return false;
+    }
+    readPosition_ = header_.headerSize;
+    return true;
+}
+
+std::optional<MatchLogRecord> MatchLogReader::ReadNext()
+{
+    while (file_.IsOpen() && readPosition_ + sizeof(MatchLogRecordHeader) <= file_.GetSize())
+    {
+        MatchLogRecordHeader recordHeader;
+        std::memcpy(&recordHeader, file_.GetData() + readPosition_, sizeof(recordHeader));
+        const auto* payload = file_.GetData() + readPosition_ + sizeof(recordHeader);
+        if (recordHeader.type == MatchLogRecordType::END ||
+            readPosition_ + sizeof(recordHeader) + recordHeader.size > file_.GetSize())
+        {
+            //A log of a crashed client ends with the zeroed space of the last growth or a truncated record
+            return std::nullopt;
+        }
+        readPosition_ += sizeof(recordHeader) + recordHeader.size;
+        switch (recordHeader.type)
+        {
+        case MatchLogRecordType::INPUT:
+        {
+            if (recordHeader.size != sizeof(MatchLogInput))
+            {
+                break;
+            }
+            MatchLogInput input;
+            std::memcpy(&input, payload, sizeof(input));
+            return input;
+        }
+        case MatchLogRecordType::PHYSICS_STATE:
+        {
+            if (recordHeader.size != sizeof(MatchLogPhysicsState))
+            {
+                break;
+            }
+            MatchLogPhysicsState physicsState;
+            std::memcpy(&physicsState, payload, sizeof(physicsState));
+            return physicsState;
+        }
+        default:
+            break;
+        }
+        skippedRecordNmb_++;
+    }
+    return std::nullopt;
+}
+}
@@ -1,4 +1,3 @@
-#include <chrono>
 #include <imgui.h>
 #include <imgui_stdlib.h>
 #include <network/network_client.h>
@@ -32,9 +31,20 @@ void NetworkClient::Begin()
         status = udpSocket_.bind(sf::Socket::AnyPort);
     }
     udpSocket_.setBlocking(false);
+    packetStats_.SetDumpFile(fmt::format("client_{}", static_cast<unsigned>(clientId_)),
+        fmt::format("client_{}_packet_stats.jsonl", static_cast<unsigned>(clientId_)));
 #ifdef ENABLE_SQLITE
     debugDb_.Open(fmt::format("Client_{}.db", static_cast<unsigned>(clientId_)));
 #endif
+#ifdef ENABLE_MATCH_LOG
+    matchLog_.Open(fmt::format("Client_{}.matchlog", static_cast<unsigned>(clientId_)));
+#endif
+#ifdef ENABLE_REPLAY_RECORD
+    gameManager_.StartReplayRecording(fmt::format("Client_{}.replay", static_cast<unsigned>(clientId_)));
+#endif
+#ifdef ENABLE_DESYNC_CHECK
+    gameManager_.StartDesyncLog(fmt::format("Client_{}.desynclog", static_cast<unsigned>(clientId_)));
+#endif
 
    
 }
@@ -62,7 +72,7 @@ void NetworkClient::Update(sf::Time dt)
                 //core::LogDebug("[Client] Error while receiving tcp socket is not ready");
                 break;
             case sf::Socket::Partial:
-                core::LogDebug("[Client] Error while receiving TCP packet, PARTIAL");
+                CORE_LOG_DEBUG("[Client] Error while receiving TCP packet, PARTIAL");
                 break;
             case sf::Socket::Disconnected: break;
             case sf::Socket::Error: break;
@@ -84,13 +94,13 @@ void NetworkClient::Update(sf::Time dt)
                 break;
             case sf::Socket::NotReady: break;
             case sf::Socket::Partial:
-                core::LogDebug("[Client] Error while receiving UDP packet, PARTIAL");
+                CORE_LOG_DEBUG("[Client] Error while receiving UDP packet, PARTIAL");
                 break;
             case sf::Socket::Disconnected:
-                core::LogDebug("[Client] Error while receiving UDP packet, DISCONNECTED");
+                CORE_LOG_DEBUG("[Client] Error while receiving UDP packet, DISCONNECTED");
                 break;
             case sf::Socket::Error:
-                core::LogDebug("[Client] Error while receiving UDP packet, ERROR");
+                CORE_LOG_DEBUG("[Client] Error while receiving UDP packet, ERROR");
                 break;
             default:;
             }
@@ -122,6 +132,12 @@ void NetworkClient::End()
 #ifdef ENABLE_SQLITE
     debugDb_.Close();
 #endif
+#ifdef ENABLE_MATCH_LOG
+    matchLog_.Close();
+#endif
+#ifdef ENABLE_REPLAY_RECORD
+    gameManager_.StopReplayRecording();
+#endif
 
 }
 
@@ -136,6 +152,8 @@ void NetworkClient::DrawImGui()
         ImGui::Text("RTTVAR: %f", rttvar_);
         ImGui::Text("RTO: %f", rto_);
     }
+    ImGui::Text("Clock Offset: %lld us (%zu samples)",
+        static_cast<long long>(clockSync_.GetOffset()), clockSync_.GetSampleCount());
 
 
     ImGui::InputText("Host", &serverAddress_);
@@ -148,31 +166,35 @@ void NetworkClient::DrawImGui()
     if (currentState_ == State::NONE &&
         ImGui::Button("Join"))
     {
-        tcpSocket_.setBlocking(true);
-        const auto status = tcpSocket_.connect(serverAddress_, serverTcpPort_);
-        tcpSocket_.setBlocking(false);
-        if (status == sf::Socket::Done)
-        {
-            core::LogDebug("[Client] Connect to server " + serverAddress_ + " with port: " + std::to_string(serverTcpPort_));
-            auto joinPacket = std::make_unique<JoinPacket>();
-            joinPacket->clientId = core::ConvertToBinary<ClientId>(clientId_);
-            using namespace std::chrono;
-            const unsigned long clientTime = static_cast<unsigned long>((duration_cast<milliseconds>(system_clock::now().time_since_epoch())).count());
-            joinPacket->startTime = core::ConvertToBinary<unsigned long>(clientTime);
-            SendReliablePacket(std::move(joinPacket));
-            currentState_ = State::JOINING;
-        }
-        else
-        {
-            core::LogError("[Client] Error trying to connect to " + serverAddress_ + " with port: " +
-                std::to_string(serverTcpPort_) + " with status: " + std::to_string(status));
-        }
+        Join(serverAddress_, serverTcpPort_);
     }
     ImGui::Text("Server UDP port: %u", serverUdpPort_);
+    packetStats_.DrawImGui();
     gameManager_.DrawImGui();
     ImGui::End();
 }
 
+bool NetworkClient::Join(std::string_view address, unsigned short tcpPort)
+{
+    serverAddress_ = address;
+    serverTcpPort_ = tcpPort;
+    tcpSocket_.setBlocking(true);
+    const auto status = tcpSocket_.connect(serverAddress_, serverTcpPort_);
+    tcpSocket_.setBlocking(false);
+    if (status != sf::Socket::Done)
+    {
+        CORE_LOG_ERROR("[Client] Error trying to connect to {} with port: {} with status: {}",
+            serverAddress_, serverTcpPort_, static_cast<int>(status));
+        return false;
+    }
+    CORE_LOG_DEBUG("[Client] Connect to server {} with port: {}", serverAddress_, serverTcpPort_);
+    auto joinPacket = std::make_unique<JoinPacket>();
+    joinPacket->clientId = core::ConvertToBinary<ClientId>(clientId_);
+    SendReliablePacket(std::move(joinPacket));
+    currentState_ = State::JOINING;
+    return true;
+}
+
 void NetworkClient::Draw(sf::RenderTarget& renderTarget)
 {
 #ifdef TRACY_ENABLE
@@ -192,6 +214,14 @@ void NetworkClient::SendReliablePacket(std::unique_ptr<Packet> packet)
     {
         status = tcpSocket_.send(tcpPacket);
     }
+    if (status == sf::Socket::Done)
+    {
+        packetStats_.AddPacket(packet->packetType, PacketDirection::SENT, tcpPacket.getDataSize());
+    }
+    else
+    {
+        packetStats_.AddDroppedPacket(packet->packetType, PacketDirection::SENT);
+    }
 }
 
 void NetworkClient::SendUnreliablePacket(std::unique_ptr<Packet> packet)
@@ -209,22 +239,27 @@ void NetworkClient::SendUnreliablePacket(std::unique_ptr<Packet> packet)
     case sf::Socket::Done:
         //core::LogDebug("[Client] Sending UDP packet to server at host: " +
         //	serverAddress_.toString() + " port: " + std::to_string(serverUdpPort_));
+        packetStats_.AddPacket(packet->packetType, PacketDirection::SENT, udpPacket.getDataSize());
         break;
     case sf::Socket::NotReady:
-        core::LogDebug("[Client] Error sending UDP to server, NOT READY");
+        CORE_LOG_DEBUG("[Client] Error sending UDP to server, NOT READY");
         break;
     case sf::Socket::Partial:
-        core::LogDebug("[Client] Error sending UDP to server, PARTIAL");
+        CORE_LOG_DEBUG("[Client] Error sending UDP to server, PARTIAL");
         break;
     case sf::Socket::Disconnected:
-        core::LogDebug("[Client] Error sending UDP to server, DISCONNECTED");
+        CORE_LOG_DEBUG("[Client] Error sending UDP to server, DISCONNECTED");
         break;
     case sf::Socket::Error:
-        core::LogDebug("[Client] Error sending UDP to server, ERROR");
+        CORE_LOG_DEBUG("[Client] Error sending UDP to server, ERROR");
         break;
     default:
         break;
     }
+    if (status != sf::Socket::Done)
+    {
+        packetStats_.AddDroppedPacket(packet->packetType, PacketDirection::SENT);
+    }
 }
 
 void NetworkClient::SetPlayerInput(PlayerInput playerInput)
@@ -283,12 +318,17 @@ void NetworkClient::ReceivePacket(const Packet* packet)
 void NetworkClient::ReceiveNetPacket(sf::Packet& packet, PacketSource source)
 {
     const auto receivePacket = GenerateReceivedPacket(packet);
+    if (receivePacket == nullptr)
+    {
+        return;
+    }
+    packetStats_.AddPacket(receivePacket->packetType, PacketDirection::RECEIVED, packet.getDataSize());
     Client::ReceivePacket(receivePacket.get());
     switch (receivePacket->packetType)
     {
     case PacketType::JOIN_ACK:
     {
-        core::LogDebug("[Client] Receive " + std::string(source == PacketSource::UDP ? "UDP" : "TCP") + " Join ACK Packet");
+        CORE_LOG_DEBUG("[Client] Receive {} Join ACK Packet", source == PacketSource::UDP ? "UDP" : "TCP");
         auto* joinAckPacket = static_cast<JoinAckPacket*>(receivePacket.get());
 
         serverUdpPort_ = core::ConvertFromBinary<unsigned short>(joinAckPacket->udpPort);
@@ -0,0 +1,171 @@
+#include "network/network_emulator.h"
+
+#include <algorithm>
+#include <limits>
+
+#ifdef TRACY_ENABLE
+#include <Tracy.hpp>
+#endif
+
+namespace game
+{
+namespace
+{
+/**
+ * \brief IsReleasedLater is the comparator of the scheduled packets heap, the first packet to release is on top.
+ * The sequence keeps the sending order between packets with the same release time.
+ */
+template<typename T>
+bool IsReleasedLater(const T& packet1, const T& packet2)
+{
+    if (packet1.releaseTime != packet2.releaseTime)
+    {
+        return packet1.releaseTime > packet2.releaseTime;
+    }
+    return packet1.sequence > packet2.sequence;
+}
+}
+
+NetworkLink::NetworkLink(const LinkConditions& conditions, std::uint32_t seed) :
+    conditions_(conditions), generator_(seed)
+{
+}
+
+std::size_t NetworkLink::Send(std::unique_ptr<Packet> packet, bool isReliable, double currentTime)
+{
+
+#ifdef TRACY_ENABLE
+    ZoneScoped;
+#endif
+    //The Gilbert-Elliott state changes on each packet, even reliable ones, to keep the bursts length independent of the channel
+    const bool isLost = SampleLoss();
+    if (isReliable)
+    {
+        const auto packetSize = GetPacketSize(*packet);
+        return Schedule(std::move(packet), packetSize, true, currentTime) ? 1 : 0;
+    }
+    if (isLost)
+    {
+        lostPacketNmb_++;
+        return 0;
+    }
+    const auto packetSize = GetPacketSize(*packet);
+    std::size_t scheduledNmb = 0;
+    if (SampleProbability(conditions_.duplicateProbability))
+    {
+        duplicatedPacketNmb_++;
+        if (Schedule(ClonePacket(*packet), packetSize, false, currentTime))
+        {
+            scheduledNmb++;
+        }
+    }
+    if (Schedule(std::move(packet), packetSize, false, currentTime))
+    {
+        scheduledNmb++;
+    }
+    return scheduledNmb;
+}
+
+std::unique_ptr<Packet> NetworkLink::PopReadyPacket(double currentTime)
+{
+    if (scheduledPackets_.empty() || scheduledPackets_.front().releaseTime > currentTime)
+    {
+        return nullptr;
+    }
+    std::pop_heap(scheduledPackets_.begin(), scheduledPackets_.end(), IsReleasedLater<ScheduledPacket>);
+    auto packet = std::move(scheduledPackets_.back().packet);
+    scheduledPackets_.pop_back();
+    return packet;
+}
+
+double NetworkLink::GetNextReleaseTime() const
+{
+    return scheduledPackets_.empty() ? std::numeric_limits<double>::infinity() : scheduledPackets_.front().releaseTime;
+}
+
+bool NetworkLink::Schedule(std::unique_ptr<Packet> packet, std::size_t packetSize, bool isReliable, double currentTime)
+{
+    double departureTime = currentTime;
+    if (conditions_.bandwidth > 0.0f)
+    {
+        departureTime = std::max(currentTime, linkFreeTime_) + static_cast<double>(packetSize) / conditions_.bandwidth;
+        //The router queue is full, unreliable packets are tail dropped
+        if (!isReliable && departureTime - currentTime > conditions_.maxQueueDelay)
+        {
+            lostPacketNmb_++;
+            return false;
+        }
+        linkFreeTime_ = departureTime;
+    }
+    double releaseTime = departureTime + SampleLatency();
+    if (isReliable)
+    {
+        //The reliable channel is ordered, a late packet holds back the next ones
+        releaseTime = std::max(releaseTime, lastReliableReleaseTime_);
+        lastReliableReleaseTime_ = releaseTime;
+    }
+    else if (SampleProbability(conditions_.reorderProbability))
+    {
+        reorderedPacketNmb_++;
+        releaseTime += conditions_.reorderDelay;
+    }
+    scheduledPackets_.push_back({ releaseTime, nextSequence_++, std::move(packet) });
+    std::push_heap(scheduledPackets_.begin(), scheduledPackets_.end(), IsReleasedLater<ScheduledPacket>);
+    return true;
+}
+
+double NetworkLink::SampleLatency()
+{
+    double latency = conditions_.latency;
+    switch (conditions_.latencyDistribution)
+    {
+    case LatencyDistribution::UNIFORM:
+    {
+        std::uniform_real_distribution<double> distribution(-conditions_.jitter, conditions_.jitter);
+        latency += distribution(generator_);
+        break;
+    }
+    case LatencyDistribution::NORMAL:
+    {
+        std::normal_distribution<double> distribution(0.0, conditions_.jitter);
+        latency += conditions_.jitter > 0.0f ? distribution(generator_) : 0.0;
+        break;
+    }
+    case LatencyDistribution::EXPONENTIAL:
+    {
+        if (conditions_.jitter > 0.0f)
+        {
+            std::exponential_distribution<double> distribution(1.0 / conditions_.jitter);
+            latency += distribution(generator_);
+        }
+        break;
+    }
+    default:
+        break;
+    }
+    return std::max(latency, 0.0);
+}
+
+bool NetworkLink::SampleLoss()
+{
+    if (isBadState_)
+    {
+        isBadState_ = !SampleProbability(conditions_.badToGoodProbability);
+    }
+    else
+    {
+        isBadState_ = SampleProbability(conditions_.goodToBadProbability);
+    }
+    return SampleProbability(isBadState_ ? conditions_.badLossProbability : conditions_.goodLossProbability);
+}
+
+bool NetworkLink::SampleProbability(float probability)
+{
+    if (probability <= 0.0f)
+    {
+        return false;
+    }
+    std::uniform_real_distribution<float> distribution(0.0f, 1.0f);
+    return distribution(generator_) < probability;
+}
+}
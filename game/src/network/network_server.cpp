@@ -4,8 +4,6 @@
 #include "utils/assert.h"
 
 #include <fmt/format.h>
-#include <chrono>
-
 
 
 #ifdef TRACY_ENABLE
@@ -17,8 +15,7 @@ namespace game
 void NetworkServer::SendReliablePacket(
     std::unique_ptr<Packet> packet)
 {
-    core::LogDebug(fmt::format("[Server] Sending TCP packet: {}",
-        std::to_string(static_cast<int>(packet->packetType))));
+    CORE_LOG_DEBUG("[Server] Sending TCP packet: {}", static_cast<int>(packet->packetType));
     for (PlayerNumber playerNumber = 0; playerNumber < maxPlayerNmb;
         playerNumber++)
     {
@@ -32,9 +29,9 @@ void NetworkServer::SendReliablePacket(
             switch (status)
             {
             case sf::Socket::NotReady:
-                core::LogDebug(fmt::format(
+                CORE_LOG_DEBUG(
                     "[Server] Error trying to send packet to Player: {} socket is not ready",
-                    playerNumber));
+                    playerNumber);
                 break;
             case sf::Socket::Disconnected:
                 break;
@@ -42,6 +39,14 @@ void NetworkServer::SendReliablePacket(
                 break;
             }
         }
+        if (status == sf::Socket::Done)
+        {
+            packetStats_.AddPacket(packet->packetType, PacketDirection::SENT, sendingPacket.getDataSize());
+        }
+        else
+        {
+            packetStats_.AddDroppedPacket(packet->packetType, PacketDirection::SENT);
+        }
     }
 }
 
@@ -53,7 +58,8 @@ void NetworkServer::SendUnreliablePacket(
     {
         if (clientInfoMap_[playerNumber].udpRemotePort == 0)
         {
-            core::LogDebug(fmt::format("[Warning] Trying to send UDP packet, but missing port!"));
+            CORE_LOG_DEBUG("[Warning] Trying to send UDP packet, but missing port!");
+            packetStats_.AddDroppedPacket(packet->packetType, PacketDirection::SENT);
             continue;
         }
 
@@ -66,25 +72,29 @@ void NetworkServer::SendUnreliablePacket(
         case sf::Socket::Done:
             //core::LogDebug("[Server] Sending UDP packet: " +
                 //std::to_string(static_cast<int>(packet->packetType)));
+            packetStats_.AddPacket(packet->packetType, PacketDirection::SENT, sendingPacket.getDataSize());
             break;
 
         case sf::Socket::Disconnected:
         {
-            core::LogDebug("[Server] Error while sending UDP packet, DISCONNECTED");
+            CORE_LOG_DEBUG("[Server] Error while sending UDP packet, DISCONNECTED");
             break;
         }
         case sf::Socket::NotReady:
-            core::LogDebug("[Server] Error while sending UDP packet, NOT READY");
+            CORE_LOG_DEBUG("[Server] Error while sending UDP packet, NOT READY");
 
             break;
 
         case sf::Socket::Error:
-            core::LogDebug("[Server] Error while sending UDP packet, DISCONNECTED");
+            CORE_LOG_DEBUG("[Server] Error while sending UDP packet, DISCONNECTED");
             break;
         default:
             break;
         }
-
+        if (status != sf::Socket::Done)
+        {
+            packetStats_.AddDroppedPacket(packet->packetType, PacketDirection::SENT);
+        }
     }
 
 }
@@ -109,7 +119,7 @@ void NetworkServer::Begin()
     {
         socket.setBlocking(false);
     }
-    core::LogDebug(fmt::format("[Server] Tcp Socket on port: {}", tcpPort_));
+    CORE_LOG_DEBUG("[Server] Tcp Socket on port: {}", tcpPort_);
 
     status = sf::Socket::Error;
     while (status != sf::Socket::Done)
@@ -121,18 +131,23 @@ void NetworkServer::Begin()
         }
     }
     udpSocket_.setBlocking(false);
-    core::LogDebug(fmt::format("[Server] Udp Socket on port: {}", udpPort_));
+    CORE_LOG_DEBUG("[Server] Udp Socket on port: {}", udpPort_);
+    packetStats_.SetDumpFile("server", fmt::format("server_{}_packet_stats.jsonl", tcpPort_));
+#ifdef ENABLE_DESYNC_CHECK
+    gameManager_.StartDesyncLog(fmt::format("server_{}.desynclog", tcpPort_));
+#endif
 
     status_ = status_ | OPEN;
 
 }
 
-void NetworkServer::Update([[maybe_unused]] sf::Time dt)
+void NetworkServer::Update(sf::Time dt)
 {
 
 #ifdef TRACY_ENABLE
     ZoneScoped;
 #endif
+    packetStats_.Update(dt);
     if (lastSocketIndex_ < maxPlayerNmb)
     {
         const sf::Socket::Status status = tcpListener_.accept(
@@ -141,8 +156,8 @@ void NetworkServer::Update([[maybe_unused]] sf::Time dt)
         {
             const auto remoteAddress = tcpSockets_[lastSocketIndex_].
                 getRemoteAddress();
-            core::LogDebug(fmt::format("[Server] New player connection with address: {} and port: {}",
-                remoteAddress.toString(), tcpSockets_[lastSocketIndex_].getRemotePort()));
+            CORE_LOG_DEBUG("[Server] New player connection with address: {} and port: {}",
+                remoteAddress.toString(), tcpSockets_[lastSocketIndex_].getRemotePort());
             status_ = status_ | (FIRST_PLAYER_CONNECT << lastSocketIndex_);
             lastSocketIndex_++;
         }
@@ -160,9 +175,9 @@ void NetworkServer::Update([[maybe_unused]] sf::Time dt)
             break;
         case sf::Socket::Disconnected:
         {
-            core::LogDebug(fmt::format(
+            CORE_LOG_DEBUG(
                 "[Error] Player Number {} is disconnected when receiving",
-                playerNumber + 1));
+                playerNumber + 1);
             status_ = status_ & ~(FIRST_PLAYER_CONNECT << playerNumber);
             auto endGame = std::make_unique<WinGamePacket>();
             SendReliablePacket(std::move(endGame));
@@ -172,13 +187,18 @@ void NetworkServer::Update([[maybe_unused]] sf::Time dt)
         default: break;
         }
     }
-    sf::Packet udpPacket;
-    sf::IpAddress address;
-    unsigned short port;
-    const auto status = udpSocket_.receive(udpPacket, address, port);
-    if (status == sf::Socket::Done)
+    //Receive all the pending UDP packets, inputs and pings of both players can arrive between two updates
+    auto status = sf::Socket::Done;
+    while (status == sf::Socket::Done)
     {
-        ReceiveNetPacket(udpPacket, PacketSocketSource::UDP, address, port);
+        sf::Packet udpPacket;
+        sf::IpAddress address;
+        unsigned short port;
+        status = udpSocket_.receive(udpPacket, address, port);
+        if (status == sf::Socket::Done)
+        {
+            ReceiveNetPacket(udpPacket, PacketSocketSource::UDP, address, port);
+        }
     }
 }
 
@@ -229,7 +249,7 @@ void NetworkServer::SpawnNewBall()
     spawnBallPacket->packetType = PacketType::SPAWN_BALL;
     spawnBallPacket->velocity = core::ConvertToBinary(velocity);
     spawnBallPacket->pos = core::ConvertToBinary(pos);
-    core::LogDebug("[Server] Spawn new ball");
+    CORE_LOG_DEBUG("[Server] Spawn new ball");
 
     SendReliablePacket(std::move(spawnBallPacket));
 }
@@ -238,7 +258,7 @@ void NetworkServer::SpawnNewBoundary(core::Vec2f pos)
     auto spawnBoundaryPacket = std::make_unique<SpawnBoundaryPacket>();
     spawnBoundaryPacket->packetType = PacketType::SPAWN_BOUNDARY;
     spawnBoundaryPacket->pos = core::ConvertToBinary(pos);
-    core::LogDebug("[Server] Spawn game boundary");
+    CORE_LOG_DEBUG("[Server] Spawn game boundary");
 
     SendReliablePacket(std::move(spawnBoundaryPacket));
 }
@@ -251,7 +271,7 @@ void NetworkServer::SpawnNewHome(PlayerNumber playerNumber)
     spawnHomePacket->packetType = PacketType::SPAWN_HOME;
     spawnHomePacket->pos = core::ConvertToBinary(pos);
     spawnHomePacket->playerNumber = playerNumber;
-    core::LogDebug("[Server] Spawn a player's home");
+    CORE_LOG_DEBUG("[Server] Spawn a player's home");
 
     SendReliablePacket(std::move(spawnHomePacket));
 }
@@ -264,7 +284,7 @@ void NetworkServer::SpawnNewHealthbar(PlayerNumber playerNumber)
     spawnHealthbarPacket->packetType = PacketType::SPAWN_HEALTHBAR;
     spawnHealthbarPacket->pos = core::ConvertToBinary(pos);
     spawnHealthbarPacket->playerNumber = playerNumber;
-    core::LogDebug("[Server] Spawn a player healthbar");
+    CORE_LOG_DEBUG("[Server] Spawn a player healthbar");
 
     SendReliablePacket(std::move(spawnHealthbarPacket));
 }
@@ -284,8 +304,8 @@ void NetworkServer::ProcessReceivePacket(
         const auto joinPacket = *static_cast<JoinPacket*>(packet.get());
         Server::ReceivePacket(std::move(packet));
         auto clientId = core::ConvertFromBinary<ClientId>(joinPacket.clientId);
-        core::LogDebug(fmt::format("[Server] Received Join Packet from: {} {}", static_cast<unsigned>(clientId),
-            (packetSource == PacketSocketSource::UDP ? fmt::format(" UDP with port: {}", port) : " TCP")));
+        CORE_LOG_DEBUG("[Server] Received Join Packet from: {} {}", static_cast<unsigned>(clientId),
+            (packetSource == PacketSocketSource::UDP ? fmt::format(" UDP with port: {}", port) : " TCP"));
         const auto it = std::find(clientMap_.begin(), clientMap_.end(), clientId);
         PlayerNumber playerNumber;
         if (it != clientMap_.end())
@@ -311,12 +331,6 @@ void NetworkServer::ProcessReceivePacket(
         else
         {
             SendReliablePacket(std::move(joinAckPacket));
-            //Calculate time difference
-            const auto clientTime = core::ConvertFromBinary<unsigned long>(joinPacket.startTime);
-            using namespace std::chrono;
-            const unsigned long deltaTime = static_cast<unsigned long>((duration_cast<milliseconds>(system_clock::now().time_since_epoch()).count())) - clientTime;
-            core::LogDebug(fmt::format("[Server] Client Server deltaTime: {}", deltaTime));
-            clientInfoMap_[playerNumber].timeDifference = deltaTime;
         }
         break;
     }
@@ -335,6 +349,7 @@ void NetworkServer::ReceiveNetPacket(sf::Packet& packet,
 
     if (receivedPacket != nullptr)
     {
+        packetStats_.AddPacket(receivedPacket->packetType, PacketDirection::RECEIVED, packet.getDataSize());
         ProcessReceivePacket(std::move(receivedPacket), packetSource, address, port);
     }
 }
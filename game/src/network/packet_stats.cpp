@@ -0,0 +1,209 @@
+#include "network/packet_stats.h"
+
+#include <imgui.h>
+#include <fmt/format.h>
+
+#include "utils/log.h"
+
+#ifdef TRACY_ENABLE
+#include <Tracy.hpp>
+#endif
+
+namespace game
+{
+void PacketStats::AddPacket(PacketType packetType, PacketDirection direction, std::size_t byteNmb)
+{
+    auto& counter = counters_[static_cast<std::size_t>(direction)][static_cast<std::size_t>(packetType)];
+    counter.packetNmb++;
+    counter.byteNmb += byteNmb;
+}
+
+void PacketStats::AddDroppedPacket(PacketType packetType, PacketDirection direction)
+{
+    counters_[static_cast<std::size_t>(direction)][static_cast<std::size_t>(packetType)].dropNmb++;
+}
+
+void PacketStats::AddOutOfOrderPacket(PacketType packetType)
+{
+    counters_[static_cast<std::size_t>(PacketDirection::RECEIVED)][static_cast<std::size_t>(packetType)].outOfOrderNmb++;
+}
+
+void PacketStats::AddLateInput()
+{
+    lateInputNmb_++;
+}
+
+void PacketStats::Update(sf::Time dt)
+{
+
+#ifdef TRACY_ENABLE
+    ZoneScoped;
+#endif
+    totalTime_ += dt.asSeconds();
+    rateTimer_ += dt.asSeconds();
+    if (rateTimer_ >= packetStatsRatePeriod)
+    {
+        for (std::size_t direction = 0; direction < directionNmb; direction++)
+        {
+            for (std::size_t packetType = 0; packetType < packetTypeNmb; packetType++)
+            {
+                const auto& counter = counters_[direction][packetType];
+                const auto& windowCounter = windowCounters_[direction][packetType];
+                packetRates_[direction][packetType] = static_cast<float>(counter.packetNmb - windowCounter.packetNmb) / rateTimer_;
+                byteRates_[direction][packetType] = static_cast<float>(counter.byteNmb - windowCounter.byteNmb) / rateTimer_;
+            }
+        }
+        windowCounters_ = counters_;
+        rateTimer_ = 0.0f;
+    }
+    if (!dumpFile_.is_open())
+    {
+        return;
+    }
+    dumpTimer_ += dt.asSeconds();
+    if (dumpTimer_ >= packetStatsDumpPeriod)
+    {
+        dumpFile_ << ToJson() << '\n';
+        dumpFile_.flush();
+        dumpTimer_ = 0.0f;
+    }
+}
+
+void PacketStats::DrawImGui() const
+{
+    if (!ImGui::CollapsingHeader("Packet Stats"))
+    {
+        return;
+    }
+    ImGui::Text("Sent: %.0f B/s, Received: %.0f B/s",
+        GetByteRate(PacketDirection::SENT), GetByteRate(PacketDirection::RECEIVED));
+    ImGui::Text("Late Inputs: %llu", static_cast<unsigned long long>(lateInputNmb_));
+    if (!ImGui::BeginTable("PacketStatsTable", 8))
+    {
+        return;
+    }
+    ImGui::TableSetupColumn("Type");
+    ImGui::TableSetupColumn("Sent");
+    ImGui::TableSetupColumn("Sent B/s");
+    ImGui::TableSetupColumn("Received");
+    ImGui::TableSetupColumn("Received B/s");
+    ImGui::TableSetupColumn("Bytes");
+    ImGui::TableSetupColumn("Drops");
+    ImGui::TableSetupColumn("Out of Order");
+    ImGui::TableHeadersRow();
+    constexpr auto sent = static_cast<std::size_t>(PacketDirection::SENT);
+    constexpr auto received = static_cast<std::size_t>(PacketDirection::RECEIVED);
+    for (std::size_t packetType = 0; packetType < packetTypeNmb; packetType++)
+    {
+        const auto& sentCounter = counters_[sent][packetType];
+        const auto& receivedCounter = counters_[received][packetType];
+        if (sentCounter.packetNmb == 0 && receivedCounter.packetNmb == 0 &&
+            sentCounter.dropNmb == 0 && receivedCounter.dropNmb == 0)
+        {
+            continue;
+        }
+        ImGui::TableNextRow();
+        ImGui::TableNextColumn();
+        ImGui::TextUnformatted(GetPacketTypeName(static_cast<PacketType>(packetType)).data());
+        ImGui::TableNextColumn();
+        ImGui::Text("%llu", static_cast<unsigned long long>(sentCounter.packetNmb));
+        ImGui::TableNextColumn();
+        ImGui::Text("%.0f", byteRates_[sent][packetType]);
+        ImGui::TableNextColumn();
+        ImGui::Text("%llu", static_cast<unsigned long long>(receivedCounter.packetNmb));
+        ImGui::TableNextColumn();
+        ImGui::Text("%.0f", byteRates_[received][packetType]);
+        ImGui::TableNextColumn();
+        ImGui::Text("%llu", static_cast<unsigned long long>(sentCounter.byteNmb + receivedCounter.byteNmb));
+        ImGui::TableNextColumn();
+        ImGui::Text("%llu", static_cast<unsigned long long>(sentCounter.dropNmb + receivedCounter.dropNmb));
+        ImGui::TableNextColumn();
+        ImGui::Text("%llu", static_cast<unsigned long long>(receivedCounter.outOfOrderNmb));
+    }
+    ImGui::EndTable();
+}
+
+void PacketStats::SetDumpFile(std::string_view name, std::string_view path)
+{
+    name_ = name;
+    if (!isDumpEnabled_)
+    {
+        return;
+    }
+    dumpFile_.open(std::string(path), std::ios::out | std::ios::app);
+    if (!dumpFile_.is_open())
+    {
+        CORE_LOG_WARNING("Could not open packet stats dump file: {}", path);
+    }
+}
+
+void PacketStats::SetDumpEnabled(bool isDumpEnabled)
+{
+    isDumpEnabled_ = isDumpEnabled;
+    if (!isDumpEnabled_ && dumpFile_.is_open())
+    {
+        dumpFile_.close();
+    }
+}
+
+std::string PacketStats::ToJson() const
+{
+    constexpr std::array<std::string_view, directionNmb> directionNames{ "sent", "received" };
+    std::string json = fmt::format(R"({{"source":"{}","time":{:.3f},"late_inputs":{},"types":{{)",
+        name_, totalTime_, lateInputNmb_);
+    bool isFirstType = true;
+    for (std::size_t packetType = 0; packetType < packetTypeNmb; packetType++)
+    {
+        if (!isFirstType)
+        {
+            json += ',';
+        }
+        isFirstType = false;
+        json += fmt::format(R"("{}":{{)", GetPacketTypeName(static_cast<PacketType>(packetType)));
+        for (std::size_t direction = 0; direction < directionNmb; direction++)
+        {
+            const auto& counter = counters_[direction][packetType];
+            json += fmt::format(R"({}"{}":{{"packets":{},"bytes":{},"drops":{},"out_of_order":{},"packets_per_s":{:.1f},"bytes_per_s":{:.1f}}})",
+                direction == 0 ? "" : ",",
+                directionNames[direction],
+                counter.packetNmb,
+                counter.byteNmb,
+                counter.dropNmb,
+                counter.outOfOrderNmb,
+                packetRates_[direction][packetType],
+                byteRates_[direction][packetType]);
+        }
+        json += '}';
+    }
+    json += "}}";
+    return json;
+}
+
+const PacketCounter& PacketStats::GetCounter(PacketType packetType, PacketDirection direction) const
+{
+    return counters_[static_cast<std::size_t>(direction)][static_cast<std::size_t>(packetType)];
+}
+
+PacketCounter PacketStats::GetTotalCounter(PacketDirection direction) const
+{
+    PacketCounter total;
+    for (const auto& counter : counters_[static_cast<std::size_t>(direction)])
+    {
+        total.packetNmb += counter.packetNmb;
+        total.byteNmb += counter.byteNmb;
+        total.dropNmb += counter.dropNmb;
+        total.outOfOrderNmb += counter.outOfOrderNmb;
+    }
+    return total;
+}
+
+float PacketStats::GetByteRate(PacketDirection direction) const
+{
+    float byteRate = 0.0f;
+    for (const auto rate : byteRates_[static_cast<std::size_t>(direction)])
+    {
+        byteRate += rate;
+    }
+    return byteRate;
+}
+}
@@ -0,0 +1,194 @@
+#include "network/replay_app.h"
+
+#include <algorithm>
+#include <span>
+
+#include <imgui.h>
+
+#include "engine/globals.h"
+
+#ifdef TRACY_ENABLE
+#include <Tracy.hpp>
+#endif
+
+namespace game
+{
+ReplayApp::ReplayApp(std::string_view path) :
+    path_(path),
+    gameManager_(*this)
+{
+}
+
+void ReplayApp::Begin()
+{
+
+#ifdef TRACY_ENABLE
+    ZoneScoped;
+#endif
+    windowSize_ = core::windowSize;
+    gameManager_.SetWindowSize(windowSize_);
+    gameManager_.Begin();
+    if (!reader_.Open(path_))
+    {
+        return;
+    }
+    SpawnWorld();
+    Seek(reader_.GetFirstFrame());
+}
+
+void ReplayApp::SpawnWorld()
+{
+    for (PlayerNumber playerNumber = 0; playerNumber < maxPlayerNmb; playerNumber++)
+    {
+        gameManager_.SpawnPlayer(playerNumber, spawnPositions[playerNumber] * 3.0f);
+    }
+    gameManager_.SpawnBoundary(topBoundaryPos);
+    gameManager_.SpawnBoundary(bottomBoundaryPos);
+    for (PlayerNumber playerNumber = 0; playerNumber < maxPlayerNmb; playerNumber++)
+    {
+        gameManager_.SpawnHome(playerNumber, playerNumber == 0 ? leftHomePos : rightHomePos);
+        const auto healthBarPos = playerNumber == 0 ? leftHealthbarPos : rightHealthbarPos;
+        gameManager_.SpawnHealthBar(healthBarPos);
+        gameManager_.SpawnHealthBarBackground(playerNumber, healthBarPos);
+    }
+    //The ball position and velocity come from the keyframes
+    gameManager_.SpawnBall(core::Vec2f::zero(), core::Vec2f::zero());
+}
+
+void ReplayApp::Update(sf::Time dt)
+{
+
+#ifdef TRACY_ENABLE
+    ZoneScoped;
+#endif
+    if (!isPlaying_)
+    {
+        return;
+    }
+    playTimer_ += dt.asSeconds() * playSpeed_;
+    while (playTimer_ > fixedPeriod)
+    {
+        playTimer_ -= fixedPeriod;
+        if (!StepFrame())
+        {
+            isPlaying_ = false;
+            playTimer_ = 0.0f;
+            break;
+        }
+    }
+}
+
+void ReplayApp::End()
+{
+    gameManager_.End();
+}
+
+bool ReplayApp::Seek(Frame frame)
+{
+
+#ifdef TRACY_ENABLE
+    ZoneScoped;
+#endif
+    if (reader_.GetSegmentNmb() == 0)
+    {
+        return false;
+    }
+    frame = std::clamp(frame, reader_.GetFirstFrame(), reader_.GetLastFrame());
+    const auto segmentIndex = reader_.FindSegment(frame);
+    //Seeking forward in the loaded segment only simulates the frames in between
+    if (!isSegmentLoaded_ || segmentIndex != segmentIndex_ || frame < gameManager_.GetCurrentFrame())
+    {
+        if (!isSegmentLoaded_ || segmentIndex != segmentIndex_)
+        {
+            isSegmentLoaded_ = false;
+            if (!reader_.ReadSegment(segmentIndex, segment_))
+            {
+                return false;
+            }
+            segmentIndex_ = segmentIndex;
+        }
+        if (!gameManager_.LoadReplayKeyframe(segment_.keyframe, segment_.snapshot))
+        {
+            //The world may be partly rewound, the next seek loads the keyframe again
+            isSegmentLoaded_ = false;
+            return false;
+        }
+        isSegmentLoaded_ = true;
+    }
+    frame = std::min(frame, segment_.GetLastFrame());
+    const auto currentFrame = gameManager_.GetCurrentFrame();
+    if (frame > currentFrame)
+    {
+        gameManager_.ReplayInputs(currentFrame + 1,
+            std::span(segment_.inputs).subspan(currentFrame - segment_.keyframe, frame - currentFrame));
+    }
+    gameManager_.UpdateWorldVisuals();
+    return true;
+}
+
+bool ReplayApp::StepFrame()
+{
+    if (!isSegmentLoaded_)
+    {
+        return false;
+    }
+    auto nextFrame = gameManager_.GetCurrentFrame() + 1;
+    if (nextFrame > segment_.GetLastFrame())
+    {
+        if (segmentIndex_ + 1 >= reader_.GetSegmentNmb())
+        {
+            return false;
+        }
+        //Frames missing between two segments are skipped to the next keyframe
+        nextFrame = std::max(nextFrame, reader_.GetKeyframe(segmentIndex_ + 1));
+    }
+    return Seek(nextFrame);
+}
+
+void ReplayApp::DrawImGui()
+{
+    ImGui::Begin("Replay");
+    ImGui::Text("%s", path_.c_str());
+    if (reader_.GetSegmentNmb() == 0)
+    {
+        ImGui::Text("Could not open the replay");
+        ImGui::End();
+        return;
+    }
+    int frame = static_cast<int>(gameManager_.GetCurrentFrame());
+    if (ImGui::SliderInt("Frame", &frame,
+        static_cast<int>(reader_.GetFirstFrame()), static_cast<int>(reader_.GetLastFrame())))
+    {
+        Seek(static_cast<Frame>(frame));
+    }
+    if (ImGui::Button(isPlaying_ ? "Pause" : "Play"))
+    {
+        isPlaying_ = !isPlaying_;
+    }
+    ImGui::SameLine();
+    if (ImGui::Button("Step"))
+    {
+        isPlaying_ = false;
+        StepFrame();
+    }
+    ImGui::SliderFloat("Speed", &playSpeed_, 0.25f, 4.0f);
+    ImGui::Text("Keyframes: %zu (every %u frames)", reader_.GetSegmentNmb(),
+        static_cast<unsigned>(reader_.GetHeader().keyframePeriod));
+    gameManager_.DrawImGui();
+    ImGui::End();
+}
+
+void ReplayApp::OnEvent(const sf::Event& event)
+{
+    switch (event.type)
+    {
+    case sf::Event::Resized:
+    {
+        windowSize_ = sf::Vector2u(event.size.width, event.size.height);
+        gameManager_.SetWindowSize(windowSize_);
+        break;
+    }
+    default:;
+    }
+}
+}
@@ -31,7 +31,7 @@ void Server::ReceivePacket(std::unique_ptr<Packet> packet)
             //Player joined twice!
             return;
         }
-            core::LogDebug("Managing Received Packet Join from: " + std::to_string(static_cast<unsigned>(clientId)));
+            CORE_LOG_DEBUG("Managing Received Packet Join from: {}", static_cast<unsigned>(clientId));
             clientMap_[lastPlayerNumber_] = clientId;
 
             
@@ -51,7 +51,8 @@ void Server::ReceivePacket(std::unique_ptr<Packet> packet)
 
                 auto startGamePacket = std::make_unique<StartGamePacket>();
                 startGamePacket->packetType = PacketType::START_GAME;
-                core::LogDebug("Send Start Game Packet");
+                startGamePacket->startTime = core::ConvertToBinary(GetNetworkTime() + startDelay * 1000);
+                CORE_LOG_DEBUG("Send Start Game Packet");
                 SendReliablePacket(std::move(startGamePacket));
             }
 
@@ -63,6 +64,10 @@ void Server::ReceivePacket(std::unique_ptr<Packet> packet)
         const auto* playerInputPacket = static_cast<const PlayerInputPacket*>(packet.get());
         const auto playerNumber = playerInputPacket->playerNumber;
         const auto inputFrame = core::ConvertFromBinary<Frame>(playerInputPacket->currentFrame);
+        if (inputFrame < gameManager_.GetRollbackManager().GetLastReceivedFrame(playerNumber))
+        {
+            packetStats_.AddOutOfOrderPacket(PacketType::INPUT);
+        }
 
         for (std::uint32_t i = 0; i < playerInputPacket->inputs.size(); i++)
         {
@@ -109,7 +114,7 @@ void Server::ReceivePacket(std::unique_ptr<Packet> packet)
             const auto winner = gameManager_.CheckWinner();
             if (winner != INVALID_PLAYER)
             {
-                core::LogDebug(fmt::format("Server declares P{} a winner", static_cast<unsigned>(winner) + 1));
+                CORE_LOG_DEBUG("Server declares P{} a winner", static_cast<unsigned>(winner) + 1);
                 auto winGamePacket = std::make_unique<WinGamePacket>();
                 winGamePacket->winner = winner;
                 SendReliablePacket(std::move(winGamePacket));
@@ -119,10 +124,23 @@ void Server::ReceivePacket(std::unique_ptr<Packet> packet)
 
         break;
     }
+    case PacketType::RESYNC_REQUEST:
+    {
+        const auto* resyncRequestPacket = static_cast<const ResyncRequestPacket*>(packet.get());
+        CORE_LOG_DEBUG("Server received resync request from P{} at frame {}",
+            static_cast<unsigned>(resyncRequestPacket->playerNumber) + 1,
+            core::ConvertFromBinary<Frame>(resyncRequestPacket->desyncFrame));
+        auto worldSnapshotPacket = std::make_unique<WorldSnapshotPacket>();
+        worldSnapshotPacket->validateFrame = core::ConvertToBinary(gameManager_.GetLastValidateFrame());
+        worldSnapshotPacket->snapshot = gameManager_.GetRollbackManager().SerializeValidateState();
+        SendReliablePacket(std::move(worldSnapshotPacket));
+        break;
+    }
     case PacketType::PING:
     {
         auto pingPacket = std::make_unique<PingPacket>();
         *pingPacket = *static_cast<PingPacket*>(packet.get());
+        pingPacket->serverTime = core::ConvertToBinary(GetNetworkTime());
         SendUnreliablePacket(std::move(pingPacket));
         break;
     }
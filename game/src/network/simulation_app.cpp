@@ -46,17 +46,45 @@ void SimulationApp::Begin()
     ZoneScoped;
 #endif
     windowSize_ = core::windowSize;
-    for (auto& framebuffer : clientsFramebuffers_)
+    if (isHeadless_)
     {
-        framebuffer.create(windowSize_.x / 2u, windowSize_.y);
+        //The headless updates can be faster than real time, the start countdown and the pings follow the simulated time
+        simulatedTime_ = 1'000'000;
+        SetSimulatedNetworkTime(simulatedTime_);
+        bots_.clear();
+        for (PlayerNumber playerNumber = 0; playerNumber < maxPlayerNmb; playerNumber++)
+        {
+            bots_.emplace_back(BotType::SCRIPTED, playerNumber, playerNumber + 1u);
+        }
+    }
+    else
+    {
+        for (auto& framebuffer : clientsFramebuffers_)
+        {
+            framebuffer.create(windowSize_.x / 2u, windowSize_.y);
+        }
     }
     for (auto& client : clients_)
     {
+        client->SetHeadless(isHeadless_);
         client->SetWindowSize(sf::Vector2u(windowSize_.x / 2u, windowSize_.y));
         client->Begin();
     }
+    //The simulation is a debugging tool, its server always dumps the packet stats
+    server_.SetPacketStatsDumpEnabled(true);
+    server_.SetPacketStatsDumpFile("simulation_server", "simulation_server_packet_stats.jsonl");
+#ifdef ENABLE_DESYNC_CHECK
+    server_.StartDesyncLog("simulation_server.desynclog");
+#endif
     server_.Begin();
-
+    if (isHeadless_)
+    {
+        //Without ImGui, the clients join at the start
+        for (auto& client : clients_)
+        {
+            client->Join();
+        }
+    }
 }
 
 void SimulationApp::Update(sf::Time dt)
@@ -64,10 +92,23 @@ void SimulationApp::Update(sf::Time dt)
 #ifdef TRACY_ENABLE
     ZoneScoped;
 #endif
-    //Checking if keys are down
-    for (std::size_t i = 0; i < clients_.size(); i++)
+    if (isHeadless_)
     {
-        clients_[i]->SetPlayerInput(GetPlayerInput(static_cast<int>(i)));
+        simulatedTime_ += static_cast<NetworkTime>(dt.asMicroseconds());
+        SetSimulatedNetworkTime(simulatedTime_);
+        for (PlayerNumber playerNumber = 0; playerNumber < maxPlayerNmb; playerNumber++)
+        {
+            clients_[playerNumber]->SetPlayerInput(bots_[playerNumber].GetInput(updateNmb_));
+        }
+        updateNmb_++;
+    }
+    else
+    {
+        //Checking if keys are down
+        for (std::size_t i = 0; i < clients_.size(); i++)
+        {
+            clients_[i]->SetPlayerInput(GetPlayerInput(static_cast<int>(i)));
+        }
     }
 
 
@@ -88,6 +129,10 @@ void SimulationApp::End()
         client->End();
     }
     server_.End();
+    if (isHeadless_)
+    {
+        ResetSimulatedNetworkTime();
+    }
 }
 
 void SimulationApp::DrawImGui()
@@ -26,6 +26,15 @@ void SimulationClient::Begin()
                                   std::numeric_limits<std::underlying_type_t<ClientId>>::max()) };
 #ifdef ENABLE_SQLITE
     debugDb_.Open(fmt::format("Client_{}.db", static_cast<unsigned>(clientId_)));
+#endif
+#ifdef ENABLE_MATCH_LOG
+    matchLog_.Open(fmt::format("Client_{}.matchlog", static_cast<unsigned>(clientId_)));
+#endif
+#ifdef ENABLE_REPLAY_RECORD
+    gameManager_.StartReplayRecording(fmt::format("Client_{}.replay", static_cast<unsigned>(clientId_)));
+#endif
+#ifdef ENABLE_DESYNC_CHECK
+    gameManager_.StartDesyncLog(fmt::format("Client_{}.desynclog", static_cast<unsigned>(clientId_)));
 #endif
     //JOIN packet
     gameManager_.Begin();
@@ -51,6 +60,12 @@ void SimulationClient::End()
 #ifdef ENABLE_SQLITE
     debugDb_.Close();
 #endif
+#ifdef ENABLE_MATCH_LOG
+    matchLog_.Close();
+#endif
+#ifdef ENABLE_REPLAY_RECORD
+    gameManager_.StopReplayRecording();
+#endif
 
 }
 
@@ -74,19 +89,24 @@ void SimulationClient::SetPlayerInput(PlayerInput playerInput)
 
 }
 
+void SimulationClient::Join()
+{
+    auto joinPacket = std::make_unique<JoinPacket>();
+    const auto* clientIdPtr = reinterpret_cast<std::uint8_t*>(&clientId_);
+    for (std::size_t i = 0; i < sizeof(clientId_); i++)
+    {
+        joinPacket->clientId[i] = clientIdPtr[i];
+    }
+    SendReliablePacket(std::move(joinPacket));
+}
+
 void SimulationClient::DrawImGui()
 {
     const auto windowName = "Client " + std::to_string(static_cast<unsigned>(clientId_));
     ImGui::Begin(windowName.c_str());
     if (gameManager_.GetPlayerNumber() == INVALID_PLAYER && ImGui::Button("Spawn Player"))
     {
-        auto joinPacket = std::make_unique<JoinPacket>();
-        const auto* clientIdPtr = reinterpret_cast<std::uint8_t*>(&clientId_);
-        for (std::size_t i = 0; i < sizeof(clientId_); i++)
-        {
-            joinPacket->clientId[i] = clientIdPtr[i];
-        }
-        SendReliablePacket(std::move(joinPacket));
+        Join();
     }
     gameManager_.DrawImGui();
     if (srtt_ > 0.0f)
@@ -95,17 +115,21 @@ void SimulationClient::DrawImGui()
         ImGui::Text("RTTVAR: %f", rttvar_);
         ImGui::Text("RTO: %f", rto_);
     }
+    ImGui::Text("Clock Offset: %lld us (%zu samples)",
+        static_cast<long long>(clockSync_.GetOffset()), clockSync_.GetSampleCount());
+    //Simulated packets are counted by the SimulationServer, only the late inputs are counted here
+    packetStats_.DrawImGui();
     ImGui::End();
 }
 
 void SimulationClient::SendUnreliablePacket(std::unique_ptr<Packet> packet)
 {
-    server_.PutPacketInReceiveQueue(std::move(packet),true);
+    server_.PutPacketInReceiveQueue(*this, std::move(packet), true);
 }
 
 void SimulationClient::SendReliablePacket(std::unique_ptr<Packet> packet)
 {
-    server_.PutPacketInReceiveQueue(std::move(packet),false);
+    server_.PutPacketInReceiveQueue(*this, std::move(packet), false);
 }
 
 void SimulationClient::ReceivePacket(const Packet* packet)
@@ -116,8 +140,7 @@ void SimulationClient::ReceivePacket(const Packet* packet)
     {
     case PacketType::JOIN: break;
     case PacketType::SPAWN_PLAYER: break;
-    case PacketType
-        :
+    case PacketType::INPUT:
     {
         auto* inputPacket = static_cast<const PlayerInputPacket*>(packet);
         debugDb_.StorePacket(inputPacket);
@@ -4,6 +4,10 @@
 #include <maths/basic.h>
 #include <utils/conversion.h>
 #include <utils/log.h>
+#include <utils/assert.h>
+#include <fmt/format.h>
+
+#include <algorithm>
 
 #ifdef TRACY_ENABLE
 #include <Tracy.hpp>
@@ -11,13 +15,65 @@
 
 namespace game
 {
+namespace
+{
+bool DrawLinkConditions(const char* label, LinkConditions& conditions)
+{
+    if (!ImGui::TreeNode(label))
+    {
+        return false;
+    }
+    constexpr std::array<const char*, static_cast<std::size_t>(LatencyDistribution::LENGTH)> distributionNames
+    {
+        "Uniform",
+        "Normal",
+        "Exponential"
+    };
+    int distribution = static_cast<int>(conditions.latencyDistribution);
+    if (ImGui::Combo("Latency Distribution", &distribution, distributionNames.data(), static_cast<int>(distributionNames.size())))
+    {
+        conditions.latencyDistribution = static_cast<LatencyDistribution>(distribution);
+    }
+    ImGui::SliderFloat("Latency", &conditions.latency, 0.0f, 1.0f);
+    ImGui::SliderFloat("Jitter", &conditions.jitter, 0.0f, 0.5f);
+    ImGui::SliderFloat("Good To Bad", &conditions.goodToBadProbability, 0.0f, 1.0f);
+    ImGui::SliderFloat("Bad To Good", &conditions.badToGoodProbability, 0.0f, 1.0f);
+    ImGui::SliderFloat("Good Loss", &conditions.goodLossProbability, 0.0f, 1.0f);
+    ImGui::SliderFloat("Bad Loss", &conditions.badLossProbability, 0.0f, 1.0f);
+    ImGui::SliderFloat("Reorder", &conditions.reorderProbability, 0.0f, 1.0f);
+    ImGui::SliderFloat("Reorder Delay", &conditions.reorderDelay, 0.0f, 0.5f);
+    ImGui::SliderFloat("Duplicate", &conditions.duplicateProbability, 0.0f, 1.0f);
+    ImGui::SliderFloat("Bandwidth (B/s)", &conditions.bandwidth, 0.0f, 100'000.0f);
+    ImGui::SliderFloat("Max Queue Delay", &conditions.maxQueueDelay, 0.0f, 2.0f);
+    ImGui::TreePop();
+    return true;
+}
+
+void DrawLinkState(const char* label, const NetworkLink& link)
+{
+    ImGui::Text("%s: %zu scheduled, %llu lost, %llu duplicated, %llu reordered%s",
+        label,
+        link.GetScheduledPacketNmb(),
+        static_cast<unsigned long long>(link.GetLostPacketNmb()),
+        static_cast<unsigned long long>(link.GetDuplicatedPacketNmb()),
+        static_cast<unsigned long long>(link.GetReorderedPacketNmb()),
+        link.IsInBadState() ? " (bad state)" : "");
+}
+}
+
 SimulationServer::SimulationServer(std::array<std::unique_ptr<SimulationClient>, 2>& clients) : clients_(clients)
 {
+    uplinks_.reserve(clients_.size());
+    downlinks_.reserve(clients_.size());
+    for (std::size_t i = 0; i < clients_.size(); i++)
+    {
+        uplinks_.emplace_back(uplinkConditions_);
+        downlinks_.emplace_back(downlinkConditions_);
+    }
 }
 
 void SimulationServer::Begin()
 {
-
 }
 
 void SimulationServer::Update(sf::Time dt)
@@ -26,39 +82,31 @@ void SimulationServer::Update(sf::Time dt)
 #ifdef TRACY_ENABLE
     ZoneScoped;
 #endif
-    auto packetIt = receivedPackets_.begin();
-    while (packetIt != receivedPackets_.end())
+    packetStats_.Update(dt);
+    currentTime_ += dt.asSeconds();
+    //The packets of all the clients reach the server in release time order, the first client wins a tie
+    while (true)
     {
-        packetIt->currentTime -= dt.asSeconds();
-        if (packetIt->currentTime <= 0.0f)
+        const auto uplinkIt = std::min_element(uplinks_.begin(), uplinks_.end(), [](const NetworkLink& a, const NetworkLink& b)
+            {
+                return a.GetNextReleaseTime() < b.GetNextReleaseTime();
+            });
+        if (uplinkIt == uplinks_.end())
         {
-            ProcessReceivePacket(std::move(packetIt->packet));
-
-            packetIt = receivedPackets_.erase(packetIt);
+            break;
         }
-        else
+        auto packet = uplinkIt->PopReadyPacket(currentTime_);
+        if (packet == nullptr)
         {
-            ++packetIt;
+            break;
         }
-
+        ProcessReceivePacket(std::move(packet));
     }
-
-    packetIt = sentPackets_.begin();
-    while (packetIt != sentPackets_.end())
+    for (std::size_t i = 0; i < downlinks_.size(); i++)
     {
-        packetIt->currentTime -= dt.asSeconds();
-        if (packetIt->currentTime <= 0.0f)
+        while (const auto packet = downlinks_[i].PopReadyPacket(currentTime_))
         {
-            for (auto& client : clients_)
-            {
-                client->ReceivePacket(packetIt->packet.get());
-            }
-            packetIt->packet = nullptr;
-            packetIt = sentPackets_.erase(packetIt);
-        }
-        else
-        {
-            ++packetIt;
+            clients_[i]->ReceivePacket(packet.get());
         }
     }
 }
@@ -70,56 +118,88 @@ void SimulationServer::End()
 void SimulationServer::DrawImGui()
 {
     ImGui::Begin("Server");
-    float minDelay = avgDelay_ - marginDelay_;
-    float maxDelay = avgDelay_ + marginDelay_;
-    bool hasDelayChanged = false;
-    hasDelayChanged = hasDelayChanged || ImGui::SliderFloat("Min Delay", &minDelay, 0.01f, maxDelay);
-    hasDelayChanged = hasDelayChanged || ImGui::SliderFloat("Max Delay", &maxDelay, minDelay, 1.0f);
-    if (hasDelayChanged)
+    DrawLinkConditions("Uplink (Client to Server)", uplinkConditions_);
+    DrawLinkConditions("Downlink (Server to Client)", downlinkConditions_);
+    for (std::size_t i = 0; i < clients_.size(); i++)
     {
-        avgDelay_ = (maxDelay + minDelay) / 2.0f;
-        marginDelay_ = (maxDelay - minDelay) / 2.0f;
+        DrawLinkState(fmt::format("Uplink {}", i).c_str(), uplinks_[i]);
+        DrawLinkState(fmt::format("Downlink {}", i).c_str(), downlinks_[i]);
     }
-    ImGui::SliderFloat("Packet Loss", &packetLoss_, 0.0f, 1.0f);
+    packetStats_.DrawImGui();
     ImGui::End();
 }
 
-void SimulationServer::PutPacketInSendingQueue(std::unique_ptr<Packet> packet)
+void SimulationServer::SetLinkConditions(const LinkConditions& uplinkConditions, const LinkConditions& downlinkConditions)
 {
-    sentPackets_.push_back({ avgDelay_ + core::RandomRange(-marginDelay_, marginDelay_), std::move(packet) });
+    uplinkConditions_ = uplinkConditions;
+    downlinkConditions_ = downlinkConditions;
 }
 
-void SimulationServer::PutPacketInReceiveQueue(std::unique_ptr<Packet> packet, bool unreliable)
+void SimulationServer::SetSeed(std::uint32_t seed)
 {
-    if(unreliable)
+    for (std::size_t i = 0; i < uplinks_.size(); i++)
     {
-        //Packet loss implementation
-        if(core::RandomRange(0.0f, 1.0f) < packetLoss_)
+        uplinks_[i].SetSeed(seed + static_cast<std::uint32_t>(2 * i));
+        downlinks_[i].SetSeed(seed + static_cast<std::uint32_t>(2 * i + 1));
+    }
+    generator_.seed(seed + static_cast<std::uint32_t>(2 * uplinks_.size()));
+}
+
+void SimulationServer::PutPacketInSendingQueue(std::unique_ptr<Packet> packet, bool isReliable)
+{
+
+#ifdef TRACY_ENABLE
+    ZoneScoped;
+#endif
+    const auto packetType = packet->packetType;
+    const auto packetSize = GetPacketSize(*packet);
+    for (std::size_t i = 0; i < downlinks_.size(); i++)
+    {
+        //Each client has its own link, the last one takes the original packet
+        auto sentPacket = i + 1 == downlinks_.size() ? std::move(packet) : ClonePacket(*packet);
+        if (downlinks_[i].Send(std::move(sentPacket), isReliable, currentTime_) == 0)
         {
-            return;
+            packetStats_.AddDroppedPacket(packetType, PacketDirection::SENT);
+            continue;
         }
+        packetStats_.AddPacket(packetType, PacketDirection::SENT, packetSize);
+    }
+}
+
+void SimulationServer::PutPacketInReceiveQueue(const SimulationClient& client, std::unique_ptr<Packet> packet, bool unreliable)
+{
+    const auto clientIt = std::find_if(clients_.begin(), clients_.end(), [&client](const auto& simulationClient)
+        {
+            return simulationClient.get() == &client;
+        });
+    gpr_assert(clientIt != clients_.end(), "Packet sent by an unknown simulation client");
+    const auto clientIndex = static_cast<std::size_t>(std::distance(clients_.begin(), clientIt));
+    const auto packetType = packet->packetType;
+    if (uplinks_[clientIndex].Send(std::move(packet), !unreliable, currentTime_) == 0)
+    {
+        packetStats_.AddDroppedPacket(packetType, PacketDirection::RECEIVED);
     }
-    receivedPackets_.push_back({ avgDelay_ + core::RandomRange(-marginDelay_, marginDelay_), std::move(packet) });
 }
 
 void SimulationServer::SendReliablePacket(std::unique_ptr<Packet> packet)
 {
-    PutPacketInSendingQueue(std::move(packet));
+    PutPacketInSendingQueue(std::move(packet), true);
 }
 
 void SimulationServer::SendUnreliablePacket(std::unique_ptr<Packet> packet)
 {
-    PutPacketInSendingQueue(std::move(packet));
+    PutPacketInSendingQueue(std::move(packet), false);
 }
 
 void SimulationServer::ProcessReceivePacket(std::unique_ptr<Packet> packet)
 {
+    packetStats_.AddPacket(packet->packetType, PacketDirection::RECEIVED, GetPacketSize(*packet));
     Server::ReceivePacket(std::move(packet));
 }
 
 void SimulationServer::SpawnNewPlayer(ClientId clientId, PlayerNumber playerNumber)
 {
-    core::LogDebug("[Server] Spawn new player");
+    CORE_LOG_DEBUG("[Server] Spawn new player");
     auto spawnPlayer = std::make_unique<SpawnPlayerPacket>();
     spawnPlayer->packetType = PacketType::SPAWN_PLAYER;
     spawnPlayer->clientId = core::ConvertToBinary(clientId);
@@ -136,8 +216,9 @@ void SimulationServer::SpawnNewBall()
 {
     //pick random direction for the ball before notifying clients
     const auto pos = core::Vec2f::zero();
-    const auto randXDir = core::RandomRange(-1, 1);
-    const auto randYDir = core::RandomRange(-1, 1);
+    std::uniform_int_distribution<int> directionDistribution(-1, 1);
+    const auto randXDir = directionDistribution(generator_);
+    const auto randYDir = directionDistribution(generator_);
     const auto velX = randXDir <= 0 ? -ballInitialSpeed : ballInitialSpeed;
     const auto velY = randYDir <= 0 ? -ballInitialSpeed : ballInitialSpeed;
     const auto velocity = core::Vec2f(velX, velY);
@@ -146,7 +227,7 @@ void SimulationServer::SpawnNewBall()
     spawnBallPacket->packetType = PacketType::SPAWN_BALL;
     spawnBallPacket->velocity = core::ConvertToBinary(velocity);
     spawnBallPacket->pos = core::ConvertToBinary(pos);
-    core::LogDebug("[Server] Spawn new ball");
+    CORE_LOG_DEBUG("[Server] Spawn new ball");
     gameManager_.SpawnBall(pos, velocity);
     SendReliablePacket(std::move(spawnBallPacket));
 }
@@ -157,7 +238,7 @@ void SimulationServer::SpawnNewBoundary(core::Vec2f pos)
     spawnBoundaryPacket->packetType = PacketType::SPAWN_BOUNDARY;
     spawnBoundaryPacket->pos = core::ConvertToBinary(pos);
 
-    core::LogDebug("[Server] Spawn game boundary");
+    CORE_LOG_DEBUG("[Server] Spawn game boundary");
     gameManager_.SpawnBoundary(pos);
     SendReliablePacket(std::move(spawnBoundaryPacket));
 }
@@ -170,7 +251,7 @@ void SimulationServer::SpawnNewHome(PlayerNumber playerNumberToSpawnHomeFor)
     spawnHomePacket->packetType = PacketType::SPAWN_HOME;
     spawnHomePacket->pos = core::ConvertToBinary(pos);
     spawnHomePacket->playerNumber = playerNumberToSpawnHomeFor;
-    core::LogDebug("[Server] Spawn a player's home");
+    CORE_LOG_DEBUG("[Server] Spawn a player's home");
     SendReliablePacket(std::move(spawnHomePacket));
 }
 void SimulationServer::SpawnNewHealthbar(PlayerNumber playerNumber)
@@ -181,7 +262,7 @@ void SimulationServer::SpawnNewHealthbar(PlayerNumber playerNumber)
     spawnHealthbarPacket->packetType = PacketType::SPAWN_HEALTHBAR;
     spawnHealthbarPacket->pos = core::ConvertToBinary(pos);
     spawnHealthbarPacket->playerNumber = playerNumber;
-    core::LogDebug("[Server] Spawn a player healthbar");
+    CORE_LOG_DEBUG("[Server] Spawn a player healthbar");
     SendReliablePacket(std::move(spawnHealthbarPacket));
 }
 